@@ -10,16 +10,55 @@
 #include "mesh/CartesianMesh2D.h"
 #include <stdexcept>
 #include <sstream>
+#include <algorithm>
+#include <cstdint>
 
 namespace nablalib
 {
 
+namespace
+{
+  // Entrelacement des bits de (x, y) : clef de la courbe de Morton (Z-order)
+  uint64_t mortonKey(uint32_t x, uint32_t y) noexcept
+  {
+    auto spread = [](uint64_t v) {
+      v = (v | (v << 16)) & 0x0000FFFF0000FFFFull;
+      v = (v | (v << 8))  & 0x00FF00FF00FF00FFull;
+      v = (v | (v << 4))  & 0x0F0F0F0F0F0F0F0Full;
+      v = (v | (v << 2))  & 0x3333333333333333ull;
+      v = (v | (v << 1))  & 0x5555555555555555ull;
+      return v;
+    };
+    return spread(x) | (spread(y) << 1);
+  }
+
+  // Distance le long de la courbe de Hilbert d'un carre n x n (n puissance de 2)
+  uint64_t hilbertKey(uint64_t n, uint64_t x, uint64_t y) noexcept
+  {
+    uint64_t d(0);
+    for (uint64_t s(n / 2); s > 0; s /= 2) {
+      const uint64_t rx((x & s) > 0);
+      const uint64_t ry((y & s) > 0);
+      d += s * s * ((3 * rx) ^ ry);
+      if (ry == 0) {
+        if (rx == 1) {
+          x = s - 1 - x;
+          y = s - 1 - y;
+        }
+        std::swap(x, y);
+      }
+    }
+    return d;
+  }
+}
+
 CartesianMesh2D::CartesianMesh2D(
   MeshGeometry<2>* geometry, const vector<Id>& inner_nodes_ids,
   const vector<Id>& top_nodes_ids, const vector<Id>& bottom_nodes_ids,
   const vector<Id>& left_nodes_ids, const vector<Id>& right_nodes_ids,
   const Id top_left_node_id, const Id top_right_node_id,
-  const Id bottom_left_node_id, const Id bottom_right_node_id)
+  const Id bottom_left_node_id, const Id bottom_right_node_id,
+  const int ordering)
 : m_geometry(geometry)
 , m_inner_nodes(inner_nodes_ids)
 , m_top_nodes(top_nodes_ids)
@@ -36,38 +75,144 @@ CartesianMesh2D::CartesianMesh2D(
 , m_right_faces(0)
 , m_nb_x_quads(bottom_nodes_ids.size() - 1)
 , m_nb_y_quads(left_nodes_ids.size() - 1)
-{
-  // outer faces
-	auto edges = m_geometry->getEdges();
-	for (size_t edgeId(0); edgeId < edges.size(); ++edgeId) {
-    m_faces.emplace_back(edgeId);
-		if (!isInnerEdge(edges[edgeId])) {
-			m_outer_faces.emplace_back(edgeId);
-		} else {
-      m_inner_faces.emplace_back(edgeId);
-			if (isInnerVerticalEdge(edges[edgeId])) {
-				m_inner_vertical_faces.emplace_back(edgeId);
-			}	else if (isInnerHorizontalEdge(edges[edgeId])) {
-				m_inner_horizontal_faces.emplace_back(edgeId);
-			}	else {
-        stringstream msg;
-        msg << "The inner edge " << edgeId << " should be either vertical or horizontal" << endl;
-        throw runtime_error(msg.str());
-			}
+, m_ordering(ordering)
+, m_nb_ghost_layers(0)
+{
+	if (m_ordering != Lexicographic) {
+		// numerotation deja appliquee par le generateur : seules les tables de
+		// passage (i,j) <-> identifiant sont construites ici
+		const vector<Id> nodeIds(computeNodeNumbering(m_nb_x_quads, m_nb_y_quads, m_ordering));
+		m_node_ids = Kokkos::View<Id*>("node_ids", nodeIds.size());
+		m_node_index = Kokkos::View<Id*>("node_index", nodeIds.size());
+		auto nodeIdsH(Kokkos::create_mirror_view(m_node_ids));
+		auto nodeIndexH(Kokkos::create_mirror_view(m_node_index));
+		for (size_t k(0); k < nodeIds.size(); ++k) {
+			nodeIdsH(k) = nodeIds[k];
+			nodeIndexH(nodeIds[k]) = k;
+		}
+		Kokkos::deep_copy(m_node_ids, nodeIdsH);
+		Kokkos::deep_copy(m_node_index, nodeIndexH);
+	}
+	computeConnectivity();
+
+	// Classification analytique des faces a partir de leur ligne i_f et de
+	// leur rang k_f dans la ligne (cf. CartesianMesh2DGenerator) : chaque liste
+	// a une taille connue, elle est allouee une fois et remplie en parallele
+	const size_t nbX(m_nb_x_quads);
+	const size_t nbY(m_nb_y_quads);
+	const size_t nbFaces(getNbFaces());
+	const size_t nbFacesPerRow(2 * nbX + 1);
+	using HostPolicy = Kokkos::RangePolicy<Kokkos::DefaultHostExecutionSpace>;
+	auto isOuterFace = [=](const size_t faceId) {
+		const size_t i_f(faceId / nbFacesPerRow);
+		const size_t k_f(faceId - i_f * nbFacesPerRow);
+		return (i_f == nbY || k_f == 1 || k_f == 2 * nbX || (i_f == 0 && k_f % 2 == 0));
+	};
+
+	m_faces.resize(nbFaces);
+	m_outer_faces.resize(2 * (nbX + nbY));
+	m_inner_faces.resize(nbFaces - m_outer_faces.size());
+	m_inner_vertical_faces.resize(nbY * (nbX - 1));
+	m_inner_horizontal_faces.resize((nbY - 1) * nbX);
+	auto faces(m_faces.data());
+	auto outerFaces(m_outer_faces.data());
+	auto innerFaces(m_inner_faces.data());
+	auto innerVerticalFaces(m_inner_vertical_faces.data());
+	auto innerHorizontalFaces(m_inner_horizontal_faces.data());
+
+	Kokkos::parallel_for("faces", HostPolicy(0, nbFaces), KOKKOS_LAMBDA(const size_t& faceId) {
+		faces[faceId] = faceId;
+	});
+	Kokkos::parallel_scan("outerFaces", HostPolicy(0, nbFaces),
+		KOKKOS_LAMBDA(const size_t& faceId, size_t& k, const bool final) {
+		if (isOuterFace(faceId)) {
+			if (final) outerFaces[k] = faceId;
+			++k;
 		}
+	});
+	Kokkos::parallel_scan("innerFaces", HostPolicy(0, nbFaces),
+		KOKKOS_LAMBDA(const size_t& faceId, size_t& k, const bool final) {
+		if (!isOuterFace(faceId)) {
+			if (final) innerFaces[k] = faceId;
+			++k;
+		}
+	});
+	// faces verticales internes : (i_f, 2j+1) pour j = 1..nbX-1
+	Kokkos::parallel_for("innerVerticalFaces", HostPolicy(0, m_inner_vertical_faces.size()),
+		KOKKOS_LAMBDA(const size_t& k) {
+		const size_t i(k / (nbX - 1));
+		const size_t j(k - i * (nbX - 1) + 1);
+		innerVerticalFaces[k] = i * nbFacesPerRow + 2 * j + 1;
+	});
+	// faces horizontales internes : (i_f, 2j) pour i_f = 1..nbY-1
+	Kokkos::parallel_for("innerHorizontalFaces", HostPolicy(0, m_inner_horizontal_faces.size()),
+		KOKKOS_LAMBDA(const size_t& k) {
+		const size_t i(k / nbX + 1);
+		const size_t j(k - (i - 1) * nbX);
+		innerHorizontalFaces[k] = i * nbFacesPerRow + 2 * j;
+	});
+
+	// Construction of boundary cell sets and of their faces
+	m_top_cells.resize(nbX);
+	m_bottom_cells.resize(nbX);
+	m_left_cells.resize(nbY);
+	m_right_cells.resize(nbY);
+	m_top_faces.resize(nbX);
+	m_bottom_faces.resize(nbX);
+	m_left_faces.resize(nbY);
+	m_right_faces.resize(nbY);
+	for (size_t j(0); j < nbX; ++j) {
+		m_bottom_cells[j] = index2IdCell(0, j);
+		m_top_cells[j] = index2IdCell(nbY - 1, j);
+		m_bottom_faces[j] = getBottomFaceOfCell(m_bottom_cells[j]);
+		m_top_faces[j] = getTopFaceOfCell(m_top_cells[j]);
+	}
+	for (size_t i(0); i < nbY; ++i) {
+		m_left_cells[i] = index2IdCell(i, 0);
+		m_right_cells[i] = index2IdCell(i, nbX - 1);
+		m_left_faces[i] = getLeftFaceOfCell(m_left_cells[i]);
+		m_right_faces[i] = getRightFaceOfCell(m_right_cells[i]);
+	}
+}
+
+vector<Id>
+CartesianMesh2D::computeNodeNumbering(const size_t nbXQuads, const size_t nbYQuads, const int ordering)
+{
+	const size_t nbXNodes(nbXQuads + 1);
+	const size_t nbNodes(nbXNodes * (nbYQuads + 1));
+	vector<Id> nodeIds(nbNodes);
+	for (size_t k(0); k < nbNodes; ++k) nodeIds[k] = k;
+	if (ordering == Lexicographic) return nodeIds;
+	if (ordering != Morton && ordering != Hilbert) {
+		stringstream msg;
+		msg << "Unknown node ordering " << ordering << endl;
+		throw runtime_error(msg.str());
+	}
+
+	uint64_t n(1);
+	while (n < std::max(nbXNodes, nbYQuads + 1)) n *= 2;
+	vector<uint64_t> keys(nbNodes);
+	vector<Id> order(nodeIds);
+	for (size_t k(0); k < nbNodes; ++k) {
+		const size_t i(k / nbXNodes);
+		const size_t j(k - i * nbXNodes);
+		keys[k] = (ordering == Morton ? mortonKey(j, i) : hilbertKey(n, j, i));
 	}
+	// order[r] : indice lexicographique du r-ieme noeud de la courbe
+	std::sort(order.begin(), order.end(), [&](const Id a, const Id b) { return keys[a] < keys[b]; });
+	for (size_t r(0); r < nbNodes; ++r) nodeIds[order[r]] = r;
+	return nodeIds;
+}
 
-	// Construction of boundary cell sets
-	m_top_cells = cellsOfNodeCollection(m_top_nodes);
-	m_bottom_cells = cellsOfNodeCollection(m_bottom_nodes);
-	m_left_cells = cellsOfNodeCollection(m_left_nodes);
-	m_right_cells = cellsOfNodeCollection(m_right_nodes);
-
-	// Construction of boundary cell faces
-	for(auto&& cellId: m_top_cells)    m_top_faces.emplace_back(getTopFaceOfCell(cellId));
-	for(auto&& cellId: m_bottom_cells) m_bottom_faces.emplace_back(getBottomFaceOfCell(cellId));
-	for(auto&& cellId: m_left_cells)   m_left_faces.emplace_back(getLeftFaceOfCell(cellId));
-	for(auto&& cellId: m_right_cells)  m_right_faces.emplace_back(getRightFaceOfCell(cellId));
+void
+CartesianMesh2D::setNbGhostLayers(const int nbGhostLayers)
+{
+	if (nbGhostLayers < 0 || nbGhostLayers > 2) {
+		stringstream msg;
+		msg << "Unsupported number of ghost layers " << nbGhostLayers << endl;
+		throw runtime_error(msg.str());
+	}
+	m_nb_ghost_layers = nbGhostLayers;
 }
 
 const array<Id, 4>&
@@ -94,94 +239,106 @@ CartesianMesh2D::getSecondNodeOfFace(const Id& faceId) const noexcept
 	return m_geometry->getEdges()[faceId].getNodeIds()[1];
 }
 
-vector<Id>
-CartesianMesh2D::getCellsOfNode(const Id& nodeId) const noexcept
-{
-	vector<Id> cells;
-	size_t i,j;
-  tie(i, j) = id2IndexNode(nodeId);
-	if (i < m_nb_y_quads && j < m_nb_x_quads) cells.emplace_back(index2IdCell(i, j));
-	if (i < m_nb_y_quads && j > 0)            cells.emplace_back(index2IdCell(i, j-1));
-	if (i > 0            && j < m_nb_x_quads) cells.emplace_back(index2IdCell(i-1, j));
-	if (i > 0            && j > 0)            cells.emplace_back(index2IdCell(i-1, j-1));
-  return cells;
-}
+void
+CartesianMesh2D::computeConnectivity() noexcept
+{
+	const size_t nbNodes(getNbNodes());
+	const size_t nbCells(getNbCells());
+	const size_t nbFaces(getNbFaces());
+	const size_t nbX(m_nb_x_quads);
+	const size_t nbY(m_nb_y_quads);
 
-vector<Id>
-CartesianMesh2D::getCellsOfFace(const Id& faceId) const
-{
-	vector<Id> cells;	
-	size_t i_f = static_cast<size_t>(faceId) / (2 * m_nb_x_quads + 1);
-	size_t k_f = static_cast<size_t>(faceId) - i_f * (2 * m_nb_x_quads + 1);
-	
-	if (i_f < m_nb_y_quads) {  // all except upper bound faces
-	  if (k_f == 2 * m_nb_x_quads) {  // right bound edge 
-	    cells.emplace_back(index2IdCell(i_f, m_nb_x_quads-1));
-	  }
-    else if (k_f == 1) {  // left bound edge
-	    cells.emplace_back(index2IdCell(i_f, 0));
-	  }
-	  else if (k_f % 2 == 0) {  // horizontal edge
-	    cells.emplace_back(index2IdCell(i_f, k_f/2));
-	    if (i_f > 0)  // Not bottom bound edge
-	      cells.emplace_back(index2IdCell(i_f-1, k_f/2));
-	  }
-    else {  // vertical edge (neither left bound nor right bound)
-	    cells.emplace_back(index2IdCell(i_f, (k_f-1)/2 - 1));
-	    cells.emplace_back(index2IdCell(i_f, (k_f-1)/2));
-	  }
-	} else {  // upper bound faces
-	  cells.emplace_back(index2IdCell(i_f-1, k_f));
-	}
-  return cells;
-  /*
-   * Old code just in case there are still flaws in new code...
-   * 
-  std::vector<Id> cellsOfFace;
-	const auto& nodes(getNodesOfFace(faceId));
-	for (auto nodeId : nodes)
-	{
-		auto adjacentCells(getCellsOfNode(nodeId));
-		for(auto quadId : adjacentCells)
-			if (getNbCommonIds(nodes, m_geometry->getQuads()[quadId].getNodeIds()) == 2)
-				cellsOfFace.emplace_back(quadId);
-	}
-	std::sort(cellsOfFace.begin(), cellsOfFace.end());
-	cellsOfFace.erase(std::unique(cellsOfFace.begin(), cellsOfFace.end()), cellsOfFace.end());
-	return cellsOfFace;
-  */
-}
+	m_cells_of_node = Kokkos::View<Id*[MaxNbCellsOfNode]>("cells_of_node", nbNodes);
+	m_nb_cells_of_node = Kokkos::View<int*>("nb_cells_of_node", nbNodes);
+	m_node_slot_in_cell = Kokkos::View<int*[MaxNbCellsOfNode]>("node_slot_in_cell", nbNodes);
+	m_cells_of_face = Kokkos::View<Id*[MaxNbCellsOfFace]>("cells_of_face", nbFaces);
+	m_nb_cells_of_face = Kokkos::View<int*>("nb_cells_of_face", nbFaces);
+	m_faces_of_cell = Kokkos::View<Id*[MaxNbFacesOfCell]>("faces_of_cell", nbCells);
+	m_neighbour_cells = Kokkos::View<Id*[MaxNbFacesOfCell]>("neighbour_cells", nbCells);
+	m_nb_neighbour_cells = Kokkos::View<int*>("nb_neighbour_cells", nbCells);
 
-vector<Id>
-CartesianMesh2D::getNeighbourCells(const Id& cellId) const
-{
-  std::vector<Id> neighbours;
-	size_t i,j;
-	tie(i, j) = id2IndexCell(cellId);
-	if (i >= 1) neighbours.emplace_back(index2IdCell(i-1, j));
-	if (i < m_nb_y_quads-1) neighbours.emplace_back(index2IdCell(i+1, j));
-	if (j >= 1) neighbours.emplace_back(index2IdCell(i, j-1));
-	if (j < m_nb_x_quads-1) neighbours.emplace_back(index2IdCell(i, j+1));
-  return neighbours;
-}
+	auto cellsOfNode(m_cells_of_node);
+	auto nbCellsOfNode(m_nb_cells_of_node);
+	auto nodeSlotInCell(m_node_slot_in_cell);
+	auto cellsOfFace(m_cells_of_face);
+	auto nbCellsOfFace(m_nb_cells_of_face);
+	auto facesOfCell(m_faces_of_cell);
+	auto neighbourCells(m_neighbour_cells);
+	auto nbNeighbourCells(m_nb_neighbour_cells);
 
-vector<Id>
-CartesianMesh2D::getFacesOfCell(const Id& cellId) const
-{
-	size_t i,j;
-	tie(i, j) = id2IndexCell(cellId);
-  Id bottom_face(static_cast<Id>(2 * j + i * (2 * m_nb_x_quads + 1)));
-	Id left_face(bottom_face + 1);
-	Id right_face(bottom_face + static_cast<Id>(j == m_nb_x_quads-1 ? 2 : 3));
-	Id top_face(bottom_face + static_cast<Id>(i < m_nb_y_quads-1 ? 2 * m_nb_x_quads + 1 : 2 * m_nb_x_quads + 1 - j));
-	return vector<Id>({bottom_face, left_face, right_face, top_face});
+	// Mailles autour d'un noeud (i,j) : l'ordre fixe l'indice de coin utilise
+	// par les solveurs (maille en haut a droite en premier).
+	// Les quads sont (i,j) (i,j+1) (i+1,j+1) (i+1,j) : le noeud occupe la
+	// position 0, 1, 3 ou 2 dans chacune de ces mailles.
+	auto nodeIndex(m_node_index);
+	Kokkos::parallel_for("cellsOfNode", nbNodes, KOKKOS_LAMBDA(const size_t& nodeId) {
+		const size_t k(nodeIndex.extent(0) ? nodeIndex(nodeId) : nodeId);
+		const size_t i(k / (nbX + 1));
+		const size_t j(k - i * (nbX + 1));
+		int n(0);
+		if (i < nbY && j < nbX) { nodeSlotInCell(nodeId, n) = 0; cellsOfNode(nodeId, n++) = i * nbX + j; }
+		if (i < nbY && j > 0)   { nodeSlotInCell(nodeId, n) = 1; cellsOfNode(nodeId, n++) = i * nbX + j - 1; }
+		if (i > 0   && j < nbX) { nodeSlotInCell(nodeId, n) = 3; cellsOfNode(nodeId, n++) = (i - 1) * nbX + j; }
+		if (i > 0   && j > 0)   { nodeSlotInCell(nodeId, n) = 2; cellsOfNode(nodeId, n++) = (i - 1) * nbX + j - 1; }
+		nbCellsOfNode(nodeId) = n;
+		for (int k(n); k < MaxNbCellsOfNode; ++k) {
+			cellsOfNode(nodeId, k) = NoId;
+			nodeSlotInCell(nodeId, k) = -1;
+		}
+	});
+
+	// Mailles de part et d'autre d'une face : arriere puis avant
+	Kokkos::parallel_for("cellsOfFace", nbFaces, KOKKOS_LAMBDA(const size_t& faceId) {
+		const size_t i_f(faceId / (2 * nbX + 1));
+		const size_t k_f(faceId - i_f * (2 * nbX + 1));
+		Id back(NoId), front(NoId);
+		if (i_f < nbY) {  // all except upper bound faces
+			if (k_f == 2 * nbX) {  // right bound edge
+				back = i_f * nbX + nbX - 1;
+			} else if (k_f == 1) {  // left bound edge
+				back = i_f * nbX;
+			} else if (k_f % 2 == 0) {  // horizontal edge
+				back = i_f * nbX + k_f / 2;
+				if (i_f > 0)  // Not bottom bound edge
+					front = (i_f - 1) * nbX + k_f / 2;
+			} else {  // vertical edge (neither left bound nor right bound)
+				back = i_f * nbX + (k_f - 1) / 2 - 1;
+				front = i_f * nbX + (k_f - 1) / 2;
+			}
+		} else {  // upper bound faces
+			back = (i_f - 1) * nbX + k_f;
+		}
+		cellsOfFace(faceId, 0) = back;
+		cellsOfFace(faceId, 1) = front;
+		nbCellsOfFace(faceId) = (front == NoId ? 1 : 2);
+	});
+
+	// Faces (bas, gauche, droite, haut) et voisines (bas, haut, gauche, droite)
+	Kokkos::parallel_for("facesOfCell", nbCells, KOKKOS_LAMBDA(const size_t& cellId) {
+		const size_t i(cellId / nbX);
+		const size_t j(cellId - i * nbX);
+		const Id bottom_face(2 * j + i * (2 * nbX + 1));
+		facesOfCell(cellId, 0) = bottom_face;
+		facesOfCell(cellId, 1) = bottom_face + 1;
+		facesOfCell(cellId, 2) = bottom_face + (j == nbX - 1 ? 2 : 3);
+		facesOfCell(cellId, 3) = bottom_face + (i < nbY - 1 ? 2 * nbX + 1 : 2 * nbX + 1 - j);
+
+		int n(0);
+		if (i >= 1)      neighbourCells(cellId, n++) = (i - 1) * nbX + j;
+		if (i < nbY - 1) neighbourCells(cellId, n++) = (i + 1) * nbX + j;
+		if (j >= 1)      neighbourCells(cellId, n++) = i * nbX + j - 1;
+		if (j < nbX - 1) neighbourCells(cellId, n++) = i * nbX + j + 1;
+		nbNeighbourCells(cellId) = n;
+		for (int k(n); k < MaxNbFacesOfCell; ++k) neighbourCells(cellId, k) = NoId;
+	});
+	Kokkos::fence();
 }
 
 Id
 CartesianMesh2D::getCommonFace(const Id& cellId1, const Id& cellId2) const
 {
-	auto cell1Faces{getFacesOfCell(cellId1)};
-	auto cell2Faces{getFacesOfCell(cellId2)};
+	auto cell1Faces(getFacesOfCell(cellId1));
+	auto cell2Faces(getFacesOfCell(cellId2));
 	auto result = find_first_of(cell1Faces.begin(), cell1Faces.end(), cell2Faces.begin(), cell2Faces.end());
 	if (result == cell1Faces.end()) {
     stringstream msg;
@@ -217,26 +374,6 @@ CartesianMesh2D::getCommonFace(const Id& cellId1, const Id& cellId2) const
 //     return cells[1];
 //   }
 // }
-Id
-CartesianMesh2D::getBackCell(const Id& faceId) const 
-{
-  vector<Id> cells = (move(getCellsOfFace(faceId)));
-  if (cells.size() >= 1)
-    return cells[0];
-  else
-    return -1;
-}
-
-Id
-CartesianMesh2D::getFrontCell(const Id& faceId) const 
-{
-  vector<Id> cells = (move(getCellsOfFace(faceId)));
-  if (cells.size() >= 2)
-    return cells[1];
-  else
-    return -1;
-}
-
 size_t
 CartesianMesh2D::getNbCommonIds(const vector<Id>& as, const vector<Id>& bs) const noexcept
 {
@@ -247,29 +384,6 @@ CartesianMesh2D::getNbCommonIds(const vector<Id>& as, const vector<Id>& bs) cons
 	return nbCommonIds;
 }
 
-bool
-CartesianMesh2D::isInnerEdge(const Edge& e) const noexcept
-{
-	return (find(m_inner_nodes.begin(), m_inner_nodes.end(), e.getNodeIds()[0]) != m_inner_nodes.end()) ||
-	       (find(m_inner_nodes.begin(), m_inner_nodes.end(), e.getNodeIds()[1]) != m_inner_nodes.end());
-}
-
-bool
-CartesianMesh2D::isInnerVerticalEdge(const Edge& e) const noexcept
-{
-	if (!isInnerEdge(e)) return false;
-	return (e.getNodeIds()[0] == e.getNodeIds()[1] + m_nb_x_quads + 1 ||
-			    e.getNodeIds()[1] == e.getNodeIds()[0] + m_nb_x_quads + 1);
-}
-
-bool
-CartesianMesh2D::isInnerHorizontalEdge(const Edge& e) const noexcept
-{
-	if (!isInnerEdge(e)) return false;
-	return (e.getNodeIds()[0] == e.getNodeIds()[1] + 1 ||
-			    e.getNodeIds()[1] == e.getNodeIds()[0] + 1);
-}
-
 Id
 CartesianMesh2D::getBottomFaceOfCell(const Id& cellId) const noexcept
 {
@@ -323,30 +437,19 @@ CartesianMesh2D::id2IndexCell(const Id& k) const noexcept
 inline Id
 CartesianMesh2D::index2IdNode(const size_t& i, const size_t&j) const noexcept
 {
-  return static_cast<Id>(i * (m_nb_x_quads + 1) + j);
+  return nodeAt(i, j);
 }
   
 inline pair<size_t, size_t>
-CartesianMesh2D::id2IndexNode(const Id& k) const noexcept
+CartesianMesh2D::id2IndexNode(const Id& nodeId) const noexcept
 {
-  size_t i(static_cast<size_t>(k) / (m_nb_x_quads + 1));
-  size_t j(static_cast<size_t>(k) - i * (m_nb_x_quads + 1));
+  const size_t k(m_node_index.extent(0) ? m_node_index(nodeId) : nodeId);
+  size_t i(k / (m_nb_x_quads + 1));
+  size_t j(k - i * (m_nb_x_quads + 1));
   return make_pair(i, j); 
 }
 
 
-inline vector<Id>
-CartesianMesh2D::cellsOfNodeCollection(const vector<Id>& nodes)
-{
-  vector<Id> cells(0);
-  for (auto&& node_id : nodes)
-    for (auto&& cell_id : getCellsOfNode(node_id))
-      cells.emplace_back(cell_id);
-  // Deleting duplicates
-  std::sort(cells.begin(), cells.end());
-  cells.erase(std::unique(cells.begin(), cells.end()), cells.end());
-  return cells;
-}
 Id CartesianMesh2D::getLeftNode(const int node) const noexcept
 {
    size_t i,j;
@@ -10,8 +10,11 @@
 #ifndef MESH_CARTESIANMESH2D_H_
 #define MESH_CARTESIANMESH2D_H_
 
+#include <string>
 #include <utility>
+#include <Kokkos_Core.hpp>
 #include "types/Types.h"
+#include "types/Span.h"
 #include "mesh/MeshGeometry.h"
 
 using namespace std;
@@ -28,12 +31,16 @@ public:
 	static constexpr int MaxNbCellsOfFace = 2;
 	static constexpr int MaxNbFacesOfCell = 4;
 	static constexpr int MaxNbNeighbourCells = 2;
+	// Valeur de bourrage des tables de connectivite (identique au -1 rendu
+	// par getBackCell/getFrontCell en l'absence de maille)
+	static constexpr Id NoId = static_cast<Id>(-1);
 
 	CartesianMesh2D(MeshGeometry<2>* geometry, const vector<Id>& inner_nodes_ids,
                   const vector<Id>& top_nodes_ids, const vector<Id>& bottom_nodes_ids,
                   const vector<Id>& left_nodes_ids, const vector<Id>& right_nodes_ids,
                   const Id top_left_node_id, const Id top_right_node_id,
-                  const Id bottom_left_node_id, const Id bottom_right_node_id);
+                  const Id bottom_left_node_id, const Id bottom_right_node_id,
+                  const int ordering = 0);
 
 	MeshGeometry<2>* getGeometry() noexcept { return m_geometry; }
 
@@ -42,6 +49,9 @@ public:
   
 	size_t getNbFaces() const noexcept { return m_geometry->getEdges().size(); }
 	const vector<Id>& getFaces() const noexcept { return m_faces; }
+	// Les faces sont numerotees de 0 a getNbFaces()-1 dans l'ordre des aretes :
+	// l'indice d'une face dans getFaces() est son identifiant
+	size_t getFaceIndex(const Id& faceId) const noexcept { return faceId; }
 	
 	size_t getNbInnerNodes() const noexcept { return m_inner_nodes.size(); }
 	const vector<Id>& getInnerNodes() const noexcept { return m_inner_nodes; }
@@ -114,18 +124,31 @@ public:
 		
 	const array<Id, 4>& getNodesOfCell(const Id& cellId) const noexcept;
 	const array<Id, 2>& getNodesOfFace(const Id& faceId) const noexcept;
-	vector<Id> getCellsOfNode(const Id& nodeId) const noexcept;
-	vector<Id> getCellsOfFace(const Id& faceId) const;
-	vector<Id> getNeighbourCells(const Id& cellId) const;
-	vector<Id> getFacesOfCell(const Id& cellId) const;
+	// Connectivites precalculees a la construction : pas d'allocation
+	Span<Id> getCellsOfNode(const Id& nodeId) const noexcept
+	{ return Span<Id>(&m_cells_of_node(nodeId, 0), m_nb_cells_of_node(nodeId)); }
+	Span<Id> getCellsOfFace(const Id& faceId) const noexcept
+	{ return Span<Id>(&m_cells_of_face(faceId, 0), m_nb_cells_of_face(faceId)); }
+	Span<Id> getNeighbourCells(const Id& cellId) const noexcept
+	{ return Span<Id>(&m_neighbour_cells(cellId, 0), m_nb_neighbour_cells(cellId)); }
+	Span<Id> getFacesOfCell(const Id& cellId) const noexcept
+	{ return Span<Id>(&m_faces_of_cell(cellId, 0), MaxNbFacesOfCell); }
+	// Position locale (0:bas, 1:gauche, 2:droite, 3:haut) d'une face dans
+	// getFacesOfCell(cellId), -1 si la face n'appartient pas a la maille
+	int getFaceSlotOfCell(const Id& cellId, const Id& faceId) const noexcept
+	{
+		for (int k(0); k < MaxNbFacesOfCell; ++k)
+			if (m_faces_of_cell(cellId, k) == faceId) return k;
+		return -1;
+	}
   
 	Id getCommonFace(const Id& cellId1, const Id& cellId2) const;
   
  	Id getFirstNodeOfFace(const Id& faceId) const noexcept;
 	Id getSecondNodeOfFace(const Id& faceId) const noexcept;
 
-	Id getBackCell(const Id& faceId) const;
-	Id getFrontCell(const Id& faceId) const;
+	Id getBackCell(const Id& faceId) const noexcept { return m_cells_of_face(faceId, 0); }
+	Id getFrontCell(const Id& faceId) const noexcept { return m_cells_of_face(faceId, 1); }
 	Id getBottomFaceOfCell(const Id& cellId) const noexcept;
 	Id getLeftFaceOfCell(const Id& cellId) const noexcept;
 	Id getRightFaceOfCell(const Id& cellId) const noexcept;
@@ -141,6 +164,117 @@ public:
 	Id getLeftCellfromRight(const int cell) const noexcept;
 	Id getRightCellfromLeft(const int cell) const noexcept;
 
+	// Acces structure (i,j) : la maille (i,j) est sur la ligne i (selon y) et
+	// la colonne j (selon x), d'identifiant i*nbX+j ; de meme pour les noeuds
+	// avec nbX+1 noeuds par ligne.
+	// Les directions suivent l'ordre des faces de getFacesOfCell.
+	enum Direction { Bottom = 0, Left = 1, Right = 2, Top = 3 };
+	// Tuiles (lignes, colonnes) des parcours MDRange : j est l'indice rapide
+	static constexpr int TileY = 4;
+	static constexpr int TileX = 64;
+
+	size_t getNbXQuads() const noexcept { return m_nb_x_quads; }
+	size_t getNbYQuads() const noexcept { return m_nb_y_quads; }
+
+	Id cellAt(const size_t i, const size_t j) const noexcept { return i * m_nb_x_quads + j; }
+	Id nodeAt(const size_t i, const size_t j) const noexcept
+	{
+		const Id k(i * (m_nb_x_quads + 1) + j);
+		return (m_node_ids.extent(0) ? m_node_ids(k) : k);
+	}
+	size_t getCellRow(const Id& cellId) const noexcept { return cellId / m_nb_x_quads; }
+	size_t getCellColumn(const Id& cellId) const noexcept { return cellId % m_nb_x_quads; }
+
+	// Decalage d'identifiant vers la maille voisine dans la direction d
+	long getCellOffset(const Direction d) const noexcept
+	{
+		const long nbX(static_cast<long>(m_nb_x_quads));
+		return (d == Bottom ? -nbX : (d == Left ? -1 : (d == Right ? 1 : nbX)));
+	}
+	// Vrai si la maille n'a pas de voisine dans la direction d
+	bool isBoundaryCell(const Id& cellId, const Direction d) const noexcept
+	{
+		switch (d) {
+			case Bottom: return getCellRow(cellId) == 0;
+			case Left:   return getCellColumn(cellId) == 0;
+			case Right:  return getCellColumn(cellId) == m_nb_x_quads - 1;
+			default:     return getCellRow(cellId) == m_nb_y_quads - 1;
+		}
+	}
+	// Maille voisine dans la direction d, NoId au bord du domaine
+	Id getNeighbourCell(const Id& cellId, const Direction d) const noexcept
+	{ return isBoundaryCell(cellId, d) ? NoId : static_cast<Id>(cellId + getCellOffset(d)); }
+
+	// Position du noeud dans getNodesOfCell de sa k-ieme maille (getCellsOfNode)
+	int getNodeSlotInCell(const Id& nodeId, const int k) const noexcept
+	{ return m_node_slot_in_cell(nodeId, k); }
+
+	// Numerotation des noeuds. En ordre lexicographique le noeud (i,j) a
+	// l'identifiant i*(nbX+1)+j ; en ordre de Morton ou de Hilbert les
+	// identifiants suivent la courbe, si bien que les tableaux aux noeuds sont
+	// ranges le long de celle-ci et que les noeuds d'une maille sont proches
+	// en memoire. Mailles et faces restent lexicographiques (l'acces (i,j)
+	// des mailles et la numerotation analytique des faces en dependent).
+	enum Ordering { Lexicographic = 0, Morton = 1, Hilbert = 2 };
+	// Identifiant du noeud d'indice lexicographique k, pour k < nbNoeuds
+	static vector<Id> computeNodeNumbering(const size_t nbXQuads, const size_t nbYQuads, const int ordering);
+	int getOrdering() const noexcept { return m_ordering; }
+
+	// Boucle parallele sur les noeuds : tuiles (i,j) en ordre lexicographique,
+	// sinon parcours des identifiants, c'est-a-dire de la courbe (chaque
+	// thread recoit un bloc compact de noeuds, contigu en memoire)
+	template <typename Functor>
+	void parallelForNodes(const std::string& label, const Functor& f) const
+	{
+		if (m_ordering == Lexicographic) {
+			const size_t nbXNodes(m_nb_x_quads + 1);
+			Kokkos::parallel_for(label, getNodeRangePolicy(),
+				KOKKOS_LAMBDA(const int& i, const int& j) { f(i * nbXNodes + j); });
+		} else {
+			Kokkos::parallel_for(label, getNbNodes(),
+				KOKKOS_LAMBDA(const size_t& pNodes) { f(pNodes); });
+		}
+	}
+
+	// Couronne de mailles fantomes (0 par defaut) : g mailles de part et
+	// d'autre de chaque ligne et de chaque colonne du domaine, coins exclus.
+	// La maille (i,j) avec j dans [-g, 0[ ou [nbX, nbX+g[ est rangee a la
+	// ligne i, (i,j) avec i dans [-g, 0[ ou [nbY, nbY+g[ apres les nbY lignes,
+	// a la colonne j ; 2g mailles par ligne ou colonne. Les mailles du domaine
+	// ne sont pas recopiees : les stencils les lisent dans leurs tableaux.
+	void setNbGhostLayers(const int nbGhostLayers);
+	int getNbGhostLayers() const noexcept { return m_nb_ghost_layers; }
+	size_t getNbGhostCells() const noexcept
+	{ return 2 * m_nb_ghost_layers * (m_nb_x_quads + m_nb_y_quads); }
+	Id ghostCellAt(const int i, const int j) const noexcept
+	{
+		const int g(m_nb_ghost_layers);
+		const int nbX(m_nb_x_quads), nbY(m_nb_y_quads);
+		if (j < 0 || j >= nbX)
+			return static_cast<Id>(i) * 2 * g + (j < 0 ? j + g : j - nbX + g);
+		return static_cast<Id>(nbY + j) * 2 * g + (i < 0 ? i + g : i - nbY + g);
+	}
+	// Maille du domaine la plus proche de la maille fantome (i,j) : une maille
+	// fantome recopie la maille de bord qui lui fait face
+	Id clampedCellAt(const int i, const int j) const noexcept
+	{
+		const int ic(i < 0 ? 0 : (i >= static_cast<int>(m_nb_y_quads) ? m_nb_y_quads - 1 : i));
+		const int jc(j < 0 ? 0 : (j >= static_cast<int>(m_nb_x_quads) ? m_nb_x_quads - 1 : j));
+		return cellAt(ic, jc);
+	}
+
+	// Parcours (i,j) par tuiles des mailles et des noeuds
+	Kokkos::MDRangePolicy<Kokkos::Rank<2>> getCellRangePolicy() const noexcept
+	{
+		return Kokkos::MDRangePolicy<Kokkos::Rank<2>>({0, 0},
+			{static_cast<int64_t>(m_nb_y_quads), static_cast<int64_t>(m_nb_x_quads)}, {TileY, TileX});
+	}
+	Kokkos::MDRangePolicy<Kokkos::Rank<2>> getNodeRangePolicy() const noexcept
+	{
+		return Kokkos::MDRangePolicy<Kokkos::Rank<2>>({0, 0},
+			{static_cast<int64_t>(m_nb_y_quads + 1), static_cast<int64_t>(m_nb_x_quads + 1)}, {TileY, TileX});
+	}
+
   
 private:
 	inline Id index2IdCell(const size_t& i, const size_t& j) const noexcept;
@@ -148,10 +282,6 @@ private:
 	inline pair<size_t, size_t> id2IndexCell(const Id& k) const noexcept;
 	inline pair<size_t, size_t> id2IndexNode(const Id& k) const noexcept;
   
-	bool isInnerEdge(const Edge& e) const noexcept;
-	bool isInnerVerticalEdge(const Edge& e) const noexcept;
-	bool isInnerHorizontalEdge(const Edge& e) const noexcept;
-  
 	size_t getNbCommonIds(const vector<Id>& a, const vector<Id>& b) const noexcept;
 	template <size_t N, size_t M>
 	size_t	getNbCommonIds(const array<Id, N>& as, const array<Id, M>& bs) const noexcept
@@ -163,7 +293,7 @@ private:
 		return nbCommonIds;
 	}
 
-	inline vector<Id> cellsOfNodeCollection(const vector<Id>& nodes);
+	void computeConnectivity() noexcept;
 	
 private:
 	MeshGeometry<2>* m_geometry;
@@ -195,6 +325,24 @@ private:
 
 	size_t m_nb_x_quads;
 	size_t m_nb_y_quads;
+
+	// Tables de connectivite a pas fixe, completees par NoId
+	Kokkos::View<Id*[MaxNbCellsOfNode]> m_cells_of_node;
+	Kokkos::View<int*> m_nb_cells_of_node;
+	Kokkos::View<int*[MaxNbCellsOfNode]> m_node_slot_in_cell;
+	Kokkos::View<Id*[MaxNbCellsOfFace]> m_cells_of_face;
+	Kokkos::View<int*> m_nb_cells_of_face;
+	Kokkos::View<Id*[MaxNbFacesOfCell]> m_faces_of_cell;
+	Kokkos::View<Id*[MaxNbFacesOfCell]> m_neighbour_cells;
+	Kokkos::View<int*> m_nb_neighbour_cells;
+
+	// Hors ordre lexicographique : indice lexicographique -> identifiant du
+	// noeud et reciproquement (vides sinon)
+	int m_ordering;
+	Kokkos::View<Id*> m_node_ids;
+	Kokkos::View<Id*> m_node_index;
+
+	int m_nb_ghost_layers;
 };
 
 }
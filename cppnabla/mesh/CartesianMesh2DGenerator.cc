@@ -11,6 +11,7 @@
 #include <cmath>
 #include "mesh/CartesianMesh2DGenerator.h"
 #include "mesh/CartesianMesh2D.h"
+#include <Kokkos_Core.hpp>
 
 using namespace std;
 
@@ -29,87 +30,102 @@ namespace nablalib
    */
 
 CartesianMesh2D*
-CartesianMesh2DGenerator::generate(size_t nbXQuads, size_t nbYQuads, double xSize, double ySize, int cylindrical_mesh, double minimum_radius)
+CartesianMesh2DGenerator::generate(size_t nbXQuads, size_t nbYQuads, double xSize, double ySize, int cylindrical_mesh, double minimum_radius, int ordering)
 {
-	vector<RealArray1D<2>> nodes_((nbXQuads + 1) * (nbYQuads + 1));
+	// Toutes les tailles sont connues a priori : chaque tableau est alloue une
+	// seule fois puis rempli en parallele a partir des indices (i,j)
+	const size_t nb_x_nodes_(nbXQuads + 1);
+	const size_t nb_y_nodes_(nbYQuads + 1);
+	const size_t nb_edges_per_row_(2 * nbXQuads + 1);
+	// identifiant du noeud (j,i) d'indice lexicographique j*(nbX+1)+i : lui-meme
+	// en ordre lexicographique, son rang le long de la courbe sinon
+	const vector<Id> node_ids_(CartesianMesh2D::computeNodeNumbering(nbXQuads, nbYQuads, ordering));
+
+	vector<RealArray1D<2>> nodes_(nb_x_nodes_ * nb_y_nodes_);
 	vector<Quad> quads_(nbXQuads * nbYQuads);
 	vector<Edge> edges_(2 * quads_.size() + nbXQuads + nbYQuads);
 
-	vector<Id> outer_node_ids_(2 * (nbXQuads + nbYQuads));
-	vector<Id> inner_node_ids_(nodes_.size() - outer_node_ids_.size());
-	vector<Id> top_node_ids_(nbXQuads + 1);
-	vector<Id> bottom_node_ids_(nbXQuads + 1);
-	vector<Id> left_node_ids_(nbYQuads + 1);
-	vector<Id> right_node_ids_(nbYQuads + 1);
+	vector<Id> inner_node_ids_((nbXQuads - 1) * (nbYQuads - 1));
+	vector<Id> top_node_ids_(nb_x_nodes_);
+	vector<Id> bottom_node_ids_(nb_x_nodes_);
+	vector<Id> left_node_ids_(nb_y_nodes_);
+	vector<Id> right_node_ids_(nb_y_nodes_);
 
-	// node creation
-	Id node_id_(0);
-	Id inner_node_id_(0);
-	Id top_node_id_(0);
-	Id bottom_node_id_(0);
-	Id left_node_id_(0);
-	Id right_node_id_(0);
-	Id top_left_node_id_(0);
-	Id top_right_node_id_(0);
-	Id bottom_left_node_id_(0);
-	Id bottom_right_node_id_(0);
-  
-	for(size_t j(0); j <= nbYQuads; ++j) {
-		for(size_t i(0); i <= nbXQuads; ++i) {
-		  nodes_[node_id_] = RealArray1D<2>{xSize * i, ySize * j};
-		  if (cylindrical_mesh) {		    
-		    double pi = 3.14159265359;
-		    double r =  xSize * i + minimum_radius;
-		    double theta = ySize * j * pi / 2.;
-		    nodes_[node_id_][0] = r * std::cos(theta);
-		    nodes_[node_id_][1] = r * std::sin(theta);
-		  }
-			if (i!=0 && j!=0 && i!=nbXQuads && j!=nbYQuads)
-				inner_node_ids_[inner_node_id_++] = node_id_;
-			else
-			{
-				if (j==0) bottom_node_ids_[bottom_node_id_++] = node_id_;
-				if (j==nbYQuads) top_node_ids_[top_node_id_++] = node_id_;
-				if (i==0) left_node_ids_[left_node_id_++] = node_id_;
-				if (i==nbXQuads) right_node_ids_[right_node_id_++] = node_id_;
-				if (i==0 && j==0) bottom_left_node_id_ = node_id_;
-				if (i==nbXQuads && j==0) bottom_right_node_id_ = node_id_;
-				if (i==0 && j==nbYQuads) top_left_node_id_ = node_id_;
-				if (i==nbXQuads && j==nbYQuads) top_right_node_id_ = node_id_;
-			}
-			++node_id_;
+	const Id bottom_left_node_id_(node_ids_[0]);
+	const Id bottom_right_node_id_(node_ids_[nbXQuads]);
+	const Id top_left_node_id_(node_ids_[nbYQuads * nb_x_nodes_]);
+	const Id top_right_node_id_(node_ids_[nbYQuads * nb_x_nodes_ + nbXQuads]);
+
+	// pointeurs bruts : les lambdas ne doivent pas copier les vecteurs
+	auto node_ids(node_ids_.data());
+	auto nodes(nodes_.data());
+	auto quads(quads_.data());
+	auto edges(edges_.data());
+	auto inner_node_ids(inner_node_ids_.data());
+	auto top_node_ids(top_node_ids_.data());
+	auto bottom_node_ids(bottom_node_ids_.data());
+	auto left_node_ids(left_node_ids_.data());
+	auto right_node_ids(right_node_ids_.data());
+	using HostPolicy = Kokkos::RangePolicy<Kokkos::DefaultHostExecutionSpace>;
+
+	// node creation : noeud (j,i) d'indice lexicographique j*(nbX+1)+i
+	Kokkos::parallel_for("generateNodes", HostPolicy(0, nodes_.size()), KOKKOS_LAMBDA(const size_t& node_index_) {
+		const size_t j(node_index_ / nb_x_nodes_);
+		const size_t i(node_index_ - j * nb_x_nodes_);
+		const Id node_id_(node_ids[node_index_]);
+		nodes[node_id_] = RealArray1D<2>{xSize * i, ySize * j};
+		if (cylindrical_mesh) {
+			double pi = 3.14159265359;
+			double r =  xSize * i + minimum_radius;
+			double theta = ySize * j * pi / 2.;
+			nodes[node_id_][0] = r * std::cos(theta);
+			nodes[node_id_][1] = r * std::sin(theta);
 		}
-	}
+		if (i!=0 && j!=0 && i!=nbXQuads && j!=nbYQuads)
+			inner_node_ids[(j - 1) * (nbXQuads - 1) + i - 1] = node_id_;
+		if (j==0) bottom_node_ids[i] = node_id_;
+		if (j==nbYQuads) top_node_ids[i] = node_id_;
+		if (i==0) left_node_ids[j] = node_id_;
+		if (i==nbXQuads) right_node_ids[j] = node_id_;
+	});
 
-	// edge creation
-	const size_t nb_x_nodes_(nbXQuads + 1);
-	Id edge_id_(0);
-	for(size_t i(0); i < nodes_.size(); ++i)	{
-		const size_t right_node_index_(i + 1);
-		if (right_node_index_ % nb_x_nodes_ != 0)
-		  edges_[edge_id_++] = move(Edge(static_cast<Id>(i), right_node_index_));
-		const size_t above_node_index_(i + nb_x_nodes_);
-		if (above_node_index_ < nodes_.size())
-		  edges_[edge_id_++] = Edge(static_cast<Id>(i), above_node_index_);
-	}
+	// edge creation : pour chaque noeud, l'arete vers la droite puis l'arete
+	// vers le haut, soit 2*nbX+1 aretes par ligne (nbX sur la derniere)
+	Kokkos::parallel_for("generateEdges", HostPolicy(0, nodes_.size()), KOKKOS_LAMBDA(const size_t& node_index_) {
+		const size_t j(node_index_ / nb_x_nodes_);
+		const size_t i(node_index_ - j * nb_x_nodes_);
+		const Id node_id_(node_ids[node_index_]);
+		if (j < nbYQuads) {
+			const size_t first_edge_(j * nb_edges_per_row_ + 2 * i);
+			if (i < nbXQuads) {
+				edges[first_edge_] = Edge(node_id_, node_ids[node_index_ + 1]);
+				edges[first_edge_ + 1] = Edge(node_id_, node_ids[node_index_ + nb_x_nodes_]);
+			} else {
+				edges[first_edge_] = Edge(node_id_, node_ids[node_index_ + nb_x_nodes_]);
+			}
+		} else if (i < nbXQuads) {
+			edges[j * nb_edges_per_row_ + i] = Edge(node_id_, node_ids[node_index_ + 1]);
+		}
+	});
 
 	// quad creation
-	Id quad_id_(0);
-	for(size_t j(0); j < nbYQuads; ++j) {
-		for(size_t i(0); i < nbXQuads; ++i) {
-			const size_t upper_left_node_index_((j * static_cast<size_t>(nb_x_nodes_)) + i);
-			const size_t lower_left_node_index_(upper_left_node_index_ + static_cast<size_t>(nb_x_nodes_));
-			quads_[quad_id_++] = move(Quad(upper_left_node_index_, upper_left_node_index_ + 1,
-                                     lower_left_node_index_ + 1, lower_left_node_index_));
-		}
-	}
+	Kokkos::parallel_for("generateQuads", HostPolicy(0, quads_.size()), KOKKOS_LAMBDA(const size_t& quad_id_) {
+		const size_t j(quad_id_ / nbXQuads);
+		const size_t i(quad_id_ - j * nbXQuads);
+		const size_t upper_left_node_index_((j * nb_x_nodes_) + i);
+		const size_t lower_left_node_index_(upper_left_node_index_ + nb_x_nodes_);
+		quads[quad_id_] = Quad(node_ids[upper_left_node_index_], node_ids[upper_left_node_index_ + 1],
+		                       node_ids[lower_left_node_index_ + 1], node_ids[lower_left_node_index_]);
+	});
 
-	auto mesh_geometry = new MeshGeometry<2>(nodes_, edges_, quads_);
-	return new CartesianMesh2D(mesh_geometry, inner_node_ids_, 
+	auto mesh_geometry = new MeshGeometry<2>(move(nodes_), move(edges_), move(quads_));
+	auto mesh = new CartesianMesh2D(mesh_geometry, inner_node_ids_, 
 		                         top_node_ids_, bottom_node_ids_, 
 		                         left_node_ids_, right_node_ids_,
 		                         top_left_node_id_, top_right_node_id_,
-		                         bottom_left_node_id_, bottom_right_node_id_);
+		                         bottom_left_node_id_, bottom_right_node_id_,
+		                         ordering);
+	return mesh;
 }
 
 }
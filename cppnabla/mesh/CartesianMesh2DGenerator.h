@@ -20,7 +20,7 @@ class CartesianMesh2D;
 class CartesianMesh2DGenerator
 {
 public:
-  static CartesianMesh2D* generate(size_t nbXQuads, size_t nbYQuads, double xSize, double ySize, int cylindrical_mesh, double minimum_radius);
+  static CartesianMesh2D* generate(size_t nbXQuads, size_t nbYQuads, double xSize, double ySize, int cylindrical_mesh, double minimum_radius, int ordering = 0);
 };
 
 }
@@ -25,6 +25,8 @@ class MeshGeometry
 public:
 	MeshGeometry(const vector<RealArray1D<N>>& nodes, const vector<Edge>& edges, const vector<Quad>& quads)
 	  : m_nodes(nodes), m_edges(edges), m_quads(quads) { }
+	MeshGeometry(vector<RealArray1D<N>>&& nodes, vector<Edge>&& edges, vector<Quad>&& quads)
+	  : m_nodes(move(nodes)), m_edges(move(edges)), m_quads(move(quads)) { }
 
 	const vector<RealArray1D<N>>& getNodes() noexcept { return m_nodes; }
 	const vector<Edge>& getEdges() noexcept { return m_edges; }
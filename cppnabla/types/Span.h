@@ -0,0 +1,44 @@
+/*******************************************************************************
+ * Copyright (c) 2020 CEA
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * http://www.eclipse.org/legal/epl-2.0.
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ * Contributors: see AUTHORS file
+ *******************************************************************************/
+#ifndef TYPES_SPAN_H_
+#define TYPES_SPAN_H_
+
+#include <cstddef>
+
+namespace nablalib
+{
+
+/*
+ * Vue non proprietaire (pointeur + taille) sur une tranche contigue d'un
+ * tableau. Utilisee pour rendre les connectivites du maillage sans allocation
+ * dans les noyaux Kokkos.
+ */
+template<typename T>
+class Span
+{
+public:
+	Span() noexcept : m_data(nullptr), m_size(0) {}
+	Span(const T* data, const size_t size) noexcept : m_data(data), m_size(size) {}
+
+	size_t size() const noexcept { return m_size; }
+	bool empty() const noexcept { return m_size == 0; }
+	const T& operator[](const size_t i) const noexcept { return m_data[i]; }
+	const T* data() const noexcept { return m_data; }
+	const T* begin() const noexcept { return m_data; }
+	const T* end() const noexcept { return m_data + m_size; }
+
+private:
+	const T* m_data;
+	size_t m_size;
+};
+
+}  // namespace nablalib
+
+#endif /* TYPES_SPAN_H_ */
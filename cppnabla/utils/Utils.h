@@ -13,8 +13,10 @@
 #include <array>
 #include <vector>
 #include <exception>
+#include <stdexcept>
 #include <string>
 #include "Timer.h"
+#include "types/Span.h"
 
 #ifndef WIN32
 /* colors */
@@ -70,6 +72,16 @@ namespace utils
 	      return i;
 	  throw std::out_of_range("Value not in vector");
 	}
+
+	// Span overload (connectivites du maillage)
+	template <typename T>
+	size_t indexOf(const Span<T>& span, const T& value)
+	{
+	  for (size_t i(0) ; i < span.size(); ++i)
+	    if (span[i] == value)
+	      return i;
+	  throw std::out_of_range("Value not in span");
+	}
 	
 
   // Estimated simulation time
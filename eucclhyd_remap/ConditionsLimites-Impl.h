@@ -0,0 +1,82 @@
+
+#ifndef CONDITIONSLIMITES_IMPL_H
+#define CONDITIONSLIMITES_IMPL_H
+
+#include "Eucclhyd.h"             // for Eucclhyd
+#include "types/MathFunctions.h"  // for det, dot, matVectProduct, norm
+
+/**
+ * resolution directe de M V = G, M de taille 2x2 : memes operations que
+ * matVectProduct(inverse(M), G) sans construire l'inverse.
+ * Le 0.0 + reproduit l'accumulation de dot (signe des zeros compris)
+ */
+KOKKOS_INLINE_FUNCTION
+RealArray1D<dim> Eucclhyd::solve2x2(const RealArray2D<dim, dim>& M,
+                                    const RealArray1D<dim>& G) {
+  const double alpha = 1.0 / MathFunctions::det(M);
+  const double i00(M[1][1] * alpha), i01(-M[0][1] * alpha);
+  const double i10(-M[1][0] * alpha), i11(M[0][0] * alpha);
+  return {{0.0 + i00 * G[0] + i01 * G[1], 0.0 + i10 * G[0] + i11 * G[1]}};
+}
+
+KOKKOS_INLINE_FUNCTION
+RealArray1D<dim> Eucclhyd::nodeVelocityBoundaryCondition(
+    const int BC, const RealArray1D<dim>& BCValue,
+    const RealArray2D<dim, dim>& Mp, const RealArray1D<dim>& Gp) {
+  if (BC == 200)
+    return (dot(Gp, BCValue) /
+            (dot(MathFunctions::matVectProduct(Mp, BCValue), BCValue)) *
+            BCValue);
+  else if (BC == 201)
+    return BCValue;
+  else if (BC == 202)
+    return solve2x2(Mp, Gp);
+
+  return zeroVect;  // inutile juste pour eviter le warning de compilation
+}
+
+KOKKOS_INLINE_FUNCTION
+RealArray1D<dim> Eucclhyd::nodeVelocityBoundaryConditionCorner(
+    const int BC1, const RealArray1D<dim>& BCValue1, const int BC2,
+    const RealArray1D<dim>& BCValue2, const RealArray2D<dim, dim>& Mp,
+    const RealArray1D<dim>& Gp) {
+  if (BC1 == 200 && BC2 == 200) {
+    if (MathFunctions::fabs(MathFunctions::fabs(dot(BCValue1, BCValue2)) -
+                            MathFunctions::norm(BCValue1) *
+                                MathFunctions::norm(BCValue2)) < 1.0E-8)
+      return (dot(Gp, BCValue1) /
+              (dot(MathFunctions::matVectProduct(Mp, BCValue1), BCValue1)) *
+              BCValue1);
+    else {
+      return zeroVect;
+    }
+  } else if (BC1 == 201 && BC2 == 201) {
+    return (0.5 * (BCValue1 + BCValue2));
+  } else if (BC1 == 202 && BC2 == 202) {
+    return solve2x2(Mp, Gp);
+  } else {
+    { return zeroVect; }
+  }
+}
+
+/**
+ * vitesse du noeud pNodes : resolution directe pour un noeud interieur,
+ * conditions aux limites des bords m_node_boundary(pNodes, .) sinon.
+ * BC et BCValue sont ranges selon CartesianMesh2D::Direction
+ */
+KOKKOS_INLINE_FUNCTION
+RealArray1D<dim> Eucclhyd::nodeVelocity(const int pNodes, const int* BC,
+                                        const RealArray1D<dim>* BCValue,
+                                        const RealArray2D<dim, dim>& Mp,
+                                        const RealArray1D<dim>& Gp) {
+  const int d1(m_node_boundary(pNodes, 0));
+  const int d2(m_node_boundary(pNodes, 1));
+  if (d1 < 0)
+    return solve2x2(Mp, Gp);
+  else if (d2 < 0)
+    return nodeVelocityBoundaryCondition(BC[d1], BCValue[d1], Mp, Gp);
+  return nodeVelocityBoundaryConditionCorner(BC[d1], BCValue[d1], BC[d2],
+                                             BCValue[d2], Mp, Gp);
+}
+
+#endif  // CONDITIONSLIMITES_IMPL_H
@@ -13,6 +13,7 @@
 #include <string>                         // for allocator, string
 #include <vector>                         // for vector
 
+#include "../includes/BilanConservation.h"
 #include "../includes/CasTest.h"
 #include "../includes/ConditionsLimites.h"
 #include "../includes/Constantes.h"
@@ -21,6 +22,7 @@
 #include "../includes/Freefunctions.h"
 #include "../includes/GestionTemps.h"
 #include "../includes/Limiteurs.h"
+#include "../includes/MaterialView.h"
 #include "../includes/Options.h"
 #include "../includes/Sortie.h"
 #include "../includes/VariablesLagRemap.h"
@@ -69,6 +71,12 @@ class Eucclhyd {
   double m_global_total_energy_L, m_global_total_energy_T,
       m_global_total_energy_0;
   double m_total_masse_L, m_total_masse_T, m_total_masse_0;
+  // masses globales par materiau
+  RealArray1D<nbmatmax> m_total_masse_env_L, m_total_masse_env_T,
+      m_total_masse_env_0;
+  // pas de temps local minimum et maille qui le realise
+  double m_cell_deltat_min;
+  int m_cell_deltat_loc;
 
   // cells a debuguer
   int dbgcell1 = -389;
@@ -85,28 +93,28 @@ class Eucclhyd {
   Kokkos::View<double*> m_cell_coord_y;
   // volume
   Kokkos::View<double*> m_euler_volume;
-  Kokkos::View<RealArray1D<nbmatmax>*> m_lagrange_volume;
+  CellMaterialView m_lagrange_volume;
   // densite
   Kokkos::View<double*> m_density_n;
   Kokkos::View<double*> m_density_nplus1;
-  Kokkos::View<RealArray1D<nbmatmax>*> m_density_env_n;
-  Kokkos::View<RealArray1D<nbmatmax>*> m_density_env_nplus1;
+  CellMaterialView m_density_env_n;
+  CellMaterialView m_density_env_nplus1;
   // masse
   Kokkos::View<double*> m_cell_mass;
-  Kokkos::View<RealArray1D<nbmatmax>*> m_cell_mass_env;
+  CellMaterialView m_cell_mass_env;
   // masse aux noeuds
   // pression 
   Kokkos::View<double*> m_pressure;
-  Kokkos::View<RealArray1D<nbmatmax>*> m_pressure_env;
+  CellMaterialView m_pressure_env;
   Kokkos::View<double*> m_pressure_env1;
   Kokkos::View<double*> m_pressure_env2;
   Kokkos::View<double*> m_pressure_env3;
   // energie interne
   Kokkos::View<double*> m_internal_energy_n;
   Kokkos::View<double*> m_internal_energy_nplus1;
-  Kokkos::View<RealArray1D<nbmatmax>*> m_internal_energy_env_n;
-  Kokkos::View<RealArray1D<nbmatmax>*> m_internal_energy_env_nplus1;
-  Kokkos::View<RealArray1D<nbmatmax>*> m_dpde_env;
+  CellMaterialView m_internal_energy_env_n;
+  CellMaterialView m_internal_energy_env_nplus1;
+  CellMaterialView m_dpde_env;
   // vitesses
   Kokkos::View<RealArray1D<dim>*> m_node_velocity_n;
   Kokkos::View<RealArray1D<dim>*> m_node_velocity_nplus1;
@@ -115,26 +123,19 @@ class Eucclhyd {
   Kokkos::View<RealArray1D<dim>*> m_cell_velocity_nplus1;
   // vitesse du son
   Kokkos::View<double*> m_speed_velocity;
-  Kokkos::View<RealArray1D<nbmatmax>*> m_speed_velocity_env;
+  CellMaterialView m_speed_velocity_env;
   // fraction volumique
-  Kokkos::View<RealArray1D<nbmatmax>*> m_fracvol_env;
+  CellMaterialView m_fracvol_env;
   Kokkos::View<double*> m_fracvol_env1;
   Kokkos::View<double*> m_fracvol_env2;
   Kokkos::View<double*> m_fracvol_env3;
-  Kokkos::View<RealArray1D<nbmatmax>*> m_node_fracvol;
+  MaterialView m_node_fracvol;
   // fraction massique
-  Kokkos::View<RealArray1D<nbmatmax>*> m_mass_fraction_env;
+  CellMaterialView m_mass_fraction_env;
   // sorties interface
   Kokkos::View<double*> m_interface12;
   Kokkos::View<double*> m_interface13;
   Kokkos::View<double*> m_interface23;
-  // sortie energie et masse globales
-  Kokkos::View<double*> m_total_energy_0;
-  Kokkos::View<double*> m_total_energy_T;
-  Kokkos::View<double*> m_total_energy_L;
-  Kokkos::View<double*> m_global_masse_0;
-  Kokkos::View<double*> m_global_masse_T;
-  Kokkos::View<double*> m_global_masse_L;
   
   
   
@@ -147,20 +148,20 @@ class Eucclhyd {
   Kokkos::View<double*> m_cell_deltat;
   Kokkos::View<double*> m_x_cell_velocity;
   Kokkos::View<double*> m_y_cell_velocity;
-  Kokkos::View<double**> m_pressure_extrap;
-  Kokkos::View<RealArray1D<nbmatmax>**> m_pressure_env_extrap;
-  Kokkos::View<RealArray1D<dim>**> m_cell_velocity_extrap;
   Kokkos::View<RealArray1D<dim>*> m_pressure_gradient;
   Kokkos::View<RealArray1D<dim>**> m_pressure_gradient_env;
   Kokkos::View<RealArray2D<dim, dim>*> m_velocity_gradient;
   Kokkos::View<RealArray1D<dim>**> m_node_force_n;
   Kokkos::View<RealArray1D<dim>**> m_node_force_nplus1;
+  // vides si forcesMateriauxRecalculees : les forces par materiau sont alors
+  // recalculees dans updateCellCenteredLagrangeVariables et seule leur somme
+  // par maille, lue par le gradient de pression d'ordre 2, est conservee
   Kokkos::View<RealArray1D<dim>***> m_node_force_env_n;
   Kokkos::View<RealArray1D<dim>***> m_node_force_env_nplus1;
-  Kokkos::View<RealArray1D<dim>*> m_node_G;
-  Kokkos::View<RealArray2D<dim, dim>**> m_dissipation_matrix;
-  Kokkos::View<RealArray2D<dim, dim>***> m_dissipation_matrix_env;
-  Kokkos::View<RealArray2D<dim, dim>*> m_node_dissipation;
+  Kokkos::View<RealArray1D<dim>**> m_cell_force_env;
+  // directions des bords portant chaque noeud (-1 si aucune), voir
+  // initNodeBoundary
+  Kokkos::View<int*[2]> m_node_boundary;
 
   utils::Timer global_timer;
   utils::Timer cpu_timer;
@@ -217,12 +218,12 @@ class Eucclhyd {
         m_pressure_env1("pressure_env1", nbCells),
         m_pressure_env2("pressure_env2", nbCells),
         m_pressure_env3("pressure_env3", nbCells),
-        m_pressure_env("pp", nbCells),
+        m_pressure_env("pp", varlp->layout),
         m_cell_mass("cell_mass", nbCells),
-        m_cell_mass_env("mp", nbCells),
+        m_cell_mass_env("mp", varlp->layout),
         m_euler_volume("euler_volume", nbCells),
-        m_mass_fraction_env("mass_fraction_env", nbCells),
-        m_fracvol_env("fracvol_env", nbCells),
+        m_mass_fraction_env("mass_fraction_env", varlp->layout),
+        m_fracvol_env("fracvol_env", varlp->layout),
         m_node_fracvol("node_fracvol", nbNodes),
         m_fracvol_env1("fracvol_env1", nbCells),
         m_fracvol_env2("fracvol_env2", nbCells),
@@ -230,93 +231,127 @@ class Eucclhyd {
         m_interface12("interface12", nbCells),
         m_interface23("interface23", nbCells),
         m_interface13("interface13", nbCells),
-        m_lagrange_volume("lagrange_volume", nbCells),
+        m_lagrange_volume("lagrange_volume", varlp->layout),
         m_cell_perimeter("cell_perimeter", nbCells),
         m_speed_velocity("speed_velocity", nbCells),
-        m_speed_velocity_env("speed_velocity_env", nbCells),
-        m_cell_deltat("cell_deltat", nbCells),
+        m_speed_velocity_env("speed_velocity_env", varlp->layout),
+        m_cell_deltat("cell_deltat", so->pas_de_temps ? nbCells : 0),
         m_node_velocity_n("node_velocity_n", nbNodes),
         m_node_velocity_nplus1("node_velocity_nplus1", nbNodes),
-        m_total_energy_0("total_energy_0", nbCells),
-        m_total_energy_T("total_energy_T", nbCells),
-        m_total_energy_L("total_energy_L", nbCells),
-        m_global_masse_0("global_masse_0", nbCells),
-        m_global_masse_T("global_masse_T", nbCells),
-        m_global_masse_L("global_masse_L", nbCells),
         m_density_n("density_n", nbCells),
         m_density_nplus1("density_nplus1", nbCells),
-        m_density_env_n("density_env_n", nbCells),
-        m_density_env_nplus1("density_env_nplus1", nbCells),
+        m_density_env_n("density_env_n", varlp->layout),
+        m_density_env_nplus1("density_env_nplus1", varlp->layout),
         m_cell_velocity_n("cell_velocity_n", nbCells),
         m_cell_velocity_nplus1("cell_velocity_nplus1", nbCells),
         m_x_cell_velocity("x_cell_velocity", nbCells),
         m_y_cell_velocity("y_cell_velocity", nbCells),
         m_internal_energy_n("internal_energy_n", nbCells),
         m_internal_energy_nplus1("internal_energy_nplus1", nbCells),
-        m_internal_energy_env_n("internal_energy_env_n", nbCells),
-        m_internal_energy_env_nplus1("internal_energy_env_nplus1", nbCells),
-        m_dpde_env("dpde_env", nbCells),
-        m_pressure_extrap("pressure_extrap", nbCells, nbNodesOfCell),
-        m_pressure_env_extrap("pressure_env_extrap", nbCells, nbNodesOfCell),
-        m_cell_velocity_extrap("cell_velocity_extrap", nbCells, nbNodesOfCell),
+        m_internal_energy_env_n("internal_energy_env_n", varlp->layout),
+        m_internal_energy_env_nplus1("internal_energy_env_nplus1",
+                                     varlp->layout),
+        m_dpde_env("dpde_env", varlp->layout),
         m_pressure_gradient("pressure_gradient", nbCells),
         m_pressure_gradient_env("pressure_gradient_env", nbCells, nbmatmax),
         m_velocity_gradient("velocity_gradient", nbCells),
         m_node_force_n("node_force_n", nbNodes, nbCellsOfNode),
         m_node_force_nplus1("node_force_nplus1", nbNodes, nbCellsOfNode),
-        m_node_force_env_n("node_force_env_n", nbNodes, nbCellsOfNode,
-                           nbmatmax),
-        m_node_force_env_nplus1("node_force_env_nplus1", nbNodes, nbCellsOfNode,
-                                nbmatmax),
-        m_node_G("node_G", nbNodes),
-        m_dissipation_matrix("dissipation_matrix", nbNodes, nbCellsOfNode),
-        m_dissipation_matrix_env("dissipation_matrix_env", nbNodes,
-                                 nbCellsOfNode, nbmatmax),
-        m_node_dissipation("node_dissipation", nbNodes) {
+        m_node_force_env_n("node_force_env_n",
+                           options->forcesMateriauxRecalculees ? 0 : nbNodes,
+                           nbCellsOfNode, options->nbmat),
+        m_node_force_env_nplus1(
+            "node_force_env_nplus1",
+            options->forcesMateriauxRecalculees ? 0 : nbNodes, nbCellsOfNode,
+            options->nbmat),
+        m_cell_force_env("cell_force_env",
+                         options->forcesMateriauxRecalculees &&
+                                 options->spaceOrder == 2
+                             ? nbCells
+                             : 0,
+                         options->nbmat),
+        m_node_boundary("node_boundary", nbNodes) {
     // Copy node coordinates
     const auto& gNodes = mesh->getGeometry()->getNodes();
     Kokkos::parallel_for(nbNodes, KOKKOS_LAMBDA(const int& rNodes) {
       m_node_coord(rNodes) = gNodes[rNodes];
     });
+    initNodeBoundary();
   }
 
  private:
-  void computeBoundaryNodeVelocities() noexcept;
-  RealArray1D<dim> nodeVelocityBoundaryCondition(int BC,
-                                                 RealArray1D<dim> BCValue,
-                                                 RealArray2D<dim, dim> Mp,
-                                                 RealArray1D<dim> Gp);
+  void initNodeBoundary() noexcept;
+  RealArray1D<dim> nodeVelocityBoundaryCondition(
+      const int BC, const RealArray1D<dim>& BCValue,
+      const RealArray2D<dim, dim>& Mp, const RealArray1D<dim>& Gp);
   RealArray1D<dim> nodeVelocityBoundaryConditionCorner(
-      int BC1, RealArray1D<dim> BCValue1, int BC2, RealArray1D<dim> BCValue2,
-      RealArray2D<dim, dim> Mp, RealArray1D<dim> Gp);
+      const int BC1, const RealArray1D<dim>& BCValue1, const int BC2,
+      const RealArray1D<dim>& BCValue2, const RealArray2D<dim, dim>& Mp,
+      const RealArray1D<dim>& Gp);
+  RealArray1D<dim> nodeVelocity(const int pNodes, const int* BC,
+                                const RealArray1D<dim>* BCValue,
+                                const RealArray2D<dim, dim>& Mp,
+                                const RealArray1D<dim>& Gp);
 
   void setUpTimeLoopN() noexcept;
+  void buildMaterialLayout() noexcept;
 
   void computeCornerNormal() noexcept;
   void computeEOS();
   void computePressionMoyenne() noexcept;
+  template <int NBMAT>
+  void computePressionMoyenne() noexcept;
+  void computeGradients() noexcept;
+  template <int NBMAT>
   void computeGradients() noexcept;
   void computeMass() noexcept;
-  void computeDissipationMatrix() noexcept;
+  template <int NBMAT>
+  void computeMass() noexcept;
   void computem_cell_deltat() noexcept;
-  void extrapolateValue() noexcept;
-  void computeG() noexcept;
-  void computeNodeDissipationMatrixAndG() noexcept;
-  void computeNodeVelocity() noexcept;
+  // bornes des valeurs extrapolees aux coins d'un noeud (ordre 2)
+  struct BornesExtrapolation {
+    double minP[nbmatmax], maxP[nbmatmax];
+    double minV[dim], maxV[dim];
+  };
+  RealArray2D<dim, dim> cornerMatrix(const int pNodes, const int cCellsOfNodeP);
+  void extrapolationBounds(const size_t pId, BornesExtrapolation& bornes);
+  template <int NBMAT>
+  void extrapolateCorner(const int pNodes, const int cCells,
+                         const BornesExtrapolation& bornes, double& ppc,
+                         RealArray1D<nbmatmax>& ppcEnv, RealArray1D<dim>& Vpc);
+  RealArray1D<dim> cornerForceEnv(const int cCells, const int imat,
+                                  const double ppcEnv,
+                                  const RealArray1D<dim>& lpc,
+                                  const RealArray2D<dim, dim>& cornerM,
+                                  const RealArray1D<dim>& deltaV);
+  void computeCornerForces() noexcept;
+  template <int NBMAT>
+  void computeCornerForces() noexcept;
   void computeFaceVelocity() noexcept;
   void computeLagrangePosition() noexcept;
-  void computeSubCellForce() noexcept;
-  void computeLagrangeVolumeAndCenterOfGravity() noexcept;
+  void computeLagrangeGeometry() noexcept;
+  template <int NBMAT>
+  void computeLagrangeGeometry() noexcept;
   void computeFacedeltaxLagrange() noexcept;
   void updateCellCenteredLagrangeVariables() noexcept;
+  template <int NBMAT>
+  void updateCellCenteredLagrangeVariables() noexcept;
 
   void remapCellcenteredVariable() noexcept;
+  template <int NBMAT>
+  void remapCellcenteredVariable() noexcept;
+  template <int NBMAT>
+  KOKKOS_INLINE_FUNCTION RealArray1D<nbmatmax> computeRemapFracvol(
+      const int cCells) const noexcept;
+  template <int NBMAT>
+  void classifyRemapCells() noexcept;
 
   void switchalpharho_rho() noexcept;
   void switchrho_alpharho() noexcept;
   void PreparecellvariablesForParticles() noexcept;
 
-  RealArray2D<2, 2> inverse(RealArray2D<2, 2> a);
+  RealArray1D<dim> solve2x2(const RealArray2D<dim, dim>& M,
+                            const RealArray1D<dim>& G);
   template <size_t N, size_t M>
   RealArray2D<N, M> tensProduct(RealArray1D<N> a, RealArray1D<M> b);
   double crossProduct2d(RealArray1D<2> a, RealArray1D<2> b);
@@ -336,25 +371,24 @@ class Eucclhyd {
    * m_cell_coord, m_cell_coordLagrange, m_cell_coord_x, m_cell_coord_y, Xf,
    * bottomBC, bottomBCValue, c, cfl, deltat_n, deltat_nplus1, m_cell_deltat,
    * deltaxLagrange, eos, eosPerfectGas, m_internal_energy_n, faceLength,
-   * faceNormal, faceNormalVelocity, gamma, gradPhi1, gradPhi2, gradPhiFace1,
-   * gradPhiFace2, m_velocity_gradient, m_pressure_gradient, leftBC,
-   * leftBCValue, lminus, m_lpc, lplus, m, nminus, nplus, outerFaceNormal, p,
-   * m_pressure_extrap, m_cell_perimeter, phiFace1, phiFace2,
-   * projectionLimiterId, projectionOrder, m_density_n, rightBC, rightBCValue,
-   * spaceOrder, t_n, topBC, topBCValue, v, vLagrange, x_then_y_n Out variables:
-   * m_node_force_nplus1, G, M, m_node_dissipation, ULagrange, Uremap1, Uremap2,
-   * m_cell_velocity_extrap, m_cell_velocity_nplus1, m_node_velocity_nplus1,
-   * XLagrange, m_cell_coordLagrange, c, deltat_nplus1, m_cell_deltat,
-   * deltaxLagrange, m_internal_energy_nplus1, faceNormalVelocity, gradPhi1,
-   * gradPhi2, gradPhiFace1, gradPhiFace2, m_velocity_gradient,
-   * m_pressure_gradient, m, p, m_pressure_extrap, phiFace1, phiFace2,
-   * m_density_nplus1, t_nplus1, vLagrange, x_then_y_nplus1
+   * faceNormal, faceNormalVelocity, gamma, m_velocity_gradient,
+   * m_pressure_gradient, leftBC, leftBCValue, lminus, m_lpc, lplus, m, nminus,
+   * nplus, outerFaceNormal, p, m_pressure_extrap, m_cell_perimeter, phiFace1,
+   * phiFace2, projectionLimiterId, projectionOrder, m_density_n, rightBC,
+   * rightBCValue, spaceOrder, t_n, topBC, topBCValue, v, vLagrange, x_then_y_n
+   * Out variables: m_node_force_nplus1, G, M, m_node_dissipation, ULagrange,
+   * Uremap1, Uremap2, m_cell_velocity_extrap, m_cell_velocity_nplus1,
+   * m_node_velocity_nplus1, XLagrange, m_cell_coordLagrange, c, deltat_nplus1,
+   * m_cell_deltat, deltaxLagrange, m_internal_energy_nplus1,
+   * faceNormalVelocity, m_velocity_gradient, m_pressure_gradient, m, p,
+   * m_pressure_extrap, phiFace1, phiFace2, m_density_nplus1, t_nplus1,
+   * vLagrange, x_then_y_nplus1
    */
   void executeTimeLoopN() noexcept;
 
   /**
    * Job computedeltat called @3.0 in executeTimeLoopN method.
-   * In variables: cfl, deltat_n, m_cell_deltat
+   * In variables: cfl, deltat_n, m_cell_deltat_min, m_cell_deltat_loc
    * Out variables: deltat_nplus1
    */
   void computedeltat() noexcept;
@@ -368,6 +402,7 @@ class Eucclhyd {
 
  public:
   void simulate();
+  size_t getAllocatedBytes() const noexcept;
 };
 
 #include "Utiles-Impl.h"
@@ -7,6 +7,7 @@
 #include <map>              // for map
 #include <utility>          // for pair, swap
 
+#include "../includes/TailleMemoire.h"  // for printAllocatedBytes
 #include "../remap/Remap.h"
 #include "Eucclhyd.h"
 #include "types/MathFunctions.h"  // for min
@@ -67,6 +68,9 @@ void Eucclhyd::dumpVariables() noexcept {
       cellVariables.insert(
           pair<string, double*>("VelocityY", m_y_cell_velocity.data()));
     }
+    if (so->pas_de_temps)
+      cellVariables.insert(
+          pair<string, double*>("CellDeltat", m_cell_deltat.data()));
 
     partVariables.insert(pair<string, double*>(
         "VolumePart", particules->m_particle_volume.data()));
@@ -95,16 +99,15 @@ void Eucclhyd::dumpVariables() noexcept {
  * m_cell_coordLagrange, m_cell_coord_x, m_cell_coord_y, Xf, bottomBC,
  * bottomBCValue, c, cfl, deltat_n, deltat_nplus1, m_cell_deltat,
  * deltaxLagrange, eos, eosPerfectGas, m_internal_energy_n, faceLength,
- * faceNormal, faceNormalVelocity, gamma, gradPhi1, gradPhi2, gradPhiFace1,
- * gradPhiFace2, m_velocity_gradient, m_pressure_gradient, leftBC, leftBCValue,
- * lminus, m_lpc, lplus, m, nminus, nplus, outerFaceNormal, p,
- * m_pressure_extrap, m_cell_perimeter, phiFace1, phiFace2, projectionLimiterId,
- * projectionOrder, m_density_n, rightBC, rightBCValue, spaceOrder, t_n, topBC,
- * topBCValue, v, vLagrange, x_then_y_n Out variables: m_node_force_nplus1, G,
- * M, m_node_dissipation, ULagrange, Uremap1, Uremap2, m_cell_velocity_extrap,
- * m_cell_velocity_nplus1, m_node_velocity_nplus1, XLagrange, XcLagrange, c,
- * deltat_nplus1, m_cell_deltat, deltaxLagrange, m_internal_energy_nplus1,
- * faceNormalVelocity, gradPhi1, gradPhi2, gradPhiFace1, gradPhiFace2,
+ * faceNormal, faceNormalVelocity, gamma, m_velocity_gradient,
+ * m_pressure_gradient, leftBC, leftBCValue, lminus, m_lpc, lplus, m, nminus,
+ * nplus, outerFaceNormal, p, m_pressure_extrap, m_cell_perimeter, phiFace1,
+ * phiFace2, projectionLimiterId, projectionOrder, m_density_n, rightBC,
+ * rightBCValue, spaceOrder, t_n, topBC, topBCValue, v, vLagrange, x_then_y_n
+ * Out variables: m_node_force_nplus1, G, M, m_node_dissipation, ULagrange,
+ * Uremap1, Uremap2, m_cell_velocity_extrap, m_cell_velocity_nplus1,
+ * m_node_velocity_nplus1, XLagrange, XcLagrange, c, deltat_nplus1,
+ * m_cell_deltat, deltaxLagrange, m_internal_energy_nplus1, faceNormalVelocity,
  * m_velocity_gradient, m_pressure_gradient, m, p, m_pressure_extrap, phiFace1,
  * phiFace2, m_density_nplus1, t_nplus1, vLagrange, x_then_y_nplus1
  */
@@ -126,24 +129,18 @@ void Eucclhyd::executeTimeLoopN() noexcept {
     computeEOS();
     computePressionMoyenne();
     if (options->AvecParticules == 1) switchrho_alpharho();
-    computeGradients();                         // @1.0
-    computeMass();                              // @1.0
-    computeDissipationMatrix();                 // @2.0
-    computem_cell_deltat();                     // @2.0
-    dumpVariables();                            // @2.0
-    extrapolateValue();                         // @2.0
-    computeG();                                 // @3.0
-    computeNodeDissipationMatrixAndG();         // @3.0
-    computedeltat();                            // @3.0
-    computeBoundaryNodeVelocities();            // @4.0
-    computeNodeVelocity();                      // @4.0
-    updateTime();                               // @4.0
-    computeFaceVelocity();                      // @5.0
-    computeLagrangePosition();                  // @5.0
-    computeSubCellForce();                      // @5.0
-    computeLagrangeVolumeAndCenterOfGravity();  // @6.0
-    computeFacedeltaxLagrange();                // @7.0
-    updateCellCenteredLagrangeVariables();      // @7.0
+    computeGradients();                     // @1.0
+    computeMass();                          // @1.0
+    computem_cell_deltat();                 // @2.0
+    dumpVariables();                        // @2.0
+    computedeltat();                        // @3.0
+    computeCornerForces();                  // @4.0
+    updateTime();                           // @4.0
+    computeFaceVelocity();                  // @5.0
+    computeLagrangePosition();              // @5.0
+    computeLagrangeGeometry();              // @6.0
+    computeFacedeltaxLagrange();            // @7.0
+    updateCellCenteredLagrangeVariables();  // @7.0
 
     if (options->AvecParticules == 1) {
       PreparecellvariablesForParticles();
@@ -153,15 +150,9 @@ void Eucclhyd::executeTimeLoopN() noexcept {
       particules->updateParticleRetroaction();
     }
     if (options->AvecProjection == 1) {
-      remap->computeGradPhiFace1();                        // @8.0
-      remap->computeGradPhi1();                            // @9.0
-      remap->computeUpwindFaceQuantitiesForProjection1();  // @10.0
-      remap->computeUremap1();                             // @11.0
-      remap->computeGradPhiFace2();                        // @12.0
-      remap->computeGradPhi2();                            // @13.0
-      remap->computeUpwindFaceQuantitiesForProjection2();  // @14.0
-      remap->computeUremap2();                             // @15.0
-      remapCellcenteredVariable();                         // @16.0
+      remap->computeUremap1();      // @9.0
+      remap->computeUremap2();      // @13.0
+      remapCellcenteredVariable();  // @16.0
     }
 
     // Evaluate loop condition with variables at time n
@@ -228,30 +219,35 @@ void Eucclhyd::executeTimeLoopN() noexcept {
 
 /**
  * Job computedeltat called @3.0 in executeTimeLoopN method.
- * In variables: cfl, deltat_n, m_cell_deltat
+ * In variables: cfl, deltat_n, m_cell_deltat_min, m_cell_deltat_loc
  * Out variables: deltat_nplus1
  */
 KOKKOS_INLINE_FUNCTION
 void Eucclhyd::computedeltat() noexcept {
-  double reduction10(numeric_limits<double>::max());
-  {
-    Kokkos::Min<double> reducer(reduction10);
-    Kokkos::parallel_reduce("reduction10", nbCells,
-                            KOKKOS_LAMBDA(const int& cCells, double& x) {
-                              reducer.join(x, m_cell_deltat(cCells));
-                            },
-                            reducer);
-  }
   gt->deltat_nplus1 =
-      MathFunctions::min(gt->cfl * reduction10, gt->deltat_n * 1.05);
+      MathFunctions::min(gt->cfl * m_cell_deltat_min, gt->deltat_n * 1.05);
   if (gt->deltat_nplus1 < gt->deltat_min) {
     std::cerr << "Fin de la simulation par pas de temps minimum "
               << gt->deltat_nplus1 << " < " << gt->deltat_min << " et "
-              << reduction10 << std::endl;
+              << m_cell_deltat_min << " (maille limitante "
+              << m_cell_deltat_loc << ")" << std::endl;
     Kokkos::finalize();
     exit(1);
   }
 }
+/**
+ * Repartition pure/mixte des grandeurs par materiau : liste des mailles
+ * mixtes construite a partir de varlp->layout.cellMaterial puis reclassement
+ * de toutes les grandeurs par materiau aux mailles.
+ */
+void Eucclhyd::buildMaterialLayout() noexcept {
+  varlp->layout.build();
+  relayoutMaterials(varlp->layout, m_lagrange_volume, m_density_env_n,
+                    m_density_env_nplus1, m_cell_mass_env, m_pressure_env,
+                    m_internal_energy_env_n, m_internal_energy_env_nplus1,
+                    m_dpde_env, m_speed_velocity_env, m_fracvol_env,
+                    m_mass_fraction_env);
+}
 /**
  * Job setUpTimeLoopN called @3.0 in simulate method.
  * In variables: m_node_force_n0, m_cell_velocity_n0, m_node_velocity_n0,
@@ -294,37 +290,27 @@ void Eucclhyd::setUpTimeLoopN() noexcept {
     gt->deltat_init = 1.0e-5;  // avec pression de 1.e5 / 1.e-8
   }
   gt->deltat_n = gt->deltat_init;
-  m_global_total_energy_0 = 0.;
-  Kokkos::parallel_for(
+  int nbmat = options->nbmat;
+  conservationlib::Bilan bilan;
+  conservationlib::ReducteurBilan reducer(bilan);
+  Kokkos::parallel_reduce(
       "init_m_global_total_energy_0", nbCells,
-      KOKKOS_LAMBDA(const int& cCells) {
-        m_total_energy_0(cCells) =
-            (init->m_density_n0(cCells) * m_euler_volume(cCells)) *
-            (init->m_internal_energy_n0(cCells) +
-             0.5 * (init->m_cell_velocity_n0(cCells)[0] *
-                        init->m_cell_velocity_n0(cCells)[0] +
-                    init->m_cell_velocity_n0(cCells)[1] *
-                        init->m_cell_velocity_n0(cCells)[1]));
-        m_global_masse_0(cCells) =
-            (init->m_density_n0(cCells) * m_euler_volume(cCells));
-      });
-  double reductionE(0.), reductionM(0.);
-  {
-    Kokkos::Sum<double> reducerE(reductionE);
-    Kokkos::parallel_reduce("reductionE", nbCells,
-                            KOKKOS_LAMBDA(const int& cCells, double& x) {
-                              reducerE.join(x, m_total_energy_0(cCells));
-                            },
-                            reducerE);
-    Kokkos::Sum<double> reducerM(reductionM);
-    Kokkos::parallel_reduce("reductionM", nbCells,
-                            KOKKOS_LAMBDA(const int& cCells, double& x) {
-                              reducerM.join(x, m_global_masse_0(cCells));
-                            },
-                            reducerM);
-  }
-  m_global_total_energy_0 = reductionE;
-  m_total_masse_0 = reductionM;
+      KOKKOS_LAMBDA(const int& cCells, conservationlib::Bilan& x) {
+        const double masse(init->m_density_n0(cCells) * m_euler_volume(cCells));
+        x.energie += masse * (init->m_internal_energy_n0(cCells) +
+                              0.5 * (init->m_cell_velocity_n0(cCells)[0] *
+                                         init->m_cell_velocity_n0(cCells)[0] +
+                                     init->m_cell_velocity_n0(cCells)[1] *
+                                         init->m_cell_velocity_n0(cCells)[1]));
+        x.masse += masse;
+        for (int imat = 0; imat < nbmat; imat++)
+          x.masseEnv[imat] += m_mass_fraction_env(cCells)[imat] * masse;
+      },
+      reducer);
+  m_global_total_energy_0 = bilan.energie;
+  m_total_masse_0 = bilan.masse;
+  for (int imat = 0; imat < nbmatmax; imat++)
+    m_total_masse_env_0[imat] = bilan.masseEnv[imat];
   // pour les sorties au temps 0
   Kokkos::parallel_for(
       "initDensity", nbCells, KOKKOS_LAMBDA(const int& cCells) {
@@ -353,6 +339,35 @@ void Eucclhyd::updateTime() noexcept {
   gt->t_nplus1 = gt->t_n + gt->deltat_nplus1;
 }
 
+/**
+ *******************************************************************************
+ * \file getAllocatedBytes()
+ * \brief taille memoire des tableaux du schema
+ *******************************************************************************
+ */
+size_t Eucclhyd::getAllocatedBytes() const noexcept {
+  return allocatedBytes(m_node_coord, m_cell_coord, m_cell_coord_x,
+                        m_cell_coord_y, m_euler_volume, m_lagrange_volume,
+                        m_density_n, m_density_nplus1, m_density_env_n,
+                        m_density_env_nplus1, m_cell_mass, m_cell_mass_env,
+                        m_pressure, m_pressure_env, m_pressure_env1,
+                        m_pressure_env2, m_pressure_env3, m_internal_energy_n,
+                        m_internal_energy_nplus1, m_internal_energy_env_n,
+                        m_internal_energy_env_nplus1, m_dpde_env,
+                        m_node_velocity_n, m_node_velocity_nplus1,
+                        m_cell_velocity_n, m_cell_velocity_nplus1,
+                        m_speed_velocity, m_speed_velocity_env, m_fracvol_env,
+                        m_fracvol_env1, m_fracvol_env2, m_fracvol_env3,
+                        m_node_fracvol, m_mass_fraction_env, m_interface12,
+                        m_interface13, m_interface23, m_lpc, m_nplus, m_nminus,
+                        m_lplus, m_lminus, m_cell_perimeter, m_cell_deltat,
+                        m_x_cell_velocity, m_y_cell_velocity,
+                        m_pressure_gradient, m_pressure_gradient_env,
+                        m_velocity_gradient, m_node_force_n,
+                        m_node_force_nplus1, m_node_force_env_n,
+                        m_node_force_env_nplus1, m_cell_force_env,
+                        m_node_boundary);
+}
 void Eucclhyd::simulate() {
   std::cout << "\n"
             << __BLUE_BKG__ << __YELLOW__ << __BOLD__
@@ -397,6 +412,7 @@ void Eucclhyd::simulate() {
   init->initVpAndFpc();              // @1.0
   init->initBoundaryConditions();
   init->initVar();                   // @2.0
+  buildMaterialLayout();
   init->initMeshGeometryForFaces();  // @2.0
   if (options->AvecParticules == 1) {
     particules->initPart();
@@ -407,6 +423,12 @@ void Eucclhyd::simulate() {
 
   computeCornerNormal();  // @1.0
 
+  // bilan memoire par module une fois toutes les allocations faites
+  printAllocatedBytes("Eucclhyd", getAllocatedBytes());
+  printAllocatedBytes("Remap", remap->getAllocatedBytes());
+  printAllocatedBytes("VariablesLagRemap", varlp->getAllocatedBytes());
+  printAllocatedBytes("Initialisations", init->getAllocatedBytes());
+
   executeTimeLoopN();  // @4.0
   std::cout << __YELLOW__ << "\n\tDone ! Took " << __MAGENTA__ << __BOLD__
             << global_timer.print() << __RESET__ << std::endl;
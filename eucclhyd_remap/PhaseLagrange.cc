@@ -8,13 +8,15 @@
 #include <thread>
 #include <vector>  // for vector, allocator
 
+#include "../includes/GeometrieLagrange.h"
 #include "../includes/VariablesLagRemap.h"
-#include "Eucclhyd.h"              // for Eucclhyd, Eucclhyd::...
-#include "Utiles-Impl.h"           // for Eucclhyd::tensProduct
-#include "mesh/CartesianMesh2D.h"  // for CartesianMesh2D
-#include "types/MathFunctions.h"   // for max, min, dot, matVectProduct
-#include "types/MultiArray.h"      // for operator<<
-#include "utils/Utils.h"           // for indexOf
+#include "ConditionsLimites-Impl.h"  // for Eucclhyd::nodeVelocity
+#include "Eucclhyd.h"                // for Eucclhyd, Eucclhyd::...
+#include "Utiles-Impl.h"             // for Eucclhyd::tensProduct
+#include "mesh/CartesianMesh2D.h"    // for CartesianMesh2D
+#include "types/MathFunctions.h"     // for max, min, dot, matVectProduct
+#include "types/MultiArray.h"        // for operator<<
+#include "utils/Utils.h"             // for indexOf
 using namespace variableslagremaplib;
 
 /**
@@ -66,42 +68,85 @@ void Eucclhyd::computeCornerNormal() noexcept {
  * Job computeEOS called in executeTimeLoopN method.
  */
 void Eucclhyd::computeEOS() {
-  Kokkos::parallel_for(nbCells, KOKKOS_LAMBDA(const size_t& cCells) {
-    for (int imat = 0; imat < options->nbmat; ++imat) {
-      double pression;  // m_pressure_env(cCells)[imat]
-      double density = m_density_env_n(cCells)[imat];
-      double energy = m_internal_energy_env_n(cCells)[imat];
-      double gamma = eos->gamma[imat];
-      double tension_limit = eos->tension_limit[imat];
-      double sound_speed;  // = m_speed_velocity_env_nplus1(cCells)[imat];
-      RealArray1D<3> sortie_eos;  // pression puis sound_speed puis dpde
-      //
-      sortie_eos = eos->computeEOS(eos->Nom[imat], gamma, tension_limit, density, energy);
-      m_pressure_env(cCells)[imat] = sortie_eos[0];
-      m_speed_velocity_env(cCells)[imat] = sortie_eos[1];
-      m_dpde_env(cCells)[imat] = sortie_eos[2];
-    }
-  });
+  // mailles pures : seule la loi du materiau present est evaluee, sur les
+  // valeurs du tableau dense (un materiau absent n'a ni pression ni vitesse
+  // du son)
+  auto slot(varlp->layout.slot);
+  auto density(m_density_env_n.bulk());
+  auto energy(m_internal_energy_env_n.bulk());
+  auto pression(m_pressure_env.bulk());
+  auto soundSpeed(m_speed_velocity_env.bulk());
+  auto dpde(m_dpde_env.bulk());
+  Kokkos::parallel_for(
+      "computeEOSPure", nbCells, KOKKOS_LAMBDA(const size_t& cCells) {
+        const int s(slot(cCells));
+        if (s >= 0) return;
+        // pression puis sound_speed puis dpde
+        RealArray1D<3> sortie_eos = eos->computeEOSMateriau(
+            -1 - s, density(cCells), energy(cCells));
+        pression(cCells) = sortie_eos[0];
+        soundSpeed(cCells) = sortie_eos[1];
+        dpde(cCells) = sortie_eos[2];
+      });
+  // mailles mixtes : un noyau par materiau sur les valeurs contigues de la
+  // liste compacte, la loi est choisie une fois par materiau (evaluation par
+  // lot sans branchement)
+  for (int imat = 0; imat < options->nbmat; ++imat)
+    eos->computeEOSBatch(imat, varlp->layout.nbMixedCells, MixedRank(),
+                         m_density_env_n.mixedMaterial(imat),
+                         m_internal_energy_env_n.mixedMaterial(imat),
+                         m_pressure_env.mixedMaterial(imat),
+                         m_speed_velocity_env.mixedMaterial(imat),
+                         m_dpde_env.mixedMaterial(imat));
 }
 /**
  * Job computeEOS called in executeTimeLoopN method.
  */
+template <int NBMAT>
 void Eucclhyd::computePressionMoyenne() noexcept {
-  for (int cCells = 0; cCells < nbCells; cCells++) {
-    int nbmat = options->nbmat;
-    m_pressure(cCells) = 0.;
-    for (int imat = 0; imat < nbmat; ++imat) {
-      m_pressure(cCells) +=
-          m_fracvol_env(cCells)[imat] * m_pressure_env(cCells)[imat];
-      m_speed_velocity(cCells) = MathFunctions::max(
-          m_speed_velocity(cCells), m_speed_velocity_env(cCells)[imat]);
-    }
-    // NONREG GP A SUPPRIMER
-    if (m_density_n(cCells) > 0.) {
-      m_speed_velocity(cCells) = MathFunctions::sqrt(
-          eos->gamma[0] * m_pressure(cCells) / m_density_n(cCells));
-    }
-  }
+  // mailles pures : un seul materiau contribue
+  auto slot(varlp->layout.slot);
+  auto fracvol(m_fracvol_env.bulk());
+  auto pression(m_pressure_env.bulk());
+  auto soundSpeed(m_speed_velocity_env.bulk());
+  Kokkos::parallel_for(
+      "computePressionMoyennePure", nbCells,
+      KOKKOS_LAMBDA(const size_t& cCells) {
+        if (slot(cCells) >= 0) return;
+        m_pressure(cCells) = fracvol(cCells) * pression(cCells);
+        m_speed_velocity(cCells) =
+            MathFunctions::max(m_speed_velocity(cCells), soundSpeed(cCells));
+      });
+  // mailles mixtes : somme sur les materiaux de la liste compacte
+  auto mixedCells(varlp->layout.mixedCells);
+  auto fracvolMixte(m_fracvol_env.mixed());
+  auto pressionMixte(m_pressure_env.mixed());
+  auto soundSpeedMixte(m_speed_velocity_env.mixed());
+  Kokkos::parallel_for(
+      "computePressionMoyenneMixte", varlp->layout.nbMixedCells,
+      KOKKOS_LAMBDA(const int& mCells) {
+        const int cCells(mixedCells(mCells));
+        m_pressure(cCells) = 0.;
+        for (int imat = 0; imat < NBMAT; ++imat) {
+          m_pressure(cCells) +=
+              fracvolMixte(mCells, imat) * pressionMixte(mCells, imat);
+          m_speed_velocity(cCells) = MathFunctions::max(
+              m_speed_velocity(cCells), soundSpeedMixte(mCells, imat));
+        }
+      });
+  Kokkos::parallel_for(
+      "computePressionMoyenne", nbCells, KOKKOS_LAMBDA(const size_t& cCells) {
+        // NONREG GP A SUPPRIMER
+        if (m_density_n(cCells) > 0.) {
+          m_speed_velocity(cCells) = MathFunctions::sqrt(
+              eos->gamma[0] * m_pressure(cCells) / m_density_n(cCells));
+        }
+      });
+}
+void Eucclhyd::computePressionMoyenne() noexcept {
+  dispatchNbMat(options->nbmat, [this](auto nbmat) {
+    computePressionMoyenne<decltype(nbmat)::value>();
+  });
 }
 /**
  * Job computeGradients called @1.0 in executeTimeLoopN method.
@@ -109,12 +154,13 @@ void Eucclhyd::computePressionMoyenne() noexcept {
  * Out variables: m_velocity_gradient, m_pressure_gradient,
  * m_pressure_gradient_env
  */
+template <int NBMAT>
 void Eucclhyd::computeGradients() noexcept {
   Kokkos::parallel_for(
       "computeDissipationMatrix", nbNodes, KOKKOS_LAMBDA(const int& pNodes) {
         int pId(pNodes);
         {
-          int nbmat = options->nbmat;
+          constexpr int nbmat = NBMAT;
           for (int imat = 0; imat < nbmat; imat++)
             m_node_fracvol(pNodes)[imat] = 0.;
           auto cellsOfNodeP(mesh->getCellsOfNode(pId));
@@ -156,6 +202,7 @@ void Eucclhyd::computeGradients() noexcept {
         particules->m_particlecell_fracvol_gradient_env(cCells, 2) =
             reductionF3 / m_euler_volume(cCells);
       });
+  const bool forcesEnvStockees(!options->forcesMateriauxRecalculees);
   if (options->spaceOrder == 2)
     Kokkos::parallel_for(
         "computeGradients", nbCells, KOKKOS_LAMBDA(const int& cCells) {
@@ -175,9 +222,9 @@ void Eucclhyd::computeGradients() noexcept {
           }
           m_velocity_gradient(cCells) = reduction14 / m_euler_volume(cCells);
           RealArray1D<dim> reduction15 = zeroVect;
-          RealArray1D<dim> reduction15a = zeroVect;
-          RealArray1D<dim> reduction15b = zeroVect;
-          RealArray1D<dim> reduction15c = zeroVect;
+          RealArray1D<dim> reduction15env[NBMAT];
+          for (int imat = 0; imat < NBMAT; ++imat)
+            reduction15env[imat] = zeroVect;
           {
             auto nodesOfCellC(mesh->getNodesOfCell(cId));
             for (int pNodesOfCellC = 0; pNodesOfCellC < nodesOfCellC.size();
@@ -186,344 +233,263 @@ void Eucclhyd::computeGradients() noexcept {
               int cCellsOfNodeP(utils::indexOf(mesh->getCellsOfNode(pId), cId));
               int pNodes(pId);
               reduction15 = reduction15 + m_node_force_n(pNodes, cCellsOfNodeP);
-              reduction15a =
-                  reduction15a + m_node_force_env_n(pNodes, cCellsOfNodeP, 0);
-              reduction15b =
-                  reduction15b + m_node_force_env_n(pNodes, cCellsOfNodeP, 1);
-              reduction15c =
-                  reduction15c + m_node_force_env_n(pNodes, cCellsOfNodeP, 2);
+              if (forcesEnvStockees)
+                for (int imat = 0; imat < NBMAT; ++imat)
+                  reduction15env[imat] =
+                      reduction15env[imat] +
+                      m_node_force_env_n(pNodes, cCellsOfNodeP, imat);
             }
           }
+          // forces par materiau recalculees : leur somme est deja faite
+          if (!forcesEnvStockees)
+            for (int imat = 0; imat < NBMAT; ++imat)
+              reduction15env[imat] = m_cell_force_env(cCells, imat);
           m_pressure_gradient(cCells) = reduction15 / m_euler_volume(cCells);
-          m_pressure_gradient_env(cCells, 0) =
-              reduction15a / m_euler_volume(cCells);
-          m_pressure_gradient_env(cCells, 1) =
-              reduction15b / m_euler_volume(cCells);
-          m_pressure_gradient_env(cCells, 2) =
-              reduction15c / m_euler_volume(cCells);
+          for (int imat = 0; imat < NBMAT; ++imat)
+            m_pressure_gradient_env(cCells, imat) =
+                reduction15env[imat] / m_euler_volume(cCells);
         });
 }
+void Eucclhyd::computeGradients() noexcept {
+  dispatchNbMat(options->nbmat, [this](auto nbmat) {
+    computeGradients<decltype(nbmat)::value>();
+  });
+}
 
 /**
  * Job computeMass called @1.0 in executeTimeLoopN method.
  * In variables: m_density_n, v
  * Out variables: m
  */
+template <int NBMAT>
 void Eucclhyd::computeMass() noexcept {
-  int nbmat = options->nbmat;
+  constexpr int nbmat = NBMAT;
   Kokkos::parallel_for(
       "computeMass", nbCells, KOKKOS_LAMBDA(const int& cCells) {
-        int nbmat = options->nbmat;
+        constexpr int nbmat = NBMAT;
         m_cell_mass(cCells) = m_density_n(cCells) * m_euler_volume(cCells);
         for (int imat = 0; imat < nbmat; imat++)
           m_cell_mass_env(cCells)[imat] =
               m_mass_fraction_env(cCells)[imat] * m_cell_mass(cCells);
       });
 }
-/**
- * Job computeDissipationMatrix called @2.0 in executeTimeLoopN method.
- * In variables: c, m_lminus, m_lplus, m_nminus, m_nplus, m_density_n
- * Out variables: M
- */
-void Eucclhyd::computeDissipationMatrix() noexcept {
-  Kokkos::parallel_for(
-      "computeDissipationMatrix", nbNodes, KOKKOS_LAMBDA(const int& pNodes) {
-        int pId(pNodes);
-        {
-          auto cellsOfNodeP(mesh->getCellsOfNode(pId));
-          for (int cCellsOfNodeP = 0; cCellsOfNodeP < cellsOfNodeP.size();
-               cCellsOfNodeP++) {
-            int cId(cellsOfNodeP[cCellsOfNodeP]);
-            int cCells(cId);
-            RealArray2D<dim, dim> cornerMatrix =
-                (m_lplus(pNodes, cCellsOfNodeP) *
-                 tensProduct(m_nplus(pNodes, cCellsOfNodeP),
-                             m_nplus(pNodes, cCellsOfNodeP))) +
-                (m_lminus(pNodes, cCellsOfNodeP) *
-                 tensProduct(m_nminus(pNodes, cCellsOfNodeP),
-                             m_nminus(pNodes, cCellsOfNodeP)));
-
-            m_dissipation_matrix(pNodes, cCellsOfNodeP) =
-                m_density_n(cCells) * m_speed_velocity(cCells) * cornerMatrix;
-
-            m_dissipation_matrix_env(pNodes, cCellsOfNodeP, 0) =
-                m_density_env_n(cCells)[0] * m_speed_velocity(cCells) *
-                cornerMatrix;
-            m_dissipation_matrix_env(pNodes, cCellsOfNodeP, 1) =
-                m_density_env_n(cCells)[1] * m_speed_velocity(cCells) *
-                cornerMatrix;
-            m_dissipation_matrix_env(pNodes, cCellsOfNodeP, 2) =
-                m_density_env_n(cCells)[2] * m_speed_velocity(cCells) *
-                cornerMatrix;
-          }
-        }
-      });
+void Eucclhyd::computeMass() noexcept {
+  dispatchNbMat(options->nbmat, [this](auto nbmat) {
+    computeMass<decltype(nbmat)::value>();
+  });
 }
 /**
  * Job computem_cell_deltat called @2.0 in executeTimeLoopN method.
  * In variables: m_cell_velocity_n, c, m_cell_perimeter, v
- * Out variables: m_cell_deltat
+ * Out variables: m_cell_deltat_min, m_cell_deltat_loc, m_cell_deltat
+ * (m_cell_deltat n'est rempli que si sa sortie est demandee)
  */
 void Eucclhyd::computem_cell_deltat() noexcept {
-  Kokkos::parallel_for(
-      "computem_cell_deltat", nbCells, KOKKOS_LAMBDA(const int& cCells) {
+  const bool avecSortie(m_cell_deltat.extent(0) > 0);
+  Kokkos::MinLoc<double, int>::value_type minLoc;
+  Kokkos::parallel_reduce(
+      "computem_cell_deltat", nbCells,
+      KOKKOS_LAMBDA(const int& cCells,
+                    Kokkos::MinLoc<double, int>::value_type& x) {
+        double cellDeltat;
         if (options->AvecProjection == 1) {
           // cfl euler
-          m_cell_deltat(cCells) =
-              m_euler_volume(cCells) /
-              (m_cell_perimeter(cCells) *
-               (MathFunctions::norm(m_cell_velocity_n(cCells)) +
-                m_speed_velocity(cCells)));
+          cellDeltat = m_euler_volume(cCells) /
+                       (m_cell_perimeter(cCells) *
+                        (MathFunctions::norm(m_cell_velocity_n(cCells)) +
+                         m_speed_velocity(cCells)));
         } else {
           // cfl lagrange
-          m_cell_deltat(cCells) =
-              m_euler_volume(cCells) /
-              (m_cell_perimeter(cCells) * m_speed_velocity(cCells));
+          cellDeltat = m_euler_volume(cCells) /
+                       (m_cell_perimeter(cCells) * m_speed_velocity(cCells));
         }
-      });
+        if (avecSortie) m_cell_deltat(cCells) = cellDeltat;
+        if (cellDeltat < x.val) {
+          x.val = cellDeltat;
+          x.loc = cCells;
+        }
+      },
+      Kokkos::MinLoc<double, int>(minLoc));
+  m_cell_deltat_min = minLoc.val;
+  m_cell_deltat_loc = minLoc.loc;
+}
+/**
+ * matrice geometrique du coin (pNodes, cCellsOfNodeP) : la matrice de
+ * dissipation du coin vaut rho c fois cette matrice
+ */
+KOKKOS_INLINE_FUNCTION
+RealArray2D<dim, dim> Eucclhyd::cornerMatrix(const int pNodes,
+                                             const int cCellsOfNodeP) {
+  return (m_lplus(pNodes, cCellsOfNodeP) *
+          tensProduct(m_nplus(pNodes, cCellsOfNodeP),
+                      m_nplus(pNodes, cCellsOfNodeP))) +
+         (m_lminus(pNodes, cCellsOfNodeP) *
+          tensProduct(m_nminus(pNodes, cCellsOfNodeP),
+                      m_nminus(pNodes, cCellsOfNodeP)));
 }
 /**
- * Job extrapolateValue called @2.0 in executeTimeLoopN method.
- * In variables: m_cell_velocity_n, , m_cell_coord, m_velocity_gradient,
- * m_pressure_gradient, p, spaceOrder Out variables: m_cell_velocity_extrap,
- * m_pressure_extrap, m_pressure_env_extrap
+ * bornes (ordre 2) des valeurs extrapolees aux coins du noeud pId : min et
+ * max des pressions par materiau et de la vitesse des mailles du noeud
  */
-void Eucclhyd::extrapolateValue() noexcept {
+KOKKOS_INLINE_FUNCTION
+void Eucclhyd::extrapolationBounds(const size_t pId,
+                                   BornesExtrapolation& bornes) {
+  for (int imat = 0; imat < nbmatmax; imat++) {
+    bornes.minP[imat] = numeric_limits<double>::max();
+    bornes.maxP[imat] = numeric_limits<double>::min();
+  }
+  for (int idim = 0; idim < dim; idim++) {
+    bornes.minV[idim] = numeric_limits<double>::max();
+    bornes.maxV[idim] = numeric_limits<double>::min();
+  }
+  auto cellsOfNodeP(mesh->getCellsOfNode(pId));
+  for (int dCellsOfNodeP = 0; dCellsOfNodeP < cellsOfNodeP.size();
+       dCellsOfNodeP++) {
+    int dCells(cellsOfNodeP[dCellsOfNodeP]);
+    for (int imat = 0; imat < nbmatmax; imat++) {
+      bornes.minP[imat] =
+          MathFunctions::min(bornes.minP[imat], m_pressure_env(dCells)[imat]);
+      bornes.maxP[imat] =
+          MathFunctions::max(bornes.maxP[imat], m_pressure_env(dCells)[imat]);
+    }
+    for (int idim = 0; idim < dim; idim++) {
+      bornes.minV[idim] = MathFunctions::min(bornes.minV[idim],
+                                             m_cell_velocity_n(dCells)[idim]);
+      bornes.maxV[idim] = MathFunctions::max(bornes.maxV[idim],
+                                             m_cell_velocity_n(dCells)[idim]);
+    }
+  }
+}
+/**
+ * pression, pressions par materiau et vitesse de la maille cCells
+ * extrapolees au noeud pNodes : valeurs de la maille a l'ordre 1, valeurs
+ * reconstruites puis bornees a l'ordre 2
+ */
+template <int NBMAT>
+KOKKOS_INLINE_FUNCTION void Eucclhyd::extrapolateCorner(
+    const int pNodes, const int cCells, const BornesExtrapolation& bornes,
+    double& ppc, RealArray1D<nbmatmax>& ppcEnv, RealArray1D<dim>& Vpc) {
+  constexpr int nbmat = NBMAT;
   if (options->spaceOrder == 1) {
-    Kokkos::parallel_for(
-        "extrapolateValue", nbCells, KOKKOS_LAMBDA(const int& cCells) {
-          int cId(cCells);
-          {
-            auto nodesOfCellC(mesh->getNodesOfCell(cId));
-            for (int pNodesOfCellC = 0; pNodesOfCellC < nodesOfCellC.size();
-                 pNodesOfCellC++) {
-              m_cell_velocity_extrap(cCells, pNodesOfCellC) =
-                  m_cell_velocity_n(cCells);
-              m_pressure_extrap(cCells, pNodesOfCellC) = m_pressure(cCells);
-              int nbmat = options->nbmat;
-              for (int imat = 0; imat < nbmat; imat++)
-                m_pressure_env_extrap(cCells, pNodesOfCellC)[imat] =
-                    m_pressure_env(cCells)[imat];
-            }
-          }
-        });
-  } else {
-    Kokkos::parallel_for(
-        "extrapolateValue", nbNodes, KOKKOS_LAMBDA(const int& pNodes) {
-          size_t pId(pNodes);
-          double reduction16 = numeric_limits<double>::max();
-          double reduction16a = numeric_limits<double>::max();
-          double reduction16b = numeric_limits<double>::max();
-          double reduction16c = numeric_limits<double>::max();
-          {
-            auto cellsOfNodeP(mesh->getCellsOfNode(pId));
-            for (int dCellsOfNodeP = 0; dCellsOfNodeP < cellsOfNodeP.size();
-                 dCellsOfNodeP++) {
-              int dId(cellsOfNodeP[dCellsOfNodeP]);
-              int dCells(dId);
-              reduction16 = MathFunctions::min(reduction16, m_pressure(dCells));
-              reduction16a =
-                  MathFunctions::min(reduction16a, m_pressure_env(dCells)[0]);
-              reduction16b =
-                  MathFunctions::min(reduction16b, m_pressure_env(dCells)[1]);
-              reduction16c =
-                  MathFunctions::min(reduction16c, m_pressure_env(dCells)[2]);
-            }
-          }
-          double minP = reduction16;
-          double minP1 = reduction16a;
-          double minP2 = reduction16b;
-          double minP3 = reduction16c;
-          double reduction17 = numeric_limits<double>::min();
-          double reduction17a = numeric_limits<double>::min();
-          double reduction17b = numeric_limits<double>::min();
-          double reduction17c = numeric_limits<double>::min();
-          {
-            auto cellsOfNodeP(mesh->getCellsOfNode(pId));
-            for (int dCellsOfNodeP = 0; dCellsOfNodeP < cellsOfNodeP.size();
-                 dCellsOfNodeP++) {
-              int dId(cellsOfNodeP[dCellsOfNodeP]);
-              int dCells(dId);
-              reduction17 = MathFunctions::max(reduction17, m_pressure(dCells));
-              reduction17a =
-                  MathFunctions::max(reduction17a, m_pressure_env(dCells)[0]);
-              reduction17b =
-                  MathFunctions::max(reduction17b, m_pressure_env(dCells)[1]);
-              reduction17c =
-                  MathFunctions::max(reduction17c, m_pressure_env(dCells)[2]);
-            }
-          }
-          double maxP = reduction17;
-          double maxP1 = reduction17a;
-          double maxP2 = reduction17b;
-          double maxP3 = reduction17c;
-          double reduction18 = numeric_limits<double>::max();
-          {
-            auto cellsOfNodeP(mesh->getCellsOfNode(pId));
-            for (int dCellsOfNodeP = 0; dCellsOfNodeP < cellsOfNodeP.size();
-                 dCellsOfNodeP++) {
-              int dId(cellsOfNodeP[dCellsOfNodeP]);
-              int dCells(dId);
-              reduction18 =
-                  MathFunctions::min(reduction18, m_cell_velocity_n(dCells)[0]);
-            }
-          }
-          double minVx = reduction18;
-          double reduction19 = numeric_limits<double>::min();
-          {
-            auto cellsOfNodeP(mesh->getCellsOfNode(pId));
-            for (int dCellsOfNodeP = 0; dCellsOfNodeP < cellsOfNodeP.size();
-                 dCellsOfNodeP++) {
-              int dId(cellsOfNodeP[dCellsOfNodeP]);
-              int dCells(dId);
-              reduction19 =
-                  MathFunctions::max(reduction19, m_cell_velocity_n(dCells)[0]);
-            }
-          }
-          double maxVx = reduction19;
-          double reduction20 = numeric_limits<double>::max();
-          {
-            auto cellsOfNodeP(mesh->getCellsOfNode(pId));
-            for (int dCellsOfNodeP = 0; dCellsOfNodeP < cellsOfNodeP.size();
-                 dCellsOfNodeP++) {
-              int dId(cellsOfNodeP[dCellsOfNodeP]);
-              int dCells(dId);
-              reduction20 =
-                  MathFunctions::min(reduction20, m_cell_velocity_n(dCells)[1]);
-            }
-          }
-          double minVy = reduction20;
-          double reduction21 = numeric_limits<double>::min();
-          {
-            auto cellsOfNodeP(mesh->getCellsOfNode(pId));
-            for (int dCellsOfNodeP = 0; dCellsOfNodeP < cellsOfNodeP.size();
-                 dCellsOfNodeP++) {
-              int dId(cellsOfNodeP[dCellsOfNodeP]);
-              int dCells(dId);
-              reduction21 =
-                  MathFunctions::max(reduction21, m_cell_velocity_n(dCells)[1]);
-            }
-          }
-          double maxVy = reduction21;
-          {
-            auto cellsOfNodeP(mesh->getCellsOfNode(pId));
-            for (int cCellsOfNodeP = 0; cCellsOfNodeP < cellsOfNodeP.size();
-                 cCellsOfNodeP++) {
-              int cId(cellsOfNodeP[cCellsOfNodeP]);
-              int cCells(cId);
-              int pNodesOfCellC(utils::indexOf(mesh->getNodesOfCell(cId), pId));
-
-              // double ptmp = m_pressure(cCells) +
-              // MathFunctions::dot(m_pressure_gradient(cCells),
-              // ArrayOperations::minus(m_node_coord(pNodes),
-              // m_cell_coord(cCells))); m_pressure_extrap(cCells,pNodesOfCellC)
-              // = MathFunctions::max(MathFunctions::min(maxP, ptmp), minP);
-
-              // pour chaque matériau,
-              double ptmp1 = m_pressure_env(cCells)[0] +
-                             dot(m_pressure_gradient_env(cCells, 0),
-                                 (m_node_coord(pNodes) - m_cell_coord(cCells)));
-              m_pressure_env_extrap(cCells, pNodesOfCellC)[0] =
-                  MathFunctions::max(MathFunctions::min(maxP1, ptmp1), minP1);
-              double ptmp2 = m_pressure_env(cCells)[1] +
-                             dot(m_pressure_gradient_env(cCells, 1),
-                                 (m_node_coord(pNodes) - m_cell_coord(cCells)));
-              m_pressure_env_extrap(cCells, pNodesOfCellC)[1] =
-                  MathFunctions::max(MathFunctions::min(maxP2, ptmp2), minP2);
-              double ptmp3 = m_pressure_env(cCells)[2] +
-                             dot(m_pressure_gradient_env(cCells, 2),
-                                 (m_node_coord(pNodes) - m_cell_coord(cCells)));
-              m_pressure_env_extrap(cCells, pNodesOfCellC)[2] =
-                  MathFunctions::max(MathFunctions::min(maxP3, ptmp3), minP3);
-
-              m_pressure_extrap(cCells, pNodesOfCellC) = 0.;
-              int nbmat = options->nbmat;
-              // et on recalcule la moyenne
-              for (int imat = 0; imat < nbmat; imat++)
-                m_pressure_extrap(cCells, pNodesOfCellC) +=
-                    m_fracvol_env(cCells)[imat] *
-                    m_pressure_env_extrap(cCells, pNodesOfCellC)[imat];
-
-              RealArray1D<dim> Vtmp =
-                  m_cell_velocity_n(cCells) +
-                  MathFunctions::matVectProduct(
-                      m_velocity_gradient(cCells),
+    Vpc = m_cell_velocity_n(cCells);
+    ppc = m_pressure(cCells);
+    for (int imat = 0; imat < nbmat; imat++)
+      ppcEnv[imat] = m_pressure_env(cCells)[imat];
+    return;
+  }
+  // pour chaque matériau,
+  for (int imat = 0; imat < nbmatmax; imat++) {
+    double ptmp = m_pressure_env(cCells)[imat] +
+                  dot(m_pressure_gradient_env(cCells, imat),
                       (m_node_coord(pNodes) - m_cell_coord(cCells)));
-              m_cell_velocity_extrap(cCells, pNodesOfCellC)[0] =
-                  std::max(MathFunctions::min(maxVx, Vtmp[0]), minVx);
-              m_cell_velocity_extrap(cCells, pNodesOfCellC)[1] =
-                  std::max(MathFunctions::min(maxVy, Vtmp[1]), minVy);
-            }
-          }
-        });
+    ppcEnv[imat] = MathFunctions::max(
+        MathFunctions::min(bornes.maxP[imat], ptmp), bornes.minP[imat]);
   }
+  ppc = 0.;
+  // et on recalcule la moyenne
+  for (int imat = 0; imat < nbmat; imat++)
+    ppc += m_fracvol_env(cCells)[imat] * ppcEnv[imat];
+
+  RealArray1D<dim> Vtmp = m_cell_velocity_n(cCells) +
+                          MathFunctions::matVectProduct(
+                              m_velocity_gradient(cCells),
+                              (m_node_coord(pNodes) - m_cell_coord(cCells)));
+  for (int idim = 0; idim < dim; idim++)
+    Vpc[idim] = std::max(MathFunctions::min(bornes.maxV[idim], Vtmp[idim]),
+                         bornes.minV[idim]);
 }
 /**
- * Job computeG called @3.0 in executeTimeLoopN method.
- * In variables: M, m_cell_velocity_extrap, m_lpc, m_pressure_extrap
- * Out variables: G
+ * force du materiau imat au coin de la maille cCells, deltaV etant la vitesse
+ * du noeud moins la vitesse extrapolee au coin
  */
-void Eucclhyd::computeG() noexcept {
-  Kokkos::parallel_for("computeG", nbNodes, KOKKOS_LAMBDA(const int& pNodes) {
-    size_t pId(pNodes);
-    RealArray1D<dim> reduction1 = zeroVect;
-    {
-      auto cellsOfNodeP(mesh->getCellsOfNode(pId));
-      for (int cCellsOfNodeP = 0; cCellsOfNodeP < cellsOfNodeP.size();
-           cCellsOfNodeP++) {
-        int cId(cellsOfNodeP[cCellsOfNodeP]);
-        int cCells(cId);
-        int pNodesOfCellC(utils::indexOf(mesh->getNodesOfCell(cId), pId));
-        reduction1 =
-            reduction1 + (MathFunctions::matVectProduct(
-                              m_dissipation_matrix(pNodes, cCellsOfNodeP),
-                              m_cell_velocity_extrap(cCells, pNodesOfCellC)) +
-                          (m_pressure_extrap(cCells, pNodesOfCellC) *
-                           m_lpc(pNodes, cCellsOfNodeP)));
-      }
-    }
-    m_node_G(pNodes) = reduction1;
-  });
+KOKKOS_INLINE_FUNCTION
+RealArray1D<dim> Eucclhyd::cornerForceEnv(const int cCells, const int imat,
+                                          const double ppcEnv,
+                                          const RealArray1D<dim>& lpc,
+                                          const RealArray2D<dim, dim>& cornerM,
+                                          const RealArray1D<dim>& deltaV) {
+  return (-ppcEnv * lpc) +
+         MathFunctions::matVectProduct(m_density_env_n(cCells)[imat] *
+                                           m_speed_velocity(cCells) * cornerM,
+                                       deltaV);
 }
-
 /**
- * Job computeNodeDissipationMatrixAndG called @3.0 in executeTimeLoopN method.
- * In variables: M
- * Out variables: m_node_dissipation
+ * Job computeCornerForces called @4.0 in executeTimeLoopN method.
+ * In variables: c, m_lminus, m_lplus, m_nminus, m_nplus, m_lpc, m_density_n,
+ * m_density_env_n, p, m_pressure_env, m_fracvol_env, m_cell_velocity_n,
+ * m_velocity_gradient, m_pressure_gradient_env, m_node_coord, m_cell_coord,
+ * m_node_boundary, bottomBC, bottomBCValue, leftBC, leftBCValue, rightBC,
+ * rightBCValue, topBC, topBCValue, spaceOrder
+ * Out variables: m_node_velocity_nplus1, m_node_force_nplus1,
+ * m_node_force_env_nplus1
+ * un seul parcours des noeuds : matrices de dissipation et valeurs
+ * extrapolees aux coins, G et matrice du noeud, vitesse du noeud puis forces
+ * aux coins. Les grandeurs aux coins restent locales au noeud, seules la
+ * vitesse et les forces lues par la mise a jour des mailles sont stockees.
  */
-void Eucclhyd::computeNodeDissipationMatrixAndG() noexcept {
-  Kokkos::parallel_for(
-      "computeNodeDissipationMatrixAndG", nbNodes,
-      KOKKOS_LAMBDA(const int& pNodes) {
-        int pId(pNodes);
+template <int NBMAT>
+void Eucclhyd::computeCornerForces() noexcept {
+  // conditions aux limites rangees selon CartesianMesh2D::Direction
+  const int BC[4] = {cdl->bottomBC, cdl->leftBC, cdl->rightBC, cdl->topBC};
+  const RealArray1D<dim> BCValue[4] = {cdl->bottomBCValue, cdl->leftBCValue,
+                                       cdl->rightBCValue, cdl->topBCValue};
+  const bool ordre1(options->spaceOrder == 1);
+  const bool forcesEnvStockees(!options->forcesMateriauxRecalculees);
+  const int nbmatEnv(options->nbmat);
+  mesh->parallelForNodes(
+      "computeCornerForces", KOKKOS_LAMBDA(const int& pNodes) {
+        size_t pId(pNodes);
+        auto cellsOfNodeP(mesh->getCellsOfNode(pId));
+        BornesExtrapolation bornes;
+        if (!ordre1) extrapolationBounds(pId, bornes);
+        // grandeurs aux coins du noeud
+        RealArray2D<dim, dim> cornerM[CartesianMesh2D::MaxNbCellsOfNode];
+        RealArray2D<dim, dim> Mpc[CartesianMesh2D::MaxNbCellsOfNode];
+        RealArray1D<dim> Vpc[CartesianMesh2D::MaxNbCellsOfNode];
+        double ppc[CartesianMesh2D::MaxNbCellsOfNode];
+        RealArray1D<nbmatmax> ppcEnv[CartesianMesh2D::MaxNbCellsOfNode];
         RealArray2D<dim, dim> reduction0 = zeroMat;
-        {
-          auto cellsOfNodeP(mesh->getCellsOfNode(pId));
-          for (int cCellsOfNodeP = 0; cCellsOfNodeP < cellsOfNodeP.size();
-               cCellsOfNodeP++) {
-            reduction0 =
-                reduction0 + (m_dissipation_matrix(pNodes, cCellsOfNodeP));
-          }
+        RealArray1D<dim> reduction1 = zeroVect;
+        for (int cCellsOfNodeP = 0; cCellsOfNodeP < cellsOfNodeP.size();
+             cCellsOfNodeP++) {
+          int cId(cellsOfNodeP[cCellsOfNodeP]);
+          int cCells(cId);
+          const int k(cCellsOfNodeP);
+          cornerM[k] = cornerMatrix(pNodes, cCellsOfNodeP);
+          Mpc[k] = m_density_n(cCells) * m_speed_velocity(cCells) * cornerM[k];
+          extrapolateCorner<NBMAT>(pNodes, cCells, bornes, ppc[k], ppcEnv[k],
+                                   Vpc[k]);
+          reduction0 = reduction0 + (Mpc[k]);
+          reduction1 = reduction1 + (MathFunctions::matVectProduct(
+                                         Mpc[k], Vpc[k]) +
+                                     (ppc[k] * m_lpc(pNodes, cCellsOfNodeP)));
+        }
+        const RealArray1D<dim> Vp(
+            nodeVelocity(pNodes, BC, BCValue, reduction0, reduction1));
+        m_node_velocity_nplus1(pNodes) = Vp;
+
+        for (int cCellsOfNodeP = 0; cCellsOfNodeP < cellsOfNodeP.size();
+             cCellsOfNodeP++) {
+          int cId(cellsOfNodeP[cCellsOfNodeP]);
+          int cCells(cId);
+          const int k(cCellsOfNodeP);
+          m_node_force_nplus1(pNodes, cCellsOfNodeP) =
+              (-ppc[k] * m_lpc(pNodes, cCellsOfNodeP)) +
+              MathFunctions::matVectProduct(Mpc[k], (Vp - Vpc[k]));
+
+          if (forcesEnvStockees)
+            for (int imat = 0; imat < nbmatEnv; ++imat)
+              m_node_force_env_nplus1(pNodes, cCellsOfNodeP, imat) =
+                  cornerForceEnv(cCells, imat, ppcEnv[k][imat],
+                                 m_lpc(pNodes, cCellsOfNodeP), cornerM[k],
+                                 Vp - Vpc[k]);
         }
-        m_node_dissipation(pNodes) = reduction0;
       });
 }
-/**
- * Job computeNodeVelocity called @4.0 in executeTimeLoopN method.
- * In variables: G, m_node_dissipation
- * Out variables: m_node_velocity_nplus1
- */
-void Eucclhyd::computeNodeVelocity() noexcept {
-  auto innerNodes(mesh->getInnerNodes());
-  int nbInnerNodes(mesh->getNbInnerNodes());
-  Kokkos::parallel_for(
-      "computeNodeVelocity", nbInnerNodes,
-      KOKKOS_LAMBDA(const int& pInnerNodes) {
-        int pId(innerNodes[pInnerNodes]);
-        int pNodes(pId);
-        m_node_velocity_nplus1(pNodes) = MathFunctions::matVectProduct(
-            inverse(m_node_dissipation(pNodes)), m_node_G(pNodes));
-      });
+void Eucclhyd::computeCornerForces() noexcept {
+  dispatchNbMat(options->nbmat, [this](auto nbmat) {
+    computeCornerForces<decltype(nbmat)::value>();
+  });
 }
 /**
  * Job computeFaceVelocity called @5.0 in executeTimeLoopN method.
@@ -551,7 +517,6 @@ void Eucclhyd::computeFaceVelocity() noexcept {
             dot((0.5 * reduction5), varlp->faceNormal(fFaces));
       });
 }
-
 /**
  * Job computeLagrangePosition called @5.0 in executeTimeLoopN method.
  * In variables: m_node_velocity_nplus1, m_node_coord, deltat_n
@@ -564,147 +529,55 @@ void Eucclhyd::computeLagrangePosition() noexcept {
                              m_node_coord(pNodes) +
                              m_node_velocity_nplus1(pNodes) * gt->deltat_n;
                        });
-  auto faces(mesh->getFaces());
-  Kokkos::parallel_for(
-      "computeLagrangePosition", nbFaces, KOKKOS_LAMBDA(const int& fFaces) {
-        int fId(faces[fFaces]);
-        int n1FirstNodeOfFaceF(mesh->getFirstNodeOfFace(fId));
-        int n1Id(n1FirstNodeOfFaceF);
-        int n1Nodes(n1Id);
-        int n2SecondNodeOfFaceF(mesh->getSecondNodeOfFace(fId));
-        int n2Id(n2SecondNodeOfFaceF);
-        int n2Nodes(n2Id);
-        RealArray1D<dim> X_face =
-            0.5 * (varlp->XLagrange(n1Nodes) + varlp->XLagrange(n2Nodes));
-        RealArray1D<dim> face_vec =
-            varlp->XLagrange(n2Nodes) - varlp->XLagrange(n1Nodes);
-        varlp->XfLagrange(fFaces) = X_face;
-        varlp->faceLengthLagrange(fFaces) = MathFunctions::norm(face_vec);
-      });
-  if (options->AvecProjection == 0) {
-    Kokkos::parallel_for(
-        "computeLagrangePosition", nbCells, KOKKOS_LAMBDA(const int& cCells) {
-          int cId(cCells);
-          double reduction13 = 0.0;
-          {
-            auto nodesOfCellC(mesh->getNodesOfCell(cId));
-            for (int pNodesOfCellC = 0; pNodesOfCellC < nodesOfCellC.size();
-                 pNodesOfCellC++) {
-              int pId(nodesOfCellC[pNodesOfCellC]);
-              int pPlus1Id(nodesOfCellC[(pNodesOfCellC + 1 + nbNodesOfCell) %
-                                        nbNodesOfCell]);
-              int pNodes(pId);
-              int pPlus1Nodes(pPlus1Id);
-              reduction13 = reduction13 +
-                            (MathFunctions::norm(m_node_coord(pNodes) -
-                                                 m_node_coord(pPlus1Nodes)));
-            }
-          }
-          m_cell_perimeter(cCells) = reduction13;
-        });
-  }
 }
 
 /**
- * Job computeSubCellForce called @5.0 in executeTimeLoopN method.
- * In variables: M, m_cell_velocity_extrap, m_node_velocity_nplus1, m_lpc,
- * m_pressure_extrap Out variables: m_node_force_nplus1
+ * Job computeLagrangeGeometry called @6.0 in executeTimeLoopN method.
+ * Les 4 noeuds de chaque maille sont lus une seule fois pour le volume, le
+ * centre de gravite et les faces de la maille. Chaque face est ecrite par
+ * une seule maille : faces du bas et de gauche, plus celles de droite et du
+ * haut au bord du domaine.
+ * In variables: XLagrange, m_fracvol_env, m_node_coord
+ * Out variables: vLagrange, m_lagrange_volume, XcLagrange, XfLagrange,
+ * faceLengthLagrange, m_cell_perimeter
  */
-void Eucclhyd::computeSubCellForce() noexcept {
+template <int NBMAT>
+void Eucclhyd::computeLagrangeGeometry() noexcept {
+  const bool avecPerimetre(options->AvecProjection == 0);
   Kokkos::parallel_for(
-      "computeSubCellForce", nbNodes, KOKKOS_LAMBDA(const int& pNodes) {
-        size_t pId(pNodes);
-        {
-          auto cellsOfNodeP(mesh->getCellsOfNode(pId));
-          for (int cCellsOfNodeP = 0; cCellsOfNodeP < cellsOfNodeP.size();
-               cCellsOfNodeP++) {
-            int cId(cellsOfNodeP[cCellsOfNodeP]);
-            int cCells(cId);
-            int pNodesOfCellC(utils::indexOf(mesh->getNodesOfCell(cId), pId));
-            m_node_force_nplus1(pNodes, cCellsOfNodeP) =
-                (-m_pressure_extrap(cCells, pNodesOfCellC) *
-                 m_lpc(pNodes, cCellsOfNodeP)) +
-                MathFunctions::matVectProduct(
-                    m_dissipation_matrix(pNodes, cCellsOfNodeP),
-                    (m_node_velocity_nplus1(pNodes) -
-                     m_cell_velocity_extrap(cCells, pNodesOfCellC)));
-
-            m_node_force_env_nplus1(pNodes, cCellsOfNodeP, 0) =
-                (-m_pressure_env_extrap(cCells, pNodesOfCellC)[0] *
-                 m_lpc(pNodes, cCellsOfNodeP)) +
-                MathFunctions::matVectProduct(
-                    m_dissipation_matrix_env(pNodes, cCellsOfNodeP, 0),
-                    m_node_velocity_nplus1(pNodes) -
-                        m_cell_velocity_extrap(cCells, pNodesOfCellC));
-
-            m_node_force_env_nplus1(pNodes, cCellsOfNodeP, 1) =
-                (-m_pressure_env_extrap(cCells, pNodesOfCellC)[1] *
-                 m_lpc(pNodes, cCellsOfNodeP)) +
-                MathFunctions::matVectProduct(
-                    m_dissipation_matrix_env(pNodes, cCellsOfNodeP, 1),
-                    m_node_velocity_nplus1(pNodes) -
-                        m_cell_velocity_extrap(cCells, pNodesOfCellC));
-
-            m_node_force_env_nplus1(pNodes, cCellsOfNodeP, 2) =
-                (-m_pressure_env_extrap(cCells, pNodesOfCellC)[2] *
-                 m_lpc(pNodes, cCellsOfNodeP)) +
-                MathFunctions::matVectProduct(
-                    m_dissipation_matrix_env(pNodes, cCellsOfNodeP, 2),
-                    m_node_velocity_nplus1(pNodes) -
-                        m_cell_velocity_extrap(cCells, pNodesOfCellC));
-          }
-        }
-      });
-}
-/**
- * Job computeLagrangeVolumeAndCenterOfGravity called @6.0 in executeTimeLoopN
- * method. In variables: XLagrange Out variables: XcLagrange, vLagrange
- */
-void Eucclhyd::computeLagrangeVolumeAndCenterOfGravity() noexcept {
-  Kokkos::parallel_for(
-      "computeLagrangeVolumeAndCenterOfGravity", nbCells,
-      KOKKOS_LAMBDA(const int& cCells) {
+      "computeLagrangeGeometry", nbCells, KOKKOS_LAMBDA(const int& cCells) {
         int cId(cCells);
-        double reduction6 = 0.0;
-        {
-          auto nodesOfCellC(mesh->getNodesOfCell(cId));
-          for (int pNodesOfCellC = 0; pNodesOfCellC < nodesOfCellC.size();
-               pNodesOfCellC++) {
-            int pId(nodesOfCellC[pNodesOfCellC]);
-            int pPlus1Id(nodesOfCellC[(pNodesOfCellC + 1 + nbNodesOfCell) %
-                                      nbNodesOfCell]);
-            int pNodes(pId);
-            int pPlus1Nodes(pPlus1Id);
-            reduction6 =
-                reduction6 + (crossProduct2d(varlp->XLagrange(pNodes),
-                                             varlp->XLagrange(pPlus1Nodes)));
-          }
-        }
-        double vol = 0.5 * reduction6;
+        const auto nodesOfCellC(mesh->getNodesOfCell(cId));
+        const geometrielib::GeometrieMaille geom(varlp->XLagrange,
+                                                 nodesOfCellC);
+        const double vol = geom.volume();
         varlp->vLagrange(cCells) = vol;
-        int nbmat = options->nbmat;
+        constexpr int nbmat = NBMAT;
         for (int imat = 0; imat < nbmat; imat++)
           m_lagrange_volume(cCells)[imat] = m_fracvol_env(cCells)[imat] * vol;
-        RealArray1D<dim> reduction7 = zeroVect;
-        {
-          auto nodesOfCellC(mesh->getNodesOfCell(cId));
-          for (int pNodesOfCellC = 0; pNodesOfCellC < nodesOfCellC.size();
-               pNodesOfCellC++) {
-            int pId(nodesOfCellC[pNodesOfCellC]);
-            int pPlus1Id(nodesOfCellC[(pNodesOfCellC + 1 + nbNodesOfCell) %
-                                      nbNodesOfCell]);
-            int pNodes(pId);
-            int pPlus1Nodes(pPlus1Id);
-            reduction7 =
-                reduction7 +
-                (crossProduct2d(varlp->XLagrange(pNodes),
-                                varlp->XLagrange(pPlus1Nodes)) *
-                 (varlp->XLagrange(pNodes) + varlp->XLagrange(pPlus1Nodes)));
+        varlp->XcLagrange(cCells) = geom.centreGravite(vol);
+        const auto facesOfCellC(mesh->getFacesOfCell(cId));
+        for (int p = 0; p < geometrielib::GeometrieMaille::nbNoeuds; p++) {
+          const CartesianMesh2D::Direction d(
+              geometrielib::GeometrieMaille::faceArete(p));
+          if (d == CartesianMesh2D::Bottom || d == CartesianMesh2D::Left ||
+              mesh->isBoundaryCell(cId, d)) {
+            const int fFaces(facesOfCellC[d]);
+            varlp->XfLagrange(fFaces) = geom.milieuArete(p);
+            varlp->faceLengthLagrange(fFaces) = geom.longueurArete(p);
           }
         }
-        varlp->XcLagrange(cCells) = (1.0 / (6.0 * vol) * reduction7);
+        if (avecPerimetre)
+          m_cell_perimeter(cCells) =
+              geometrielib::GeometrieMaille(m_node_coord, nodesOfCellC)
+                  .perimetre();
       });
 }
+void Eucclhyd::computeLagrangeGeometry() noexcept {
+  dispatchNbMat(options->nbmat, [this](auto nbmat) {
+    computeLagrangeGeometry<decltype(nbmat)::value>();
+  });
+}
 /**
  * Job computeFacedeltaxLagrange called @7.0 in executeTimeLoopN method.
  * In variables: XcLagrange, faceNormal
@@ -736,10 +609,19 @@ void Eucclhyd::computeFacedeltaxLagrange() noexcept {
  * m_node_velocity_nplus1, deltat_n, m_internal_energy_n, m_lpc, m, m_density_n,
  * vLagrange Out variables: ULagrange
  */
+template <int NBMAT>
 void Eucclhyd::updateCellCenteredLagrangeVariables() noexcept {
-  Kokkos::parallel_for(
+  // bilan de conservation cumule dans le meme noyau, sans tableau aux mailles
+  const bool avecBilan(n % options->frequenceBilan == 0);
+  const bool ordre1(options->spaceOrder == 1);
+  const bool forcesEnvStockees(!options->forcesMateriauxRecalculees);
+  // somme par maille des forces par materiau pour le gradient d'ordre 2
+  const bool sommeForcesEnv(m_cell_force_env.extent(0) > 0);
+  conservationlib::Bilan bilan;
+  conservationlib::ReducteurBilan reducer(bilan);
+  Kokkos::parallel_reduce(
       "updateCellCenteredLagrangeVariables", nbCells,
-      KOKKOS_LAMBDA(const int& cCells) {
+      KOKKOS_LAMBDA(const int& cCells, conservationlib::Bilan& x) {
         size_t cId(cCells);
         double reduction2 = 0.0;
         {
@@ -777,6 +659,9 @@ void Eucclhyd::updateCellCenteredLagrangeVariables() noexcept {
 
         double reduction4 = 0.0;
         RealArray1D<nbmatmax> preduction4 = zeroVectmat;
+        RealArray1D<dim> reductionForceEnv[nbmatmax];
+        for (int imat = 0; imat < NBMAT; ++imat)
+          reductionForceEnv[imat] = zeroVect;
         {
           auto nodesOfCellC(mesh->getNodesOfCell(cId));
           for (int pNodesOfCellC = 0; pNodesOfCellC < nodesOfCellC.size();
@@ -789,25 +674,45 @@ void Eucclhyd::updateCellCenteredLagrangeVariables() noexcept {
                 (dot(m_node_force_nplus1(pNodes, cCellsOfNodeP),
                      (m_node_velocity_nplus1(pNodes) -
                       (0.5 * (m_cell_velocity_n(cCells) + cell_velocity_L)))));
-            preduction4[0] =
-                preduction4[0] +
-                (dot(m_node_force_env_nplus1(pNodes, cCellsOfNodeP, 0),
-                     (m_node_velocity_nplus1(pNodes) -
-                      (0.5 * (m_cell_velocity_n(cCells) + cell_velocity_L)))));
-            preduction4[1] =
-                preduction4[1] +
-                (dot(m_node_force_env_nplus1(pNodes, cCellsOfNodeP, 1),
-                     (m_node_velocity_nplus1(pNodes) -
-                      (0.5 * (m_cell_velocity_n(cCells) + cell_velocity_L)))));
-            preduction4[2] =
-                preduction4[2] +
-                (dot(m_node_force_env_nplus1(pNodes, cCellsOfNodeP, 2),
-                     (m_node_velocity_nplus1(pNodes) -
-                      (0.5 * (m_cell_velocity_n(cCells) + cell_velocity_L)))));
+            RealArray1D<dim> forceEnv[nbmatmax];
+            if (forcesEnvStockees) {
+              for (int imat = 0; imat < NBMAT; ++imat)
+                forceEnv[imat] =
+                    m_node_force_env_nplus1(pNodes, cCellsOfNodeP, imat);
+            } else {
+              // memes calculs que computeCornerForces pour ce coin
+              BornesExtrapolation bornes;
+              if (!ordre1) extrapolationBounds(pId, bornes);
+              double ppc;
+              RealArray1D<nbmatmax> ppcEnv;
+              RealArray1D<dim> Vpc;
+              extrapolateCorner<NBMAT>(pNodes, cCells, bornes, ppc, ppcEnv,
+                                       Vpc);
+              const RealArray2D<dim, dim> cornerM(
+                  cornerMatrix(pNodes, cCellsOfNodeP));
+              for (int imat = 0; imat < NBMAT; ++imat)
+                forceEnv[imat] = cornerForceEnv(
+                    cCells, imat, ppcEnv[imat], m_lpc(pNodes, cCellsOfNodeP),
+                    cornerM, m_node_velocity_nplus1(pNodes) - Vpc);
+            }
+            for (int imat = 0; imat < NBMAT; ++imat) {
+              preduction4[imat] =
+                  preduction4[imat] +
+                  (dot(forceEnv[imat],
+                       (m_node_velocity_nplus1(pNodes) -
+                        (0.5 *
+                         (m_cell_velocity_n(cCells) + cell_velocity_L)))));
+              if (sommeForcesEnv)
+                reductionForceEnv[imat] =
+                    reductionForceEnv[imat] + forceEnv[imat];
+            }
           }
         }
+        if (sommeForcesEnv)
+          for (int imat = 0; imat < NBMAT; ++imat)
+            m_cell_force_env(cCells, imat) = reductionForceEnv[imat];
 
-        int nbmat = options->nbmat;
+        constexpr int nbmat = NBMAT;
         double eLagrange = m_internal_energy_n(cCells) +
                            gt->deltat_n / m_cell_mass(cCells) * reduction4;
 
@@ -990,39 +895,35 @@ void Eucclhyd::updateCellCenteredLagrangeVariables() noexcept {
         }
 #endif
 
-        // m_total_energy_L(cCells) = (rhoLagrange * vLagrange(cCells)) *
-        // (eLagrange + 0.5 * (cell_velocity_L[0] * cell_velocity_L[0] +
-        // cell_velocity_L[1] * cell_velocity_L[1]));
-        m_global_masse_L(cCells) = 0.;
-        m_total_energy_L(cCells) =
-            (rhoLagrange * varlp->vLagrange(cCells)) *
-            (m_mass_fraction_env(cCells)[0] * peLagrange[0] +
-             m_mass_fraction_env(cCells)[1] * peLagrange[1] +
-             m_mass_fraction_env(cCells)[2] * peLagrange[2] +
-             0.5 * (cell_velocity_L[0] * cell_velocity_L[0] +
-                    cell_velocity_L[1] * cell_velocity_L[1]));
-        for (int imat = 0; imat < nbmat; imat++) {
-          m_global_masse_L(cCells) += m_mass_fraction_env(cCells)[imat] *
-                                      (rhoLagrange * varlp->vLagrange(cCells));
+        if (avecBilan) {
+          const double masse(rhoLagrange * varlp->vLagrange(cCells));
+          x.energie +=
+              masse * (m_mass_fraction_env(cCells)[0] * peLagrange[0] +
+                       m_mass_fraction_env(cCells)[1] * peLagrange[1] +
+                       m_mass_fraction_env(cCells)[2] * peLagrange[2] +
+                       0.5 * (cell_velocity_L[0] * cell_velocity_L[0] +
+                              cell_velocity_L[1] * cell_velocity_L[1]));
+          double masseCell(0.);
+          for (int imat = 0; imat < nbmat; imat++) {
+            const double masseEnv(m_mass_fraction_env(cCells)[imat] * masse);
+            masseCell += masseEnv;
+            x.masseEnv[imat] += masseEnv;
+          }
+          x.masse += masseCell;
         }
-      });
-  double reductionE(0.), reductionM(0.);
-  {
-    Kokkos::Sum<double> reducerE(reductionE);
-    Kokkos::parallel_reduce("reductionE", nbCells,
-                            KOKKOS_LAMBDA(const int& cCells, double& x) {
-                              reducerE.join(x, m_total_energy_L(cCells));
-                            },
-                            reducerE);
-    Kokkos::Sum<double> reducerM(reductionM);
-    Kokkos::parallel_reduce("reductionM", nbCells,
-                            KOKKOS_LAMBDA(const int& cCells, double& x) {
-                              reducerM.join(x, m_global_masse_L(cCells));
-                            },
-                            reducerM);
+      },
+      reducer);
+  if (avecBilan) {
+    m_global_total_energy_L = bilan.energie;
+    m_total_masse_L = bilan.masse;
+    for (int imat = 0; imat < nbmatmax; imat++)
+      m_total_masse_env_L[imat] = bilan.masseEnv[imat];
   }
-  m_global_total_energy_L = reductionE;
-  m_total_masse_L = reductionM;
+}
+void Eucclhyd::updateCellCenteredLagrangeVariables() noexcept {
+  dispatchNbMat(options->nbmat, [this](auto nbmat) {
+    updateCellCenteredLagrangeVariables<decltype(nbmat)::value>();
+  });
 }
 void Eucclhyd::switchalpharho_rho() noexcept {
   Kokkos::parallel_for(
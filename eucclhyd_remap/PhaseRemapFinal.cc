@@ -9,18 +9,87 @@
 #include "types/MathFunctions.h"  // for max, min
 #include "types/MultiArray.h"     // for operator<<
 
+/**
+ * Fractions volumiques projetees d'une maille : volumes partiels normalises
+ * par le volume euler, fractions sous le seuil annulees.
+ * In variables: Uremap2, m_euler_volume
+ */
+template <int NBMAT>
+KOKKOS_INLINE_FUNCTION RealArray1D<nbmatmax> Eucclhyd::computeRemapFracvol(
+    const int cCells) const noexcept {
+  constexpr int nbmat = NBMAT;
+  double vol = m_euler_volume(cCells);  // volume euler
+  double volt = 0.;
+  RealArray1D<nbmatmax> vol_np1;
+  for (int imat = 0; imat < nbmat; imat++) {
+    vol_np1[imat] = varlp->Uremap2(cCells)[imat];
+    volt += vol_np1[imat];
+  }
+  double volt_normalise = 0.;
+  // normalisation des volumes + somme
+  for (int imat = 0; imat < nbmat; imat++) {
+    vol_np1[imat] *= vol / volt;
+    volt_normalise += vol_np1[imat];
+  }
+  RealArray1D<nbmatmax> fracvol = zeroVectmat;
+  double somme_frac = 0.;
+  for (int imat = 0; imat < nbmat; imat++) {
+    fracvol[imat] = vol_np1[imat] / volt_normalise;
+    if (fracvol[imat] < options->threshold) fracvol[imat] = 0.;
+    somme_frac += fracvol[imat];
+  }
+  for (int imat = 0; imat < nbmat; imat++)
+    fracvol[imat] = fracvol[imat] / somme_frac;
+  return fracvol;
+}
+/**
+ * Classement des mailles apres projection : indicateurs mixte et pure de la
+ * projection et materiau unique de la maille pour la repartition des
+ * grandeurs par materiau.
+ * In variables: Uremap2
+ * Out variables: mixte, pure, layout.cellMaterial
+ */
+template <int NBMAT>
+void Eucclhyd::classifyRemapCells() noexcept {
+  Kokkos::parallel_for(
+      "classifyRemapCells", nbCells, KOKKOS_LAMBDA(const int& cCells) {
+        const RealArray1D<nbmatmax> fracvol(
+            computeRemapFracvol<NBMAT>(cCells));
+        int matcell(0);
+        int imatpure(-1);
+        for (int imat = 0; imat < NBMAT; imat++)
+          if (fracvol[imat] > 0.) {
+            matcell++;
+            imatpure = imat;
+          }
+        if (matcell > 1) {
+          varlp->mixte(cCells) = 1;
+          varlp->pure(cCells) = -1;
+        } else {
+          varlp->mixte(cCells) = 0;
+          varlp->pure(cCells) = imatpure;
+        }
+        // une maille sans materiau est rangee avec les mailles mixtes
+        varlp->layout.cellMaterial(cCells) = (matcell == 1 ? imatpure : -1);
+      });
+}
 /**
  * Job remapCellcenteredVariable called @16.0 in executeTimeLoopN method.
  * In variables: Uremap2, v, x_then_y_n
  * Out variables: m_cell_velocity_nplus1, m_internal_energy_nplus1,
  * m_density_nplus1, x_then_y_nplus1
  */
+template <int NBMAT>
 void Eucclhyd::remapCellcenteredVariable() noexcept {
-  m_global_total_energy_T = 0.;
   varlp->x_then_y_nplus1 = !(varlp->x_then_y_n);
-  int nbmat = options->nbmat;
-  Kokkos::parallel_for(
-      "remapCellcenteredVariable", nbCells, KOKKOS_LAMBDA(const int& cCells) {
+  constexpr int nbmat = NBMAT;
+  // bilan de conservation cumule dans le meme noyau, sans tableau aux mailles
+  const bool avecBilan(n % options->frequenceBilan == 0);
+  conservationlib::Bilan bilan;
+  conservationlib::ReducteurBilan reducer(bilan);
+  Kokkos::parallel_reduce(
+      "remapCellcenteredVariable", nbCells,
+      KOKKOS_LAMBDA(const int& cCells, conservationlib::Bilan& x) {
         double vol = m_euler_volume(cCells);  // volume euler
         double volt = 0.;
         double masset = 0.;
@@ -38,31 +107,10 @@ void Eucclhyd::remapCellcenteredVariable() noexcept {
           vol_np1[imat] *= vol / volt;
           volt_normalise += vol_np1[imat];
         }
-        double somme_frac = 0.;
-        for (int imat = 0; imat < nbmat; imat++) {
-          m_fracvol_env(cCells)[imat] = vol_np1[imat] / volt_normalise;
-          if (m_fracvol_env(cCells)[imat] < options->threshold)
-            m_fracvol_env(cCells)[imat] = 0.;
-          somme_frac += m_fracvol_env(cCells)[imat];
-        }
-        for (int imat = 0; imat < nbmat; imat++)
-          m_fracvol_env(cCells)[imat] =
-              m_fracvol_env(cCells)[imat] / somme_frac;
-
-        int matcell(0);
-        int imatpure(-1);
+        const RealArray1D<nbmatmax> fracvol(
+            computeRemapFracvol<NBMAT>(cCells));
         for (int imat = 0; imat < nbmat; imat++)
-          if (m_fracvol_env(cCells)[imat] > 0.) {
-            matcell++;
-            imatpure = imat;
-          }
-        if (matcell > 1) {
-          varlp->mixte(cCells) = 1;
-          varlp->pure(cCells) = -1;
-        } else {
-          varlp->mixte(cCells) = 0;
-          varlp->pure(cCells) = imatpure;
-        }
+          m_fracvol_env(cCells)[imat] = fracvol[imat];
         // -----
         for (int imat = 0; imat < nbmat; imat++)
           m_mass_fraction_env(cCells)[imat] =
@@ -135,19 +183,21 @@ void Eucclhyd::remapCellcenteredVariable() noexcept {
               m_internal_energy_env_nplus1(cCells)[imat];
         }
 
-        m_total_energy_T(cCells) =
-            (m_density_np1 * vol) * m_internal_energy_nplus1(cCells) +
-            0.5 * (m_density_np1 * vol) *
-                (m_cell_velocity_np1[0] * m_cell_velocity_np1[0] +
-                 m_cell_velocity_np1[1] * m_cell_velocity_np1[1]);
-        m_global_masse_T(cCells) = 0.;
-        for (int imat = 0; imat < nbmat; imat++)
-          m_global_masse_T(cCells) +=
-              m_density_env_nplus1(cCells)[imat] *
-              vol_np1[imat];  // m_mass_fraction_env(cCells)[imat] *
-                              // (m_density_np1 * vol) ; //
-                              // m_density_env_nplus1(cCells)[imat] *
-                              // vol_np1[imat];
+        if (avecBilan) {
+          x.energie +=
+              (m_density_np1 * vol) * m_internal_energy_nplus1(cCells) +
+              0.5 * (m_density_np1 * vol) *
+                  (m_cell_velocity_np1[0] * m_cell_velocity_np1[0] +
+                   m_cell_velocity_np1[1] * m_cell_velocity_np1[1]);
+          double masse(0.);
+          for (int imat = 0; imat < nbmat; imat++) {
+            const double masseEnv(m_density_env_nplus1(cCells)[imat] *
+                                  vol_np1[imat]);
+            masse += masseEnv;
+            x.masseEnv[imat] += masseEnv;
+          }
+          x.masse += masse;
+        }
 
         for (int imat = 0; imat < nbmat; imat++) {
           if (pesp_np1[imat] < 0. || m_density_env_np1[imat] < 0.) {
@@ -226,22 +276,21 @@ void Eucclhyd::remapCellcenteredVariable() noexcept {
         if (m_cell_velocity_nplus1(cCells)[1] < 0.)
           m_y_cell_velocity(cCells) = MathFunctions::min(
               m_cell_velocity_nplus1(cCells)[1], -options->threshold);
-      });
-  double reductionE(0.), reductionM(0.);
-  {
-    Kokkos::Sum<double> reducerE(reductionE);
-    Kokkos::parallel_reduce("reductionE", nbCells,
-                            KOKKOS_LAMBDA(const int& cCells, double& x) {
-                              reducerE.join(x, m_total_energy_T(cCells));
-                            },
-                            reducerE);
-    Kokkos::Sum<double> reducerM(reductionM);
-    Kokkos::parallel_reduce("reductionM", nbCells,
-                            KOKKOS_LAMBDA(const int& cCells, double& x) {
-                              reducerM.join(x, m_global_masse_0(cCells));
-                            },
-                            reducerM);
+      },
+      reducer);
+  if (avecBilan) {
+    m_global_total_energy_T = bilan.energie;
+    m_total_masse_T = bilan.masse;
+    for (int imat = 0; imat < nbmatmax; imat++)
+      m_total_masse_env_T[imat] = bilan.masseEnv[imat];
   }
-  m_global_total_energy_T = reductionE;
-  m_total_masse_T = reductionM;
+}
+void Eucclhyd::remapCellcenteredVariable() noexcept {
+  dispatchNbMat(options->nbmat, [this](auto nbmat) {
+    // les fractions volumiques changent : les mailles sont classees puis les
+    // grandeurs par materiau reclassees avant d'etre ecrites
+    classifyRemapCells<decltype(nbmat)::value>();
+    buildMaterialLayout();
+    remapCellcenteredVariable<decltype(nbmat)::value>();
+  });
 }
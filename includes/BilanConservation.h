@@ -0,0 +1,90 @@
+#ifndef BILANCONSERVATION_H
+#define BILANCONSERVATION_H
+
+#include <Kokkos_Core.hpp>  // for View, KOKKOS_INLINE_FUNCTION
+
+#include "../includes/Constantes.h"  // for nbmatmax
+
+namespace conservationlib {
+
+/**
+ *******************************************************************************
+ * \struct Bilan
+ * \brief grandeurs globales de conservation cumulees en une seule reduction :
+ *        energie totale, masse totale et masse de chaque materiau
+ *******************************************************************************
+ */
+struct Bilan {
+  double energie;
+  double masse;
+  double masseEnv[nbmatmax];
+
+  KOKKOS_INLINE_FUNCTION Bilan() : energie(0.), masse(0.) {
+    for (int imat = 0; imat < nbmatmax; imat++) masseEnv[imat] = 0.;
+  }
+  KOKKOS_INLINE_FUNCTION Bilan(const Bilan& src)
+      : energie(src.energie), masse(src.masse) {
+    for (int imat = 0; imat < nbmatmax; imat++)
+      masseEnv[imat] = src.masseEnv[imat];
+  }
+  KOKKOS_INLINE_FUNCTION Bilan& operator=(const Bilan& src) {
+    energie = src.energie;
+    masse = src.masse;
+    for (int imat = 0; imat < nbmatmax; imat++)
+      masseEnv[imat] = src.masseEnv[imat];
+    return *this;
+  }
+  // chaque composante est sommee comme le ferait un Kokkos::Sum<double>
+  KOKKOS_INLINE_FUNCTION Bilan& operator+=(const Bilan& src) {
+    energie += src.energie;
+    masse += src.masse;
+    for (int imat = 0; imat < nbmatmax; imat++)
+      masseEnv[imat] += src.masseEnv[imat];
+    return *this;
+  }
+  KOKKOS_INLINE_FUNCTION void operator+=(const volatile Bilan& src) volatile {
+    energie += src.energie;
+    masse += src.masse;
+    for (int imat = 0; imat < nbmatmax; imat++)
+      masseEnv[imat] += src.masseEnv[imat];
+  }
+};
+
+/**
+ *******************************************************************************
+ * \class ReducteurBilan
+ * \brief reducteur Kokkos sommant un Bilan : le noyau ajoute directement la
+ *        contribution de chaque maille, sans tableau intermediaire aux mailles
+ *******************************************************************************
+ */
+class ReducteurBilan {
+ public:
+  typedef ReducteurBilan reducer;
+  typedef Bilan value_type;
+  typedef Kokkos::View<value_type, Kokkos::HostSpace> result_view_type;
+
+  KOKKOS_INLINE_FUNCTION explicit ReducteurBilan(value_type& value)
+      : m_value(value) {}
+
+  KOKKOS_INLINE_FUNCTION void join(value_type& dest,
+                                   const value_type& src) const {
+    dest += src;
+  }
+  KOKKOS_INLINE_FUNCTION void join(volatile value_type& dest,
+                                   const volatile value_type& src) const {
+    dest += src;
+  }
+  KOKKOS_INLINE_FUNCTION void init(value_type& val) const {
+    val = value_type();
+  }
+  KOKKOS_INLINE_FUNCTION value_type& reference() const { return m_value; }
+  KOKKOS_INLINE_FUNCTION result_view_type view() const {
+    return result_view_type(&m_value);
+  }
+  KOKKOS_INLINE_FUNCTION bool references_scalar() const { return true; }
+
+ private:
+  value_type& m_value;
+};
+}  // namespace conservationlib
+#endif  // BILANCONSERVATION_H
@@ -15,6 +15,8 @@ class ConstantesMaillagesClass {
     int cylindrical_mesh = 0;
     double minimum_radius = 0.;
     int Nombre_Particules = 0;
+    // numerotation des noeuds : 0 lexicographique, 1 Morton, 2 Hilbert
+    int ordering = 0;
   };
   ConstantesMaillages* cstmesh;
 
@@ -1,8 +1,84 @@
 #ifndef EOS_H
 #define EOS_H
 
+#include <Kokkos_Core.hpp>  // for parallel_for, KOKKOS_INLINE_FUNCTION
+#include <cmath>            // for sqrt
+
+#include "../includes/TableEos.h"  // for TableEOS
+
 namespace eoslib {
 
+/**
+ *******************************************************************************
+ * \brief lois d'etat analytiques sans branchement sur le type de loi :
+ *        eval calcule pression, vitesse du son et dp/de d'un point (rho, e),
+ *        evalBatch l'applique a toutes les mailles d'une liste pour un
+ *        materiau dont les valeurs sont contigues (MaterialView::material)
+ *******************************************************************************
+ */
+template <class Loi>
+struct LoiEOS {
+  template <class IndexView, class InView, class OutView>
+  static void evalBatch(const int nbItems, const IndexView& cells,
+                        const double gamma, const double limit_tension,
+                        const InView& rho, const InView& energy,
+                        const OutView& pression, const OutView& sound_speed,
+                        const OutView& dpde) {
+    Kokkos::parallel_for(
+        "computeEOSBatch", nbItems, KOKKOS_LAMBDA(const int& k) {
+          const int c(cells(k));
+          Loi::eval(gamma, limit_tension, rho(c), energy(c), pression(c),
+                    sound_speed(c), dpde(c));
+        });
+  }
+};
+struct LoiGP : LoiEOS<LoiGP> {
+  KOKKOS_INLINE_FUNCTION static void eval(double gamma, double limit_tension,
+                                          double rho, double energy,
+                                          double& pression,
+                                          double& sound_speed, double& dpde) {
+    pression = (gamma - 1.) * rho * energy;
+    sound_speed = std::sqrt(gamma * (gamma - 1.) * energy);
+    dpde = (gamma - 1.) * rho;
+  }
+};
+struct LoiVoid : LoiEOS<LoiVoid> {
+  KOKKOS_INLINE_FUNCTION static void eval(double gamma, double limit_tension,
+                                          double rho, double energy,
+                                          double& pression,
+                                          double& sound_speed, double& dpde) {
+    pression = 0.;
+    sound_speed = 0.;
+    dpde = 0.;
+  }
+};
+struct LoiSTIFG : LoiEOS<LoiSTIFG> {
+  KOKKOS_INLINE_FUNCTION static void eval(double gamma, double limit_tension,
+                                          double rho, double energy,
+                                          double& pression,
+                                          double& sound_speed, double& dpde) {
+    if (rho != 0.) {
+      pression = ((gamma - 1.) * rho * energy) - (gamma * limit_tension);
+      sound_speed = std::sqrt((gamma / rho) * (pression + limit_tension));
+      dpde = (gamma - 1.) * rho;
+    } else {
+      pression = 0.;
+      sound_speed = 0.;
+      dpde = 0.;
+    }
+  }
+};
+struct LoiFictif : LoiEOS<LoiFictif> {
+  KOKKOS_INLINE_FUNCTION static void eval(double gamma, double limit_tension,
+                                          double rho, double energy,
+                                          double& pression,
+                                          double& sound_speed, double& dpde) {
+    pression = 5.;
+    sound_speed = std::sqrt(gamma * (gamma - 1.) * energy);
+    dpde = 0.;
+  }
+};
+
 class EquationDetat {
  public:
   // EOS
@@ -11,53 +87,50 @@ class EquationDetat {
   int StiffenedGas = 102;
   int Fictif = 103;
   int SolidLinear = 104;
+  int Tabulee = 105;
   IntArray1D<nbmatmax> Nom = {{PerfectGas, PerfectGas, PerfectGas}};
   RealArray1D<nbmatmax> gamma = {{1.4, 1.4, 1.4}};
   RealArray1D<nbmatmax> tension_limit = {{0.01, 0.01, 0.01}};
+  // tables des materiaux dont la loi est Tabulee (lues avec FICHIER_EOS)
+  TableEOS table[nbmatmax];
   /**
    * 
    */
-  RealArray1D<3> computeEOSGP(double gamma, double limit_tension, double rho, double energy) {
-    double pression = (gamma -1.) * rho * energy;
-    double sound_speed = std::sqrt(gamma * (gamma -1.) * energy);
-    double dpde = (gamma -1.) * rho;
-    //std::cout << " rho " << rho << "  pression " << pression << std::endl;
-    return {pression, sound_speed, dpde};
+  RealArray1D<3> computeEOSGP(double gamma, double limit_tension, double rho,
+                              double energy) {
+    RealArray1D<3> sortie_eos;
+    LoiGP::eval(gamma, limit_tension, rho, energy, sortie_eos[0],
+                sortie_eos[1], sortie_eos[2]);
+    return sortie_eos;
   }
-  
-  RealArray1D<3> computeEOSVoid(double gamma, double limit_tension, double rho, double energy) {
-    double pression = 0.;
-    double sound_speed = 0.;
-     double dpde = 0.;
-    return {pression, sound_speed, dpde};
+
+  RealArray1D<3> computeEOSVoid(double gamma, double limit_tension, double rho,
+                                double energy) {
+    RealArray1D<3> sortie_eos;
+    LoiVoid::eval(gamma, limit_tension, rho, energy, sortie_eos[0],
+                  sortie_eos[1], sortie_eos[2]);
+    return sortie_eos;
   }
-  
-  RealArray1D<3> computeEOSSTIFG(double gamma, double limit_tension, double rho, double energy) {
-    double pression;
-    double sound_speed;
-    double dpde;
-    if (rho !=0.) {
-      pression = ((gamma- 1.) * rho * energy) - (gamma * limit_tension);
-      sound_speed = sqrt((gamma/rho)*(pression+limit_tension));
-      dpde = (gamma -1.) * rho;
-    } else {
-      pression = 0.;
-      sound_speed = 0.;
-      dpde = 0.;
-    }
-    //std::cout << " rho " << rho << "  pression " << pression << std::endl;
-    return {pression, sound_speed, dpde};   
+
+  RealArray1D<3> computeEOSSTIFG(double gamma, double limit_tension, double rho,
+                                 double energy) {
+    RealArray1D<3> sortie_eos;
+    LoiSTIFG::eval(gamma, limit_tension, rho, energy, sortie_eos[0],
+                   sortie_eos[1], sortie_eos[2]);
+    return sortie_eos;
   }
-  
-  RealArray1D<3> computeEOSFictif(double gamma, double limit_tension, double rho, double energy) {
-    double pression = 5.;
-    double sound_speed = std::sqrt(gamma * (gamma -1.) * energy);
-    double dpde = 0.;
-    return {pression, sound_speed, dpde};   
+
+  RealArray1D<3> computeEOSFictif(double gamma, double limit_tension,
+                                  double rho, double energy) {
+    RealArray1D<3> sortie_eos;
+    LoiFictif::eval(gamma, limit_tension, rho, energy, sortie_eos[0],
+                    sortie_eos[1], sortie_eos[2]);
+    return sortie_eos;
   }
-  
+
   RealArray1D<3> computeEOSSL(double gamma, double limit_tension, double rho, double energy) {
     std::cout << " Pas encore programmée" << std::endl;
+    return {0., 0., 0.};
   }
   RealArray1D<3> computeEOS(int imat, double gamma, double limit_tension, double rho, double energy){
     if (imat == Void) return computeEOSVoid(gamma, limit_tension, rho, energy);
@@ -65,9 +138,92 @@ class EquationDetat {
     if (imat == StiffenedGas) return computeEOSSTIFG(gamma, limit_tension, rho, energy);
     if (imat == Fictif) return computeEOSFictif(gamma, limit_tension, rho, energy);
     if (imat == SolidLinear) return computeEOSSL(gamma, limit_tension, rho, energy);
+    // loi inconnue ou tabulee (sans table) : ni pression ni vitesse du son
+    return {0., 0., 0.};
   }
-   
+  /**
+   * loi du materiau imat en un point (rho, e), tables comprises
+   */
+  RealArray1D<3> computeEOSMateriau(int imat, double rho, double energy) {
+    if (Nom[imat] == Tabulee) {
+      RealArray1D<3> sortie_eos;
+      int iRho(-1), iEnergie(-1);
+      table[imat].eval(rho, energy, iRho, iEnergie, sortie_eos[0],
+                       sortie_eos[1], sortie_eos[2]);
+      return sortie_eos;
+    }
+    return computeEOS(Nom[imat], gamma[imat], tension_limit[imat], rho,
+                      energy);
+  }
+  /**
+   * evaluation par lot de la loi du materiau imat sur les nbItems mailles de
+   * la liste cells : la loi est choisie une seule fois pour le materiau et
+   * son noyau est sans branchement, les lois non analytiques passent par
+   * computeEOS
+   */
+  template <class IndexView, class InView, class OutView>
+  void computeEOSBatch(int imat, int nbItems, const IndexView& cells,
+                       const InView& rho, const InView& energy,
+                       const OutView& pression, const OutView& sound_speed,
+                       const OutView& dpde) {
+    const int nom(Nom[imat]);
+    const double gamma(this->gamma[imat]);
+    const double limit_tension(tension_limit[imat]);
+    if (nom == Void)
+      LoiVoid::evalBatch(nbItems, cells, gamma, limit_tension, rho, energy,
+                         pression, sound_speed, dpde);
+    else if (nom == PerfectGas)
+      LoiGP::evalBatch(nbItems, cells, gamma, limit_tension, rho, energy,
+                       pression, sound_speed, dpde);
+    else if (nom == StiffenedGas)
+      LoiSTIFG::evalBatch(nbItems, cells, gamma, limit_tension, rho, energy,
+                          pression, sound_speed, dpde);
+    else if (nom == Fictif)
+      LoiFictif::evalBatch(nbItems, cells, gamma, limit_tension, rho, energy,
+                           pression, sound_speed, dpde);
+    else if (nom == Tabulee)
+      computeEOSBatchTable(table[imat], nbItems, cells, rho, energy, pression,
+                           sound_speed, dpde);
+    else
+      Kokkos::parallel_for(
+          "computeEOSBatch", nbItems, KOKKOS_LAMBDA(const int& k) {
+            const int c(cells(k));
+            RealArray1D<3> sortie_eos =
+                computeEOS(nom, gamma, limit_tension, rho(c), energy(c));
+            pression(c) = sortie_eos[0];
+            sound_speed(c) = sortie_eos[1];
+            dpde(c) = sortie_eos[2];
+          });
+  }
+
  private:
+  /**
+   * une iteration traite un paquet de mailles consecutives de la liste : les
+   * indices de la derniere maille de table restent propres au thread et
+   * evitent la recherche entre mailles voisines
+   */
+  template <class IndexView, class InView, class OutView>
+  static void computeEOSBatchTable(const TableEOS& tableImat, int nbItems,
+                                   const IndexView& cells, const InView& rho,
+                                   const InView& energy,
+                                   const OutView& pression,
+                                   const OutView& sound_speed,
+                                   const OutView& dpde) {
+    const int taillePaquet(64);
+    const int nbPaquets((nbItems + taillePaquet - 1) / taillePaquet);
+    Kokkos::parallel_for(
+        "computeEOSBatchTable", nbPaquets, KOKKOS_LAMBDA(const int& paquet) {
+          int iRho(-1), iEnergie(-1);
+          const int debut(paquet * taillePaquet);
+          const int fin(debut + taillePaquet < nbItems ? debut + taillePaquet
+                                                       : nbItems);
+          for (int k = debut; k < fin; ++k) {
+            const int c(cells(k));
+            tableImat.eval(rho(c), energy(c), iRho, iEnergie, pression(c),
+                           sound_speed(c), dpde(c));
+          }
+        });
+  }
 };
 }  // namespace eoslib
 #endif  // EOS_H
@@ -0,0 +1,109 @@
+#ifndef GEOMETRIELAGRANGE_H
+#define GEOMETRIELAGRANGE_H
+
+#include <Kokkos_Core.hpp>  // for KOKKOS_INLINE_FUNCTION
+
+#include "../includes/Constantes.h"     // for dim, zeroVect
+#include "../includes/Freefunctions.h"  // for crossProduct2d, computeLpcNpc
+#include "mesh/CartesianMesh2D.h"       // for CartesianMesh2D::Direction
+#include "types/MathFunctions.h"        // for norm
+
+namespace geometrielib {
+
+/**
+ *******************************************************************************
+ * \struct GeometrieMaille
+ * \brief geometrie d'une maille quadrangulaire : les 4 noeuds sont lus une
+ *        seule fois puis volume, centre, sous-volumes, vecteurs de coin et
+ *        aretes sont calcules sur ces copies locales.
+ *        Les formules (et l'ordre des sommes) sont celles des noyaux des
+ *        schemas : les resultats sont identiques bit a bit.
+ *
+ *        Les noeuds sont ranges (i,j) (i,j+1) (i+1,j+1) (i+1,j) : l'arete
+ *        (p, p+1) est la face du bas, de droite, du haut puis de gauche.
+ *******************************************************************************
+ */
+struct GeometrieMaille {
+  static constexpr int nbNoeuds = 4;
+  RealArray1D<dim> x[nbNoeuds];
+
+  template <class Coord, class Noeuds>
+  KOKKOS_INLINE_FUNCTION GeometrieMaille(const Coord& coord,
+                                         const Noeuds& noeudsMaille) {
+    for (int p = 0; p < nbNoeuds; p++) x[p] = coord(noeudsMaille[p]);
+  }
+
+  // noeud p de la maille, p pouvant valoir -1 ou nbNoeuds
+  KOKKOS_INLINE_FUNCTION const RealArray1D<dim>& noeud(const int p) const {
+    return x[(p + nbNoeuds) % nbNoeuds];
+  }
+
+  // volume : formule des trapezes
+  KOKKOS_INLINE_FUNCTION double volume() const {
+    double reduction = 0.0;
+    for (int p = 0; p < nbNoeuds; p++)
+      reduction = reduction + (crossProduct2d(x[p], noeud(p + 1)));
+    return 0.5 * reduction;
+  }
+
+  // centre de gravite, vol etant le volume de la maille
+  KOKKOS_INLINE_FUNCTION RealArray1D<dim> centreGravite(
+      const double vol) const {
+    RealArray1D<dim> reduction = zeroVect;
+    for (int p = 0; p < nbNoeuds; p++)
+      reduction = reduction + (crossProduct2d(x[p], noeud(p + 1)) *
+                               (x[p] + noeud(p + 1)));
+    return (1.0 / (6.0 * vol) * reduction);
+  }
+
+  // centre : moyenne arithmetique des noeuds
+  KOKKOS_INLINE_FUNCTION RealArray1D<dim> centre() const {
+    RealArray1D<dim> reduction({0.0, 0.0});
+    for (int p = 0; p < nbNoeuds; p++) reduction = sumR1(reduction, x[p]);
+    return 0.25 * reduction;
+  }
+
+  // sous-volume du noeud p delimite par le centre xc et les milieux des
+  // aretes voisines
+  KOKKOS_INLINE_FUNCTION double sousVolume(const int p,
+                                           const RealArray1D<dim>& xc) const {
+    const RealArray1D<dim> x1(xc);
+    const RealArray1D<dim> x2(0.5 * (noeud(p - 1) + x[p]));
+    const RealArray1D<dim> x3(x[p]);
+    const RealArray1D<dim> x4(0.5 * (noeud(p + 1) + x[p]));
+    return 0.5 * (crossProduct2d(x1, x2) + crossProduct2d(x2, x3) +
+                  crossProduct2d(x3, x4) + crossProduct2d(x4, x1));
+  }
+
+  // vecteur de coin lpc * npc du noeud p
+  KOKKOS_INLINE_FUNCTION RealArray1D<dim> lpcNpc(const int p) const {
+    return computeLpcNpc(x[p], noeud(p + 1), noeud(p - 1));
+  }
+
+  // milieu et longueur de l'arete (p, p+1)
+  KOKKOS_INLINE_FUNCTION RealArray1D<dim> milieuArete(const int p) const {
+    return 0.5 * (x[p] + noeud(p + 1));
+  }
+  KOKKOS_INLINE_FUNCTION double longueurArete(const int p) const {
+    return MathFunctions::norm(noeud(p + 1) - x[p]);
+  }
+
+  // perimetre de la maille
+  KOKKOS_INLINE_FUNCTION double perimetre() const {
+    double reduction = 0.0;
+    for (int p = 0; p < nbNoeuds; p++)
+      reduction = reduction + (MathFunctions::norm(x[p] - noeud(p + 1)));
+    return reduction;
+  }
+
+  // direction (dans getFacesOfCell) de la face portee par l'arete (p, p+1)
+  KOKKOS_INLINE_FUNCTION static CartesianMesh2D::Direction faceArete(
+      const int p) {
+    return (p == 0 ? CartesianMesh2D::Bottom
+                   : (p == 1 ? CartesianMesh2D::Right
+                             : (p == 2 ? CartesianMesh2D::Top
+                                       : CartesianMesh2D::Left)));
+  }
+};
+}  // namespace geometrielib
+#endif  // GEOMETRIELAGRANGE_H
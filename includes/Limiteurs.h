@@ -6,15 +6,15 @@ namespace limiteurslib {
 class LimiteursClass {
  public:
   struct Limiteurs {
-    // limiteur
-    int minmod = 300;
-    int superBee = 301;
-    int vanLeer = 302;
-    int minmodG = 1300;
-    int superBeeG = 1301;
-    int vanLeerG = 1302;
-    int arithmeticG = 1303;
-    int ultrabeeG = 1304;
+    // limiteur (constantes pour le choix du limiteur a la compilation)
+    static constexpr int minmod = 300;
+    static constexpr int superBee = 301;
+    static constexpr int vanLeer = 302;
+    static constexpr int minmodG = 1300;
+    static constexpr int superBeeG = 1301;
+    static constexpr int vanLeerG = 1302;
+    static constexpr int arithmeticG = 1303;
+    static constexpr int ultrabeeG = 1304;
 
     int projectionAvecPlateauPente = 0;
 
@@ -0,0 +1,321 @@
+#ifndef MATERIALVIEW_H
+#define MATERIALVIEW_H
+
+#include <stddef.h>  // for size_t
+
+#include <Kokkos_Core.hpp>  // for View, LayoutLeft
+#include <string>           // for string
+#include <type_traits>      // for integral_constant
+
+#include "../includes/Constantes.h"  // for nbmatmax
+
+/**
+ *******************************************************************************
+ * \class MaterialView
+ * \brief grandeur par materiau rangee en structure de tableaux : la valeur du
+ *        materiau imat de l'item c est en (c, imat) d'une View LayoutLeft,
+ *        les items d'un meme materiau sont donc contigus (boucles sur les
+ *        mailles vectorisables).
+ *        L'acces m(c)[imat] des View<RealArray1D<nbmatmax>*> est conserve.
+ *******************************************************************************
+ */
+class MaterialView {
+ public:
+  using view_type = Kokkos::View<double**, Kokkos::LayoutLeft>;
+  using material_type = Kokkos::View<double*, Kokkos::LayoutLeft>;
+
+  // valeurs des materiaux d'un item, espacees du pas entre materiaux
+  class Item {
+   public:
+    KOKKOS_INLINE_FUNCTION Item(double* data, const size_t stride)
+        : m_data(data), m_stride(stride) {}
+    KOKKOS_INLINE_FUNCTION double& operator[](const int imat) const {
+      return m_data[imat * m_stride];
+    }
+
+   private:
+    double* m_data;
+    size_t m_stride;
+  };
+
+  MaterialView() = default;
+  MaterialView(const std::string& label, const size_t nbItems)
+      : m_view(label, nbItems, nbmatmax) {}
+
+  KOKKOS_INLINE_FUNCTION Item operator()(const size_t c) const {
+    return Item(&m_view(c, 0), m_view.stride_1());
+  }
+  KOKKOS_INLINE_FUNCTION double& operator()(const size_t c,
+                                            const int imat) const {
+    return m_view(c, imat);
+  }
+
+  // valeurs contigues d'un materiau pour tous les items
+  material_type material(const int imat) const {
+    return Kokkos::subview(m_view, Kokkos::ALL(), imat);
+  }
+  size_t extent(const int r) const { return m_view.extent(r); }
+  const view_type& view() const { return m_view; }
+
+ private:
+  view_type m_view;
+};
+
+inline void deep_copy(const MaterialView& dst, const MaterialView& src) {
+  Kokkos::deep_copy(dst.view(), src.view());
+}
+
+/**
+ *******************************************************************************
+ * \class CellMaterialLayout
+ * \brief repartition des materiaux dans les mailles : une maille pure (un seul
+ *        materiau de fraction volumique non nulle) range la valeur de ce
+ *        materiau dans un tableau dense aux mailles, une maille mixte (ou sans
+ *        materiau) occupe un rang de la liste compacte mixedCells et y range
+ *        les valeurs de tous les materiaux.
+ *        slot(c) vaut ce rang, ou -1-imat pour une maille pure du materiau
+ *        imat. Avant la premiere classification toutes les mailles sont
+ *        pures du materiau 0.
+ *******************************************************************************
+ */
+class CellMaterialLayout {
+ public:
+  // classement a appliquer : materiau unique de la maille, -1 si la maille
+  // porte plusieurs materiaux ou aucun
+  Kokkos::View<int*> cellMaterial;
+  // rang dans la liste des mailles mixtes ou -1-imat, et sa valeur avant le
+  // dernier build, lue par CellMaterialView::relayout
+  Kokkos::View<int*> slot;
+  Kokkos::View<int*> prevSlot;
+  Kokkos::View<int*> mixedCells;
+  int nbMixedCells;
+
+  explicit CellMaterialLayout(const size_t nbCells)
+      : cellMaterial("cellMaterial", nbCells),
+        slot("slot", nbCells),
+        prevSlot("prevSlot", nbCells),
+        mixedCells("mixedCells", nbCells),
+        nbMixedCells(0) {
+    Kokkos::deep_copy(slot, -1);
+    Kokkos::deep_copy(prevSlot, -1);
+  }
+  /**
+   * \brief reconstruit slot et mixedCells a partir de cellMaterial ; les
+   *        CellMaterialView doivent ensuite etre reclassees par relayout
+   */
+  void build() {
+    Kokkos::deep_copy(prevSlot, slot);
+    auto matCells(cellMaterial);
+    auto slotCells(slot);
+    auto list(mixedCells);
+    int nbMixed(0);
+    Kokkos::parallel_scan(
+        "buildMixedCellList", cellMaterial.extent(0),
+        KOKKOS_LAMBDA(const int& cCells, int& k, const bool final) {
+          const int imat(matCells(cCells));
+          if (imat < 0) {
+            if (final) {
+              list(k) = cCells;
+              slotCells(cCells) = k;
+            }
+            ++k;
+          } else if (final) {
+            slotCells(cCells) = -1 - imat;
+          }
+        },
+        nbMixed);
+    nbMixedCells = nbMixed;
+  }
+};
+
+/**
+ *******************************************************************************
+ * \brief indice des valeurs d'une maille mixte dans CellMaterialView::mixed :
+ *        son rang k dans la liste, pour les evaluations par lot
+ *******************************************************************************
+ */
+struct MixedRank {
+  KOKKOS_INLINE_FUNCTION int operator()(const int k) const { return k; }
+};
+
+/**
+ *******************************************************************************
+ * \class CellMaterialView
+ * \brief grandeur par materiau aux mailles rangee suivant un
+ *        CellMaterialLayout : un tableau dense pour les mailles pures et un
+ *        tableau (rang, imat) LayoutLeft pour les seules mailles mixtes.
+ *        L'acces m(c)[imat] et m(c, imat) est conserve : un materiau absent
+ *        d'une maille pure vaut 0 et les ecritures qui le visent sont ignorees.
+ *******************************************************************************
+ */
+class CellMaterialView {
+ public:
+  using bulk_type = Kokkos::View<double*>;
+  using mixed_type = Kokkos::View<double**, Kokkos::LayoutLeft>;
+  using material_type = Kokkos::View<double*, Kokkos::LayoutLeft>;
+
+  // valeur d'un materiau d'une maille, nulle et non modifiable pour un
+  // materiau absent
+  class Ref {
+   public:
+    KOKKOS_INLINE_FUNCTION explicit Ref(double* data) : m_data(data) {}
+    KOKKOS_INLINE_FUNCTION operator double() const {
+      return (m_data ? *m_data : 0.);
+    }
+    KOKKOS_INLINE_FUNCTION Ref& operator=(const double v) {
+      if (m_data) *m_data = v;
+      return *this;
+    }
+    KOKKOS_INLINE_FUNCTION Ref& operator=(const Ref& r) {
+      return (*this = static_cast<double>(r));
+    }
+    KOKKOS_INLINE_FUNCTION Ref& operator+=(const double v) {
+      return (*this = static_cast<double>(*this) + v);
+    }
+    KOKKOS_INLINE_FUNCTION Ref& operator-=(const double v) {
+      return (*this = static_cast<double>(*this) - v);
+    }
+    KOKKOS_INLINE_FUNCTION Ref& operator*=(const double v) {
+      return (*this = static_cast<double>(*this) * v);
+    }
+    KOKKOS_INLINE_FUNCTION Ref& operator/=(const double v) {
+      return (*this = static_cast<double>(*this) / v);
+    }
+
+   private:
+    double* m_data;
+  };
+
+  // valeurs des materiaux d'une maille : toutes pour une maille mixte, la
+  // seule valeur du materiau imatPure pour une maille pure
+  class Item {
+   public:
+    KOKKOS_INLINE_FUNCTION Item(double* data, const size_t stride,
+                                const int imatPure)
+        : m_data(data), m_stride(stride), m_imat_pure(imatPure) {}
+    KOKKOS_INLINE_FUNCTION Ref operator[](const int imat) const {
+      if (m_imat_pure < 0) return Ref(m_data + imat * m_stride);
+      return Ref(imat == m_imat_pure ? m_data : nullptr);
+    }
+
+   private:
+    double* m_data;
+    size_t m_stride;
+    int m_imat_pure;
+  };
+
+  CellMaterialView() = default;
+  CellMaterialView(const std::string& label, const CellMaterialLayout& layout)
+      : m_bulk(label, layout.slot.extent(0)),
+        m_mixed(label, 0, nbmatmax),
+        m_slot(layout.slot) {}
+
+  KOKKOS_INLINE_FUNCTION Item operator()(const size_t c) const {
+    const int s(m_slot(c));
+    if (s >= 0) return Item(&m_mixed(s, 0), m_mixed.stride_1(), -1);
+    return Item(&m_bulk(c), 0, -1 - s);
+  }
+  KOKKOS_INLINE_FUNCTION Ref operator()(const size_t c, const int imat) const {
+    return (*this)(c)[imat];
+  }
+
+  // valeurs des mailles pures (indice maille) et des mailles mixtes (indice
+  // rang dans la liste, materiau)
+  const bulk_type& bulk() const { return m_bulk; }
+  const mixed_type& mixed() const { return m_mixed; }
+  const Kokkos::View<int*>& slot() const { return m_slot; }
+  // valeurs contigues d'un materiau pour les mailles mixtes
+  material_type mixedMaterial(const int imat) const {
+    return Kokkos::subview(m_mixed, Kokkos::ALL(), imat);
+  }
+
+  /**
+   * \brief reclassement des valeurs apres CellMaterialLayout::build : une
+   *        maille qui devient mixte recopie sa valeur pure (les autres
+   *        materiaux sont nuls), une maille qui devient pure ne garde que
+   *        la valeur de son materiau
+   */
+  void relayout(const CellMaterialLayout& layout) {
+    mixed_type mixed("mixed", layout.nbMixedCells, nbmatmax);
+    auto bulk(m_bulk);
+    auto oldMixed(m_mixed);
+    auto prevSlot(layout.prevSlot);
+    auto slot(layout.slot);
+    Kokkos::parallel_for(
+        "relayout", slot.extent(0), KOKKOS_LAMBDA(const int& cCells) {
+          const int p(prevSlot(cCells));
+          const int s(slot(cCells));
+          for (int imat = 0; imat < nbmatmax; imat++) {
+            if (s < 0 && imat != -1 - s) continue;
+            const double v(p >= 0 ? oldMixed(p, imat)
+                                  : (imat == -1 - p ? bulk(cCells) : 0.));
+            if (s >= 0)
+              mixed(s, imat) = v;
+            else
+              bulk(cCells) = v;
+          }
+        });
+    m_mixed = mixed;
+  }
+
+ private:
+  bulk_type m_bulk;
+  mixed_type m_mixed;
+  Kokkos::View<int*> m_slot;
+};
+
+inline void deep_copy(const CellMaterialView& dst,
+                      const CellMaterialView& src) {
+  Kokkos::deep_copy(dst.bulk(), src.bulk());
+  Kokkos::deep_copy(dst.mixed(), src.mixed());
+}
+/**
+ *******************************************************************************
+ * \brief rangement d'une grandeur dense (initialisation) suivant la
+ *        repartition de dst, deja reclassee par relayout
+ *******************************************************************************
+ */
+inline void deep_copy(const CellMaterialView& dst, const MaterialView& src) {
+  auto bulk(dst.bulk());
+  auto mixed(dst.mixed());
+  auto dense(src.view());
+  auto slot(dst.slot());
+  Kokkos::parallel_for(
+      "packMaterial", bulk.extent(0), KOKKOS_LAMBDA(const int& cCells) {
+        const int s(slot(cCells));
+        if (s >= 0)
+          for (int imat = 0; imat < nbmatmax; imat++)
+            mixed(s, imat) = dense(cCells, imat);
+        else
+          bulk(cCells) = dense(cCells, -1 - s);
+      });
+}
+/**
+ *******************************************************************************
+ * \brief reclassement d'une liste de grandeurs apres layout.build()
+ *******************************************************************************
+ */
+template <typename... Fields>
+inline void relayoutMaterials(const CellMaterialLayout& layout,
+                              Fields&... fields) {
+  (fields.relayout(layout), ...);
+}
+
+/**
+ *******************************************************************************
+ * \brief appel de f avec le nombre de materiaux en constante de compilation
+ *        (std::integral_constant 1, 2 ou nbmatmax) : les noyaux specialises
+ *        deroulent leurs boucles sur les materiaux
+ *******************************************************************************
+ */
+template <typename Functor>
+inline void dispatchNbMat(const int nbmat, const Functor& f) {
+  if (nbmat == 1)
+    f(std::integral_constant<int, 1>());
+  else if (nbmat == 2)
+    f(std::integral_constant<int, 2>());
+  else
+    f(std::integral_constant<int, nbmatmax>());
+}
+
+#endif  // MATERIALVIEW_H
@@ -23,6 +23,11 @@ class OptionsSchema {
     int pseudo_centree = 1;
     int methode_flux_masse = 0;
     int sansLagrange = 0;
+    // bilans globaux (masse, energie) calcules tous les frequenceBilan cycles
+    int frequenceBilan = 1;
+    // Eucclhyd : forces aux coins par materiau recalculees a la mise a jour
+    // des mailles au lieu d'etre stockees aux noeuds
+    int forcesMateriauxRecalculees = 0;
     string fichier_sortie1D;
   };
   Options* options;
@@ -13,6 +13,7 @@ class Sortie {
     bool pseudo = false;
     bool fraction_volumique = false;
     bool interface = false;
+    bool pas_de_temps = false;
   };
   SortieVariables* sortievariable;
 
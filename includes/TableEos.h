@@ -0,0 +1,131 @@
+#ifndef TABLEEOS_H
+#define TABLEEOS_H
+
+#include <stdlib.h>  // for exit
+
+#include <Kokkos_Core.hpp>  // for View, KOKKOS_INLINE_FUNCTION
+#include <cstdint>          // for int32_t
+#include <fstream>          // for ifstream
+#include <iostream>         // for cerr
+#include <string>           // for string
+
+namespace eoslib {
+
+/**
+ *******************************************************************************
+ * \class TableEOS
+ * \brief equation d'etat tabulee sur une grille (rho, e) : pression, vitesse
+ *        du son et dp/de sont interpoles bilineairement. La table est lue une
+ *        seule fois et partagee en lecture par tous les threads.
+ *
+ *        Fichier binaire (natif) : int32 nbRho, int32 nbEnergie,
+ *        double rho[nbRho], double e[nbEnergie] (grilles croissantes),
+ *        puis pression, vitesse du son et dp/de, chacun rangé en
+ *        double f[i * nbEnergie + j] pour (rho[i], e[j]).
+ *        Hors de la table les valeurs du bord sont prises.
+ *******************************************************************************
+ */
+class TableEOS {
+ public:
+  TableEOS() = default;
+
+  void lecture(const std::string& fichier) {
+    std::ifstream table(fichier, std::ios::binary);
+    int32_t nbRho(0), nbEnergie(0);
+    if (table) {
+      table.read(reinterpret_cast<char*>(&nbRho), sizeof(int32_t));
+      table.read(reinterpret_cast<char*>(&nbEnergie), sizeof(int32_t));
+    }
+    if (!table || nbRho < 2 || nbEnergie < 2) {
+      std::cerr << "[ERREUR] Table d'equation d'etat illisible : " << fichier
+                << std::endl;
+      exit(1);
+    }
+    m_nb_rho = nbRho;
+    m_nb_energie = nbEnergie;
+    m_rho = Kokkos::View<double*>("eos_rho", m_nb_rho);
+    m_energie = Kokkos::View<double*>("eos_energie", m_nb_energie);
+    m_pression = Kokkos::View<double*>("eos_pression", m_nb_rho * m_nb_energie);
+    m_sound_speed =
+        Kokkos::View<double*>("eos_sound_speed", m_nb_rho * m_nb_energie);
+    m_dpde = Kokkos::View<double*>("eos_dpde", m_nb_rho * m_nb_energie);
+    lectureTableau(table, m_rho);
+    lectureTableau(table, m_energie);
+    lectureTableau(table, m_pression);
+    lectureTableau(table, m_sound_speed);
+    lectureTableau(table, m_dpde);
+    if (!table) {
+      std::cerr << "[ERREUR] Table d'equation d'etat tronquee : " << fichier
+                << std::endl;
+      exit(1);
+    }
+  }
+  bool estChargee() const { return m_nb_rho > 0; }
+
+  /**
+   * interpolation bilineaire en (rho, e), les indices (iRho, iEnergie) de la
+   * derniere maille de table utilisee servent de point de depart a la
+   * recherche suivante : un thread qui parcourt des mailles voisines les
+   * retrouve en general sans recherche
+   */
+  KOKKOS_INLINE_FUNCTION void eval(double rho, double energy, int& iRho,
+                                   int& iEnergie, double& pression,
+                                   double& sound_speed, double& dpde) const {
+    iRho = intervalle(m_rho, m_nb_rho, rho, iRho);
+    iEnergie = intervalle(m_energie, m_nb_energie, energy, iEnergie);
+    const double tr(poids(m_rho, iRho, rho));
+    const double te(poids(m_energie, iEnergie, energy));
+    const int k00(iRho * m_nb_energie + iEnergie);
+    const int k10(k00 + m_nb_energie);
+    const double w00((1. - tr) * (1. - te)), w01((1. - tr) * te);
+    const double w10(tr * (1. - te)), w11(tr * te);
+    pression = w00 * m_pression(k00) + w01 * m_pression(k00 + 1) +
+               w10 * m_pression(k10) + w11 * m_pression(k10 + 1);
+    sound_speed = w00 * m_sound_speed(k00) + w01 * m_sound_speed(k00 + 1) +
+                  w10 * m_sound_speed(k10) + w11 * m_sound_speed(k10 + 1);
+    dpde = w00 * m_dpde(k00) + w01 * m_dpde(k00 + 1) + w10 * m_dpde(k10) +
+           w11 * m_dpde(k10 + 1);
+  }
+
+ private:
+  static void lectureTableau(std::ifstream& table,
+                             const Kokkos::View<double*>& tableau) {
+    table.read(reinterpret_cast<char*>(tableau.data()),
+               tableau.extent(0) * sizeof(double));
+  }
+  // indice i tel que x[i] <= v < x[i+1], borne a [0, n-2]
+  KOKKOS_INLINE_FUNCTION static int intervalle(const Kokkos::View<double*>& x,
+                                               const int n, const double v,
+                                               const int indice) {
+    if (indice >= 0 && indice < n - 1) {
+      if (x(indice) <= v && v < x(indice + 1)) return indice;
+      if (indice < n - 2 && x(indice + 1) <= v && v < x(indice + 2))
+        return indice + 1;
+      if (indice > 0 && x(indice - 1) <= v && v < x(indice)) return indice - 1;
+    }
+    int bas(0), haut(n - 1);
+    while (haut - bas > 1) {
+      const int milieu((bas + haut) / 2);
+      if (v < x(milieu))
+        haut = milieu;
+      else
+        bas = milieu;
+    }
+    return bas;
+  }
+  KOKKOS_INLINE_FUNCTION static double poids(const Kokkos::View<double*>& x,
+                                             const int i, const double v) {
+    const double t((v - x(i)) / (x(i + 1) - x(i)));
+    return (t < 0. ? 0. : (t > 1. ? 1. : t));
+  }
+
+  int m_nb_rho = 0;
+  int m_nb_energie = 0;
+  Kokkos::View<double*> m_rho;
+  Kokkos::View<double*> m_energie;
+  Kokkos::View<double*> m_pression;
+  Kokkos::View<double*> m_sound_speed;
+  Kokkos::View<double*> m_dpde;
+};
+}  // namespace eoslib
+#endif  // TABLEEOS_H
@@ -0,0 +1,49 @@
+#ifndef TAILLEMEMOIRE_H
+#define TAILLEMEMOIRE_H
+
+#include <stddef.h>  // for size_t
+
+#include <iostream>  // for cout
+#include <string>    // for string
+
+#include "../includes/MaterialView.h"  // for MaterialView, CellMaterialView
+#include "utils/Utils.h"               // for __GREEN__, __RESET__
+
+/**
+ *******************************************************************************
+ * \brief taille en octets d'une View (nulle si la View n'est pas allouee)
+ *******************************************************************************
+ */
+template <typename ViewType>
+inline size_t viewBytes(const ViewType& v) {
+  return v.span() * sizeof(typename ViewType::value_type);
+}
+inline size_t viewBytes(const MaterialView& v) { return viewBytes(v.view()); }
+inline size_t viewBytes(const CellMaterialView& v) {
+  return viewBytes(v.bulk()) + viewBytes(v.mixed());
+}
+inline size_t viewBytes(const CellMaterialLayout& l) {
+  return viewBytes(l.cellMaterial) + viewBytes(l.slot) +
+         viewBytes(l.prevSlot) + viewBytes(l.mixedCells);
+}
+/**
+ *******************************************************************************
+ * \brief taille totale en octets d'une liste de Views
+ *******************************************************************************
+ */
+template <typename... Views>
+inline size_t allocatedBytes(const Views&... v) {
+  return (viewBytes(v) + ... + size_t(0));
+}
+/**
+ *******************************************************************************
+ * \brief bilan memoire d'un module affiche au demarrage
+ *******************************************************************************
+ */
+inline void printAllocatedBytes(const std::string& module, size_t bytes) {
+  std::cout << "[" << __GREEN__ << "MEMORY" << __RESET__ << "]    " << module
+            << " : " << bytes << " octets (" << bytes / (1024. * 1024.)
+            << " Mo)" << std::endl;
+}
+
+#endif  // TAILLEMEMOIRE_H
@@ -16,6 +16,7 @@
 #include "types/Types.h"           // for RealArray1D, RealArray2D
 #include "utils/Timer.h"           // for Timer
 #include "../includes/Constantes.h" // for dim, nbequamax
+#include "../includes/TailleMemoire.h"  // for allocatedBytes
 
 using namespace nablalib;
 
@@ -33,6 +34,11 @@ class VariablesLagRemap {
   Kokkos::View<RealArray1D<dim>*> XLagrange;
   Kokkos::View<RealArray1D<dim>*> XfLagrange;
   Kokkos::View<RealArray1D<dim>*> XcLagrange;
+  // geometrie eulerienne des faces (Xf, faceNormal, outerFaceNormal,
+  // faceLength) : calculee une seule fois par initMeshGeometryForFaces et
+  // lue a chaque cycle par les schemas et la projection. Seul Eucclhyd sans
+  // projection echange Xf et faceLength avec XfLagrange et faceLengthLagrange
+  // en fin de cycle.
   Kokkos::View<RealArray1D<dim>*> Xf;
   Kokkos::View<RealArray1D<dim>*> faceNormal;
   Kokkos::View<RealArray1D<dim>**> outerFaceNormal;
@@ -47,6 +53,9 @@ class VariablesLagRemap {
   Kokkos::View<double*> rLagrange;
   Kokkos::View<int*> mixte;
   Kokkos::View<int*> pure;
+  // repartition des grandeurs par materiau : mailles pures au tableau dense,
+  // liste compacte des mailles mixtes (et des mailles sans materiau)
+  CellMaterialLayout layout;
   bool x_then_y_n, x_then_y_nplus1;
 
   VariablesLagRemap(CartesianMesh2D* aCartesianMesh2D)
@@ -75,12 +84,23 @@ class VariablesLagRemap {
         rLagrange("rLagrange", nbCells),
         mixte("mixte", nbCells),
         pure("pure", nbCells),
+        layout(nbCells),
         x_then_y_n(true),
         x_then_y_nplus1(true) {
     std::cout << "Nombre de mailles:  " << nbCells
               << "Nombre de noeuds: " << nbNodes
               << "Nombre de faces:  " << nbFaces << std::endl;
   }
+  /**
+   * \brief taille memoire des tableaux de la projection
+   */
+  size_t getAllocatedBytes() const noexcept {
+    return allocatedBytes(Phi, DualPhi, deltaxLagrange, XLagrange, XfLagrange,
+                          XcLagrange, Xf, faceNormal, outerFaceNormal,
+                          faceLength, faceLengthLagrange, faceNormalVelocity,
+                          ULagrange, UDualLagrange, Uremap2, UDualremap2,
+                          vLagrange, rLagrange, mixte, pure, layout);
+  }
 };
 }  // namespace variableslagremaplib
 #endif  // VARIABLESLAGREMAP_H
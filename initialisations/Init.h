@@ -11,6 +11,7 @@
 #include "../includes/Eos.h"
 #include "../includes/Freefunctions.h"
 #include "../includes/GestionTemps.h"
+#include "../includes/MaterialView.h"
 #include "../includes/Options.h"
 #include "../includes/VariablesLagRemap.h"
 #include "mesh/CartesianMesh2D.h"  // for CartesianMesh2D
@@ -35,12 +36,12 @@ class Initialisations {
   Kokkos::View<RealArray1D<dim>*> m_cell_coord_n0;
   Kokkos::View<double*> m_euler_volume_n0;
   Kokkos::View<double*> m_density_n0;
-  Kokkos::View<RealArray1D<nbmatmax>*> m_density_env_n0;
+  MaterialView m_density_env_n0;
   Kokkos::View<double*> m_internal_energy_n0;
-  Kokkos::View<RealArray1D<nbmatmax>*> m_internal_energy_env_n0;
+  MaterialView m_internal_energy_env_n0;
   Kokkos::View<RealArray1D<dim>*> m_node_velocity_n0;
-  Kokkos::View<RealArray1D<nbmatmax>*> m_mass_fraction_env_n0;
-  Kokkos::View<RealArray1D<nbmatmax>*> m_fracvol_env_n0;
+  MaterialView m_mass_fraction_env_n0;
+  MaterialView m_fracvol_env_n0;
   // init EUC
   Kokkos::View<double*> m_cell_perimeter_n0;
   Kokkos::View<RealArray1D<dim>*> m_cell_velocity_n0;
@@ -49,14 +50,14 @@ class Initialisations {
   // init VNR
   Kokkos::View<double**> m_node_cellvolume_n0;
   Kokkos::View<double*> m_pressure_n0;
-  Kokkos::View<RealArray1D<nbmatmax>*> m_pressure_env_n0;
+  MaterialView m_pressure_env_n0;
   Kokkos::View<double*> m_pseudo_viscosity_n0;
-  Kokkos::View<RealArray1D<nbmatmax>*> m_pseudo_viscosity_env_n0;
+  MaterialView m_pseudo_viscosity_env_n0;
   Kokkos::View<double*> m_tau_density_n0;
-  Kokkos::View<RealArray1D<nbmatmax>*> m_tau_density_env_n0;
+  MaterialView m_tau_density_env_n0;
   Kokkos::View<double*> m_divu_n0;
   Kokkos::View<double*> m_speed_velocity_n0;
-  Kokkos::View<RealArray1D<nbmatmax>*> m_speed_velocity_env_n0;
+  MaterialView m_speed_velocity_env_n0;
 
  public:
   Initialisations(
@@ -121,6 +122,7 @@ class Initialisations {
   void initSubVol() noexcept;
   // initialisation des variables VNR
   void initVar() noexcept;
+  size_t getAllocatedBytes() const noexcept;
   void initInternalEnergy() noexcept;
 
   void initVarSOD() noexcept;
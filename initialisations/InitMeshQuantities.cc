@@ -129,7 +129,7 @@ void Initialisations::initMeshGeometryForFaces() noexcept {
                cCellsOfFaceF++) {
             int cId(cellsOfFaceF[cCellsOfFaceF]);
             int cCells(cId);
-            int fFacesOfCellC(utils::indexOf(mesh->getFacesOfCell(cId), fId));
+            int fFacesOfCellC(mesh->getFaceSlotOfCell(cId, fId));
             varlp->outerFaceNormal(cCells, fFacesOfCellC) =
                 (((X_face - m_cell_coord_n0(cCells))) /
                  MathFunctions::norm((X_face - m_cell_coord_n0(cCells))));
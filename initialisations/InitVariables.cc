@@ -6,6 +6,7 @@
 #include <iostream>         // for operator<<, basic_ostream::ope...
 #include <vector>           // for allocator, vector
 
+#include "../includes/TailleMemoire.h"  // for allocatedBytes
 #include "Init.h"
 
 #include "mesh/CartesianMesh2D.h"  // for CartesianMesh2D
@@ -156,6 +157,35 @@ void Initialisations::initVar() noexcept {
       varlp->mixte(cCells) = 0;
       varlp->pure(cCells) = imatpure;
     }
+    // repartition des grandeurs par materiau (construite par le schema apres
+    // initVar) : une maille n'est rangee pure que si un seul materiau a une
+    // fraction volumique non nulle, les fractions sous le seuil sont gardees
+    int nbMatNonNuls(0);
+    int imatNonNul(-1);
+    for (int imat = 0; imat < nbmatmax; imat++)
+      if (m_fracvol_env_n0(cCells)[imat] > 0.) {
+        nbMatNonNuls++;
+        imatNonNul = imat;
+      }
+    varlp->layout.cellMaterial(cCells) = (nbMatNonNuls == 1 ? imatNonNul : -1);
   });
 }
+/**
+ *******************************************************************************
+ * \file getAllocatedBytes()
+ * \brief taille memoire des tableaux de l'initialisation
+ *******************************************************************************
+ */
+size_t Initialisations::getAllocatedBytes() const noexcept {
+  return allocatedBytes(m_node_coord_n0, m_cell_coord_n0, m_euler_volume_n0,
+                        m_density_n0, m_density_env_n0, m_internal_energy_n0,
+                        m_internal_energy_env_n0, m_node_velocity_n0,
+                        m_mass_fraction_env_n0, m_fracvol_env_n0,
+                        m_cell_perimeter_n0, m_cell_velocity_n0,
+                        m_node_force_n0, m_node_cellvolume_n0, m_pressure_n0,
+                        m_pressure_env_n0, m_pseudo_viscosity_n0,
+                        m_pseudo_viscosity_env_n0, m_tau_density_n0,
+                        m_tau_density_env_n0, m_divu_n0, m_speed_velocity_n0,
+                        m_speed_velocity_env_n0);
+}
 }  // namespace initlib
@@ -123,6 +123,18 @@ void LectureDonneesClass::LectureDonnees(
         mesdonnees.ignore();
       }
 
+      else if (!strcmp(motcle, "PARCOURS_NOEUDS")) {
+        mesdonnees >> valeur;
+        if (numerotation.find(valeur) == numerotation.end()) {
+          cout << "ERREUR: PARCOURS_NOEUDS " << valeur
+               << " inconnu (lexicographique, morton ou hilbert)" << endl;
+          exit(1);
+        }
+        cstmesh->ordering = numerotation[valeur];
+        std::cout << " Parcours des noeuds " << valeur << std::endl;
+        mesdonnees.ignore();
+      }
+
       else if (!strcmp(motcle, "TFIN")) {
         mesdonnees >> gt->final_time;
         std::cout << " Temps-final " << gt->final_time << std::endl;
@@ -158,6 +170,20 @@ void LectureDonneesClass::LectureDonnees(
         }
       }
 
+      else if (!strcmp(motcle, "FICHIER_EOS")) {
+        // un nom de fichier par materiau, lu seulement pour les lois Tabulee
+        for (int imat = 0; imat < o->nbmat; ++imat) {
+          string fichier;
+          mesdonnees >> fichier;
+          if (eos->Nom[imat] == eos->Tabulee) {
+            eos->table[imat].lecture(fichier);
+            std::cout << " Table d'etat " << fichier << " ( materiau " << imat
+                      << " ) " << std::endl;
+          }
+        }
+        mesdonnees.ignore();
+      }
+
       else if (!strcmp(motcle, "SCHEMA_LAGRANGE")) {
         mesdonnees >> valeur;
         s->schema = schema_lagrange[valeur];
@@ -199,6 +225,25 @@ void LectureDonneesClass::LectureDonnees(
         mesdonnees.ignore();
       }
 
+      else if (!strcmp(motcle, "FREQUENCE_BILAN")) {
+        mesdonnees >> o->frequenceBilan;
+        if (o->frequenceBilan < 1) {
+          cout << "ERREUR: FREQUENCE_BILAN doit etre au moins 1" << endl;
+          exit(1);
+        }
+        std::cout << " Bilans de conservation tous les " << o->frequenceBilan
+                  << " cycles" << std::endl;
+        mesdonnees.ignore();
+      }
+
+      else if (!strcmp(motcle, "FORCES_MATERIAUX_RECALCULEES")) {
+        mesdonnees >> valeur;
+        o->forcesMateriauxRecalculees = ouiOUnon[valeur];
+        std::cout << " Forces par materiau recalculees " << valeur << " ( "
+                  << o->forcesMateriauxRecalculees << " ) " << std::endl;
+        mesdonnees.ignore();
+      }
+
       else if (!strcmp(motcle, "ORDRE_PROJECTION")) {
         mesdonnees >> o->projectionOrder;
         std::cout << " Ordre de la phase de projection  " << o->projectionOrder
@@ -295,6 +340,7 @@ void LectureDonneesClass::LectureDonnees(
             so->fraction_volumique = true;
           if (!strcmp(variables, "interface")) so->interface = true;
           if (!strcmp(variables, "vitesse")) so->vitesse = true;
+          if (!strcmp(variables, "pas_de_temps")) so->pas_de_temps = true;
           mesdonnees >> variables;
         }
         mesdonnees.ignore();
@@ -303,6 +349,13 @@ void LectureDonneesClass::LectureDonnees(
         exit(1);
       }
     }
+    for (int imat = 0; imat < o->nbmat; ++imat) {
+      if (eos->Nom[imat] == eos->Tabulee && !eos->table[imat].estChargee()) {
+        cout << "ERREUR: loi Tabulee sans FICHIER_EOS pour le materiau "
+             << imat << endl;
+        exit(1);
+      }
+    }
   } else {
     cout << "ERREUR: Impossible d'ouvrir le fichier en lecture." << endl;
     exit(1);
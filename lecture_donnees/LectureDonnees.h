@@ -45,13 +45,17 @@ class LectureDonneesClass {
 
   std::unordered_map<string, int> ouiOUnon{{"non", 0}, {"oui", 1}};
 
+  std::unordered_map<string, int> numerotation{
+      {"lexicographique", 0}, {"morton", 1}, {"hilbert", 2}};
+
   std::unordered_map<string, int> A1OUA2OUPB{{"A1", 0}, {"A2", 1}, {"PB", 2}};
 
   std::unordered_map<string, int> liste_eos{{"Void", 100},
                                             {"PerfectGas", 101},
                                             {"StiffenedGas", 102},
                                             {"Fictif", 103},
-                                            {"SolidLinear", 104}};
+                                            {"SolidLinear", 104},
+                                            {"Tabulee", 105}};
 
   std::unordered_map<string, int> equilibrage{
       {"sans", 0}, {"Isotherme", 1}, {"Adiabatique", 2}};
@@ -7,6 +7,7 @@
 #include "lecture_donnees/LectureDonnees.h"  // for LectureDonnees
 #include "mesh/CartesianMesh2D.h"            // for CartesianMesh2D
 #include "mesh/CartesianMesh2DGenerator.h"   // for CartesianMesh2DGenerator
+#include "utils/Utils.h"                     // for Timer
 
 using namespace nablalib;
 
@@ -44,9 +45,16 @@ int main(int argc, char* argv[]) {
     exit(1);
   }
   // chargement du maillage
+  utils::Timer mesh_timer(true);
   auto nm = CartesianMesh2DGenerator::generate(
       cstmesh->X_EDGE_ELEMS, cstmesh->Y_EDGE_ELEMS, cstmesh->X_EDGE_LENGTH,
-      cstmesh->Y_EDGE_LENGTH, cstmesh->cylindrical_mesh, cstmesh->minimum_radius);
+      cstmesh->Y_EDGE_LENGTH, cstmesh->cylindrical_mesh, cstmesh->minimum_radius,
+      cstmesh->ordering);
+  mesh_timer.stop();
+  std::cout << "[" << __GREEN__ << "MESH" << __RESET__ << "]     "
+            << cstmesh->X_EDGE_ELEMS << "x" << cstmesh->Y_EDGE_ELEMS
+            << " generated in " << __BLUE__ << mesh_timer.print(true)
+            << __RESET__ << std::endl;
 
   // appel au schéma Lagrange Eucclhyd + schéma de projection ADI (en option)
   if (scheme->schema == scheme->Eucclhyd) {
@@ -8,6 +8,7 @@
 #include "../includes/Constantes.h"
 #include "../includes/CstMesh.h"
 #include "../includes/GestionTemps.h"
+#include "../includes/MaterialView.h"
 #include "mesh/CartesianMesh2D.h"  // for CartesianMesh2D
 
 using namespace nablalib;
@@ -57,14 +58,14 @@ class SchemaParticules {
   Kokkos::View<double*> m_cell_particle_volume_fraction;
   Kokkos::View<vector<int>*> m_cell_particle_list;
   // variables du schéma eucclhyd ou VNR
-  Kokkos::View<RealArray1D<nbmatmax>*> m_particlecell_fracvol_env;
+  MaterialView m_particlecell_fracvol_env;
   Kokkos::View<RealArray1D<dim>**> m_particlecell_fracvol_gradient_env;
   Kokkos::View<double*> m_particlecell_euler_volume;
   Kokkos::View<RealArray1D<dim>*> m_particlecell_velocity_n;
   Kokkos::View<RealArray1D<dim>*> m_particlecell_velocity_nplus1;
   Kokkos::View<double*> m_particlecell_mass;
   Kokkos::View<double*> m_particlecell_density_n;
-  Kokkos::View<RealArray1D<nbmatmax>*> m_particlecell_density_env_n;
+  MaterialView m_particlecell_density_env_n;
   Kokkos::View<RealArray1D<dim>*> m_particlecell_pressure_gradient;
 
  public:
@@ -13,6 +13,45 @@
 #include "types/MathFunctions.h"   // for dot
 #include "types/MultiArray.h"      // for operator<<
 #include "utils/Utils.h"           // for indexOf
+/**
+ *******************************************************************************
+ * \file computeDualGradPhi()
+ * \brief calcul des gradients limites des variables duales, horizontaux ou
+ *        verticaux, par computeDualHorizontalGradPhi ou
+ *        computeDualVerticalGradPhi instancies pour le limiteur de la
+ *        projection
+ * \param  varlp->DualPhi, horizontal
+ * \return gradDualPhi
+ *******************************************************************************
+ */
+template <class Limiteur>
+void Remap::computeDualGradPhi(
+    const Kokkos::View<RealArray1D<nbequamax>*>& gradDualPhi,
+    const bool horizontal) noexcept {
+  if (horizontal) {
+    Kokkos::parallel_for(nbNodes, KOKKOS_LAMBDA(const size_t& pNode) {
+      RealArray1D<nbequamax> grad_right = Uzero;
+      RealArray1D<nbequamax> grad_left = Uzero;
+      gradDualPhi(pNode) =
+          computeDualHorizontalGradPhi<Limiteur>(grad_right, grad_left, pNode);
+    });
+  } else {
+    Kokkos::parallel_for(nbNodes, KOKKOS_LAMBDA(const size_t& pNode) {
+      RealArray1D<nbequamax> grad_up = Uzero;
+      RealArray1D<nbequamax> grad_down = Uzero;
+      gradDualPhi(pNode) =
+          computeDualVerticalGradPhi<Limiteur>(grad_up, grad_down, pNode);
+    });
+  }
+}
+void Remap::computeDualGradPhi(
+    const Kokkos::View<RealArray1D<nbequamax>*>& gradDualPhi,
+    const bool horizontal) noexcept {
+  limiteurslib::dispatchLimiteur(
+      limiteurs->projectionLimiterId, [&](auto limiteur) {
+        computeDualGradPhi<decltype(limiteur)>(gradDualPhi, horizontal);
+      });
+}
 /**
  *******************************************************************************
  * \file computeDualUremap1()
@@ -30,23 +69,19 @@
  * \return UDualremap1, varlp->DualPhi
  *******************************************************************************
  */
+template <int NBMAT>
 void Remap::computeDualUremap1() noexcept {
   if (varlp->x_then_y_n) {
     if (options->projectionOrder > 1) {
       // calcul des gradients de vitesses
-      Kokkos::parallel_for(nbNodes, KOKKOS_LAMBDA(const size_t& pNode) {
-        RealArray1D<nbequamax> grad_right = Uzero;
-        RealArray1D<nbequamax> grad_left = Uzero;
-        gradDualPhi1(pNode) =
-            computeDualHorizontalGradPhi(grad_right, grad_left, pNode);
-      });
+      computeDualGradPhi(gradDualPhi1, true);
     } else {
       Kokkos::parallel_for(nbNodes, KOKKOS_LAMBDA(const size_t& pNode) {
         gradDualPhi1(pNode) = Uzero;
       });
     }
     Kokkos::parallel_for(nbNodes, KOKKOS_LAMBDA(const size_t& pNode) {
-      int nbmat = options->nbmat;
+      constexpr int nbmat = NBMAT;
       if (options->methode_flux_masse == 0)
         getRightAndLeftFluxMasse1(nbmat, pNode);
 
@@ -66,6 +101,10 @@ void Remap::computeDualUremap1() noexcept {
 
         int LeftNode = mesh->getLeftNode(pNode);
         int RightNode = mesh->getRightNode(pNode);
+        // noeud de bord sans voisin : le flux de masse y est nul, on
+        // decentre sur le noeud lui-meme plutot que de lire le noeud -1
+        if (LeftNode < 0) LeftNode = pNode;
+        if (RightNode < 0) RightNode = pNode;
         getLeftUpwindVelocity(LeftNode, pNode, gradDualPhi1(LeftNode),
                               gradDualPhi1(pNode));
         getRightUpwindVelocity(RightNode, pNode, gradDualPhi1(RightNode),
@@ -92,19 +131,14 @@ void Remap::computeDualUremap1() noexcept {
     // projection verticale
     if (options->projectionOrder > 1) {
       // calcul des gradients de vitesses
-      Kokkos::parallel_for(nbNodes, KOKKOS_LAMBDA(const size_t& pNode) {
-        RealArray1D<nbequamax> grad_up = Uzero;
-        RealArray1D<nbequamax> grad_down = Uzero;
-        gradDualPhi1(pNode) =
-            computeDualVerticalGradPhi(grad_up, grad_down, pNode);
-      });
+      computeDualGradPhi(gradDualPhi1, false);
     } else {
       Kokkos::parallel_for(nbNodes, KOKKOS_LAMBDA(const size_t& pNode) {
         gradDualPhi1(pNode) = Uzero;
       });
     }
     Kokkos::parallel_for(nbNodes, KOKKOS_LAMBDA(const size_t& pNode) {
-      int nbmat = options->nbmat;
+      constexpr int nbmat = NBMAT;
       if (options->methode_flux_masse == 0)
         getTopAndBottomFluxMasse1(nbmat, pNode);
       if (options->methode_flux_masse == 1)
@@ -123,6 +157,10 @@ void Remap::computeDualUremap1() noexcept {
 
         int TopNode = mesh->getTopNode(pNode);
         int BottomNode = mesh->getBottomNode(pNode);
+        // noeud de bord sans voisin : le flux de masse y est nul, on
+        // decentre sur le noeud lui-meme plutot que de lire le noeud -1
+        if (TopNode < 0) TopNode = pNode;
+        if (BottomNode < 0) BottomNode = pNode;
         getBottomUpwindVelocity(BottomNode, pNode, gradDualPhi1(BottomNode),
                                 gradDualPhi1(pNode));
         getTopUpwindVelocity(TopNode, pNode, gradDualPhi1(TopNode),
@@ -155,3 +193,8 @@ void Remap::computeDualUremap1() noexcept {
     varlp->DualPhi(pNode)[2] = UDualremap1(pNode)[2] / UDualremap1(pNode)[3];
   });
 }
+void Remap::computeDualUremap1() noexcept {
+  dispatchNbMat(options->nbmat, [this](auto nbmat) {
+    computeDualUremap1<decltype(nbmat)::value>();
+  });
+}
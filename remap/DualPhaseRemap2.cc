@@ -30,18 +30,14 @@
  * \return varlp->UDualremap2
  *******************************************************************************
  */
+template <int NBMAT>
 void Remap::computeDualUremap2() noexcept {
   // calcul des flux de masses partielles
   if (varlp->x_then_y_n) {
     // projection verticale
     if (options->projectionOrder > 1) {
       // calcul des gradients de vitesses
-      Kokkos::parallel_for(nbNodes, KOKKOS_LAMBDA(const size_t& pNode) {
-        RealArray1D<nbequamax> grad_up = Uzero;
-        RealArray1D<nbequamax> grad_down = Uzero;
-        gradDualPhi2(pNode) =
-            computeDualVerticalGradPhi(grad_up, grad_down, pNode);
-      });
+      computeDualGradPhi(gradDualPhi2, false);
     } else {
       Kokkos::parallel_for(nbNodes, KOKKOS_LAMBDA(const size_t& pNode) {
         gradDualPhi2(pNode) = Uzero;
@@ -49,7 +45,7 @@ void Remap::computeDualUremap2() noexcept {
     }
 
     Kokkos::parallel_for(nbNodes, KOKKOS_LAMBDA(const size_t& pNode) {
-      int nbmat = options->nbmat;
+      constexpr int nbmat = NBMAT;
       if (options->methode_flux_masse == 0)
         getTopAndBottomFluxMasse2(nbmat, pNode);
 
@@ -70,6 +66,10 @@ void Remap::computeDualUremap2() noexcept {
 
         int TopNode = mesh->getTopNode(pNode);
         int BottomNode = mesh->getBottomNode(pNode);
+        // noeud de bord sans voisin : le flux de masse y est nul, on
+        // decentre sur le noeud lui-meme plutot que de lire le noeud -1
+        if (TopNode < 0) TopNode = pNode;
+        if (BottomNode < 0) BottomNode = pNode;
         getBottomUpwindVelocity(BottomNode, pNode, gradDualPhi2(BottomNode),
                                 gradDualPhi2(pNode));
         getTopUpwindVelocity(TopNode, pNode, gradDualPhi2(TopNode),
@@ -96,19 +96,14 @@ void Remap::computeDualUremap2() noexcept {
     // projection horizontale
     if (options->projectionOrder > 1) {
       // calcul des gradients de vitesses
-      Kokkos::parallel_for(nbNodes, KOKKOS_LAMBDA(const size_t& pNode) {
-        RealArray1D<nbequamax> grad_right = Uzero;
-        RealArray1D<nbequamax> grad_left = Uzero;
-        gradDualPhi2(pNode) =
-            computeDualHorizontalGradPhi(grad_right, grad_left, pNode);
-      });
+      computeDualGradPhi(gradDualPhi2, true);
     } else {
       Kokkos::parallel_for(nbNodes, KOKKOS_LAMBDA(const size_t& pNode) {
         gradDualPhi2(pNode) = Uzero;
       });
     }
     Kokkos::parallel_for(nbNodes, KOKKOS_LAMBDA(const size_t& pNode) {
-      int nbmat = options->nbmat;
+      constexpr int nbmat = NBMAT;
       if (options->methode_flux_masse == 0)
         getRightAndLeftFluxMasse2(nbmat, pNode);
 
@@ -128,6 +123,10 @@ void Remap::computeDualUremap2() noexcept {
         // gauche) si LeftFluxMasse(pNode) > 0 et vitesse(pNode) sinon
         int LeftNode = mesh->getLeftNode(pNode);
         int RightNode = mesh->getRightNode(pNode);
+        // noeud de bord sans voisin : le flux de masse y est nul, on
+        // decentre sur le noeud lui-meme plutot que de lire le noeud -1
+        if (LeftNode < 0) LeftNode = pNode;
+        if (RightNode < 0) RightNode = pNode;
         getLeftUpwindVelocity(LeftNode, pNode, gradDualPhi2(LeftNode),
                               gradDualPhi2(pNode));
         getRightUpwindVelocity(RightNode, pNode, gradDualPhi2(RightNode),
@@ -152,3 +151,8 @@ void Remap::computeDualUremap2() noexcept {
     });
   }
 }
+void Remap::computeDualUremap2() noexcept {
+  dispatchNbMat(options->nbmat, [this](auto nbmat) {
+    computeDualUremap2<decltype(nbmat)::value>();
+  });
+}
@@ -6,7 +6,7 @@ int nbfaces(0);
 if (VerticalFaceOfNode(pNodes)[0] != -1) {
   // pour la premiere face verticale
   size_t fId1(VerticalFaceOfNode(pNodes)[0]);
-  fFace1 = utils::indexOf(mesh->getFaces(), fId1);
+  fFace1 = mesh->getFaceIndex(fId1);
   // on recupere la cellule devant
   int cfFrontCellF1(mesh->getFrontCell(fId1));
   int cfId1(cfFrontCellF1);
@@ -14,10 +14,10 @@ if (VerticalFaceOfNode(pNodes)[0] != -1) {
   // on recupere la face à droite de la cellule devant
   int frRightFaceOfCfCell1(mesh->getRightFaceOfCell(cfId1));
   size_t frId1(frRightFaceOfCfCell1);
-  frFace1 = utils::indexOf(mesh->getFaces(), frId1);
+  frFace1 = mesh->getFaceIndex(frId1);
 
-  fOfcfCell1 = utils::indexOf(mesh->getFacesOfCell(cfId1), fId1);
-  frOfcfCell1 = utils::indexOf(mesh->getFacesOfCell(cfId1), frId1);
+  fOfcfCell1 = mesh->getFaceSlotOfCell(cfId1, fId1);
+  frOfcfCell1 = mesh->getFaceSlotOfCell(cfId1, frId1);
 
   // on recupere la cellule derriere
   int cbBackCellF1(mesh->getBackCell(fId1));
@@ -26,17 +26,17 @@ if (VerticalFaceOfNode(pNodes)[0] != -1) {
   // on recupere la face à gauche de la cellule derriere
   int flLeftFaceOfcbCell1(mesh->getLeftFaceOfCell(cbId1));
   size_t flId1(flLeftFaceOfcbCell1);
-  flFace1 = utils::indexOf(mesh->getFaces(), flId1);
+  flFace1 = mesh->getFaceIndex(flId1);
 
-  fOfcbCell1 = utils::indexOf(mesh->getFacesOfCell(cbId1), fId1);
-  flOfcbCell1 = utils::indexOf(mesh->getFacesOfCell(cbId1), flId1);
+  fOfcbCell1 = mesh->getFaceSlotOfCell(cbId1, fId1);
+  flOfcbCell1 = mesh->getFaceSlotOfCell(cbId1, flId1);
 
   nbfaces = nbfaces + 2;
 }
 if (VerticalFaceOfNode(pNodes)[1] != -1) {
   // pour la seconde face verticale
   size_t fId2(VerticalFaceOfNode(pNodes)[1]);
-  fFace2 = utils::indexOf(mesh->getFaces(), fId2);
+  fFace2 = mesh->getFaceIndex(fId2);
   // on recupere la cellule devant
   int cfFrontCellF2(mesh->getFrontCell(fId2));
   int cfId2(cfFrontCellF2);
@@ -44,9 +44,9 @@ if (VerticalFaceOfNode(pNodes)[1] != -1) {
   // on recupere la face à droite de la cellule devant
   int frRightFaceOfCfCell2(mesh->getRightFaceOfCell(cfId2));
   size_t frId2(frRightFaceOfCfCell2);
-  frFace2 = utils::indexOf(mesh->getFaces(), frId2);
-  fOfcfCell2 = utils::indexOf(mesh->getFacesOfCell(cfId2), fId2);
-  frOfcfCell2 = utils::indexOf(mesh->getFacesOfCell(cfId2), frId2);
+  frFace2 = mesh->getFaceIndex(frId2);
+  fOfcfCell2 = mesh->getFaceSlotOfCell(cfId2, fId2);
+  frOfcfCell2 = mesh->getFaceSlotOfCell(cfId2, frId2);
 
   // on recupere la cellule derriere
   int cbBackCellF2(mesh->getBackCell(fId2));
@@ -55,8 +55,8 @@ if (VerticalFaceOfNode(pNodes)[1] != -1) {
   // on recupere la face à gauche de la cellule derriere
   int flLeftFaceOfcbCell2(mesh->getLeftFaceOfCell(cbId2));
   size_t flId2(flLeftFaceOfcbCell2);
-  flFace2 = utils::indexOf(mesh->getFaces(), flId2);
-  fOfcbCell2 = utils::indexOf(mesh->getFacesOfCell(cbId2), fId2);
-  flOfcbCell2 = utils::indexOf(mesh->getFacesOfCell(cbId2), flId2);
+  flFace2 = mesh->getFaceIndex(flId2);
+  fOfcbCell2 = mesh->getFaceSlotOfCell(cbId2, fId2);
+  flOfcbCell2 = mesh->getFaceSlotOfCell(cbId2, flId2);
   nbfaces = nbfaces + 2;
 }
@@ -9,7 +9,7 @@ if (HorizontalFaceOfNode(pNodes)[0] != -1) {
   // attention FrontCell est en dessous
   // pour la premiere face horizontale
   size_t fId1(HorizontalFaceOfNode(pNodes)[0]);
-  fFace1 = utils::indexOf(mesh->getFaces(), fId1);
+  fFace1 = mesh->getFaceIndex(fId1);
 
   // on recupere la cellule au dessus
   int cbBackCellF1(mesh->getBackCell(fId1));
@@ -18,10 +18,10 @@ if (HorizontalFaceOfNode(pNodes)[0] != -1) {
   // on recupere la face au dessus de la cellule au dessus
   int ftTopFaceOfCbCell1(mesh->getTopFaceOfCell(cbId1));
   size_t ftId1(ftTopFaceOfCbCell1);
-  ftFace1 = utils::indexOf(mesh->getFaces(), ftId1);
+  ftFace1 = mesh->getFaceIndex(ftId1);
 
-  fOfcbCell1 = utils::indexOf(mesh->getFacesOfCell(cbId1), fId1);
-  ftOfcbCell1 = utils::indexOf(mesh->getFacesOfCell(cbId1), ftId1);
+  fOfcbCell1 = mesh->getFaceSlotOfCell(cbId1, fId1);
+  ftOfcbCell1 = mesh->getFaceSlotOfCell(cbId1, ftId1);
 
   // on recupere la cellule en dessous
   int cfFrontCellF1(mesh->getFrontCell(fId1));
@@ -30,10 +30,10 @@ if (HorizontalFaceOfNode(pNodes)[0] != -1) {
   // on recupere la face en dessous de la cellule en dessous
   int fbBottomFaceOfCell1(mesh->getBottomFaceOfCell(cfId1));
   size_t fbId1(fbBottomFaceOfCell1);
-  fbFace1 = utils::indexOf(mesh->getFaces(), fbId1);
+  fbFace1 = mesh->getFaceIndex(fbId1);
 
-  fOfcfCell1 = utils::indexOf(mesh->getFacesOfCell(cfId1), fId1);
-  fbOfcfCell1 = utils::indexOf(mesh->getFacesOfCell(cfId1), fbId1);
+  fOfcfCell1 = mesh->getFaceSlotOfCell(cfId1, fId1);
+  fbOfcfCell1 = mesh->getFaceSlotOfCell(cfId1, fbId1);
 
   nbfaces = nbfaces + 2;
 }
@@ -43,7 +43,7 @@ if (HorizontalFaceOfNode(pNodes)[1] != -1) {
   // attention FrontCell est en dessous
   // pour la seconde face horizontale
   size_t fId2(HorizontalFaceOfNode(pNodes)[1]);
-  fFace2 = utils::indexOf(mesh->getFaces(), fId2);
+  fFace2 = mesh->getFaceIndex(fId2);
 
   // on recupere la cellule au dessus
   int cbBackCellF2(mesh->getBackCell(fId2));
@@ -52,10 +52,10 @@ if (HorizontalFaceOfNode(pNodes)[1] != -1) {
   // on recupere la face au dessus de la cellule au dessus
   int ftTopFaceOfCfCells2(mesh->getTopFaceOfCell(cbId2));
   size_t ftId2(ftTopFaceOfCfCells2);
-  ftFace2 = utils::indexOf(mesh->getFaces(), ftId2);
+  ftFace2 = mesh->getFaceIndex(ftId2);
 
-  fOfcbCell2 = utils::indexOf(mesh->getFacesOfCell(cbId2), fId2);
-  ftOfcbCell2 = utils::indexOf(mesh->getFacesOfCell(cbId2), ftId2);
+  fOfcbCell2 = mesh->getFaceSlotOfCell(cbId2, fId2);
+  ftOfcbCell2 = mesh->getFaceSlotOfCell(cbId2, ftId2);
 
   // on recupere la cellule en dessous "cf"
   int cfFrontCellF2(mesh->getFrontCell(fId2));
@@ -64,10 +64,10 @@ if (HorizontalFaceOfNode(pNodes)[1] != -1) {
   // on recupere la face en dessous de la cellule en dessous
   int fbBottomFaceOfCell2(mesh->getBottomFaceOfCell(cfId2));
   size_t fbId2(fbBottomFaceOfCell2);
-  fbFace2 = utils::indexOf(mesh->getFaces(), fbId2);
+  fbFace2 = mesh->getFaceIndex(fbId2);
 
-  fOfcfCell2 = utils::indexOf(mesh->getFacesOfCell(cfId2), fId2);
-  fbOfcfCell2 = utils::indexOf(mesh->getFacesOfCell(cfId2), fbId2);
+  fOfcfCell2 = mesh->getFaceSlotOfCell(cfId2, fId2);
+  fbOfcfCell2 = mesh->getFaceSlotOfCell(cfId2, fbId2);
 
   nbfaces = nbfaces + 2;
 }
@@ -0,0 +1,280 @@
+#ifndef LIMITEURSPROJECTION_H
+#define LIMITEURSPROJECTION_H
+
+#include <math.h>  // for fabs
+
+#include <Kokkos_Core.hpp>  // for KOKKOS_INLINE_FUNCTION
+
+#include "../includes/Freefunctions.h"  // for divideNoExcept
+#include "../includes/Limiteurs.h"      // for LimiteursClass
+#include "types/MathFunctions.h"        // for min, max
+
+/**
+ *******************************************************************************
+ * limiteurs de la projection
+ *   le limiteur est choisi une seule fois par dispatchLimiteur et les noyaux
+ *   de projection sont instancies pour chaque limiteur : les boucles sur les
+ *   variables projetees ne testent plus l'identifiant du limiteur.
+ *   Chaque limiteur fournit
+ *     gradient : la pente limitee a partir des gradients aval (gradplus) et
+ *                amont (gradmoins), des valeurs y0, yplus, ymoins et des
+ *                largeurs h0, hplus, hmoins des 3 mailles
+ *     seuils   : les seuils de monotonie y0plus, y0moins des reconstructions
+ *                lineaires simple-pente pour l'option pente-borne
+ *******************************************************************************
+ */
+namespace limiteurslib {
+
+/**
+ * methode classique qui suppose que les 3 mailles ont la meme largeur,
+ * Limiteur::phi(r) est la valeur du limiteur pour
+ * r = gradmoins / gradplus ou gradplus / gradmoins
+ */
+template <class Limiteur>
+struct LimiteurClassique {
+  KOKKOS_INLINE_FUNCTION static double gradient(double gradplus,
+                                                double gradmoins, double y0,
+                                                double yplus, double ymoins,
+                                                double h0, double hplus,
+                                                double hmoins) {
+    return (Limiteur::phi(divideNoExcept(gradplus, gradmoins)) * gradmoins +
+            Limiteur::phi(divideNoExcept(gradmoins, gradplus)) * gradplus) /
+           2.0;
+  }
+};
+
+/**
+ * methode exacte qui ne suppose pas que les 3 mailles ont la meme largeur
+ * (h0 != hplus != hmoins), Limiteur::pente est la pente avant limitation
+ * simple-pente
+ */
+template <class Limiteur>
+struct LimiteurGeneralise {
+  KOKKOS_INLINE_FUNCTION static double gradient(double gradplus,
+                                                double gradmoins, double y0,
+                                                double yplus, double ymoins,
+                                                double h0, double hplus,
+                                                double hmoins) {
+    double grady, gradM, gradMplus, gradMmoins;
+    // limitation rupture de pente (formule 16 si on utilise pas le plateau
+    // pente)
+    if (gradplus * gradmoins < 0.0) return 0.;
+
+    grady = Limiteur::pente(gradplus, gradmoins, yplus, ymoins, h0, hplus,
+                            hmoins);
+    // limitation simple-pente (formule 10)
+    gradMplus = gradplus * (h0 + hplus) / h0;
+    gradMmoins = gradmoins * (h0 + hmoins) / h0;
+    gradM = MathFunctions::min(fabs(gradMplus), fabs(gradMmoins));
+    if ((yplus - ymoins) > 0.)
+      grady = MathFunctions::min(fabs(gradM), fabs(grady));
+    else
+      grady = -MathFunctions::min(fabs(gradM), fabs(grady));
+
+    return grady;
+  }
+};
+
+// seuils de monotonie, communs aux methodes classique et exacte
+struct SeuilsOrdre1 {
+  KOKKOS_INLINE_FUNCTION static void seuils(double yplus, double ymoins,
+                                            double h0, double hplus,
+                                            double hmoins, double& y0plus,
+                                            double& y0moins) {
+    y0plus = 0.;
+    y0moins = 0.;
+  }
+};
+
+struct SeuilsMinmod {
+  KOKKOS_INLINE_FUNCTION static void seuils(double yplus, double ymoins,
+                                            double h0, double hplus,
+                                            double hmoins, double& y0plus,
+                                            double& y0moins) {
+    y0plus = yplus;
+    y0moins = ymoins;
+  }
+};
+
+struct SeuilsSuperBee {
+  KOKKOS_INLINE_FUNCTION static void seuils(double yplus, double ymoins,
+                                            double h0, double hplus,
+                                            double hmoins, double& y0plus,
+                                            double& y0moins) {
+    y0plus = ((h0 + hmoins) * yplus + h0 * ymoins) / (2 * h0 + hmoins);
+    y0moins = ((h0 + hplus) * ymoins + h0 * yplus) / (2 * h0 + hplus);
+  }
+};
+
+struct SeuilsVanLeer {
+  KOKKOS_INLINE_FUNCTION static void seuils(double yplus, double ymoins,
+                                            double h0, double hplus,
+                                            double hmoins, double& y0plus,
+                                            double& y0moins) {
+    double a = MathFunctions::min(yplus, ymoins);
+    double b = MathFunctions::max(yplus, ymoins);
+    double xplus = (h0 * h0 + 3 * h0 * hmoins + 2 * hmoins * hmoins) * yplus;
+    double xmoins = (h0 * h0 + 3 * h0 * hplus + 2 * hplus * hplus) * ymoins;
+    xplus +=
+        (h0 * h0 - h0 * hplus - 2 * hplus * hplus + 2 * h0 * hmoins) * ymoins;
+    xmoins +=
+        (h0 * h0 - h0 * hmoins - 2 * hmoins * hmoins + 2 * h0 * hplus) * yplus;
+    xplus /= (2 * h0 * h0 + 5 * h0 * hmoins + 2 * hmoins * hmoins - h0 * hplus -
+              2 * hplus * hplus);
+    xmoins /= (2 * h0 * h0 + 5 * h0 * hplus + 2 * hplus * hplus - h0 * hmoins -
+               2 * hmoins * hmoins);
+
+    y0plus = MathFunctions::min(MathFunctions::max(xplus, a), b);
+    y0moins = MathFunctions::min(MathFunctions::max(xmoins, a), b);
+  }
+};
+
+struct SeuilsUltrabee {
+  KOKKOS_INLINE_FUNCTION static void seuils(double yplus, double ymoins,
+                                            double h0, double hplus,
+                                            double hmoins, double& y0plus,
+                                            double& y0moins) {
+    y0plus = (yplus + ymoins) / 2.;
+    y0moins = (yplus + ymoins) / 2.;
+  }
+};
+
+struct SeuilsArithmetic {
+  KOKKOS_INLINE_FUNCTION static void seuils(double yplus, double ymoins,
+                                            double h0, double hplus,
+                                            double hmoins, double& y0plus,
+                                            double& y0moins) {
+    y0plus = ((h0 + hmoins + hplus) * yplus + h0 * ymoins) /
+             (2 * h0 + hmoins + hplus);
+    y0moins = ((h0 + hmoins + hplus) * ymoins + h0 * yplus) /
+              (2 * h0 + hmoins + hplus);
+  }
+};
+
+// ordre 1 : pente nulle (identifiant non reconnu)
+struct Ordre1 : LimiteurClassique<Ordre1>, SeuilsOrdre1 {
+  KOKKOS_INLINE_FUNCTION static double phi(double r) { return 0.0; }
+};
+
+struct Minmod : LimiteurClassique<Minmod>, SeuilsMinmod {
+  KOKKOS_INLINE_FUNCTION static double phi(double r) {
+    return MathFunctions::max(0.0, MathFunctions::min(1.0, r));
+  }
+};
+
+struct SuperBee : LimiteurClassique<SuperBee>, SeuilsSuperBee {
+  KOKKOS_INLINE_FUNCTION static double phi(double r) {
+    return MathFunctions::max(
+        0.0, MathFunctions::max(MathFunctions::min(2.0 * r, 1.0),
+                                MathFunctions::min(r, 2.0)));
+  }
+};
+
+struct VanLeer : LimiteurClassique<VanLeer>, SeuilsVanLeer {
+  KOKKOS_INLINE_FUNCTION static double phi(double r) {
+    if (r <= 0.0)
+      return 0.0;
+    else
+      return 2.0 * r / (1.0 + r);
+  }
+};
+
+// formule 9c
+struct MinmodG : LimiteurGeneralise<MinmodG>, SeuilsMinmod {
+  KOKKOS_INLINE_FUNCTION static double pente(double gradplus,
+                                             double gradmoins, double yplus,
+                                             double ymoins, double h0,
+                                             double hplus, double hmoins) {
+    if ((yplus - ymoins) > 0.)
+      return MathFunctions::min(fabs(gradplus), fabs(gradmoins));
+    else
+      return -MathFunctions::min(fabs(gradplus), fabs(gradmoins));
+  }
+};
+
+// formule 9g
+struct SuperBeeG : LimiteurGeneralise<SuperBeeG>, SeuilsSuperBee {
+  KOKKOS_INLINE_FUNCTION static double pente(double gradplus,
+                                             double gradmoins, double yplus,
+                                             double ymoins, double h0,
+                                             double hplus, double hmoins) {
+    if ((yplus - ymoins) > 0.)
+      return MathFunctions::max(fabs(gradplus), fabs(gradmoins));
+    else
+      return -MathFunctions::max(fabs(gradplus), fabs(gradmoins));
+  }
+};
+
+// formule 9e
+struct VanLeerG : LimiteurGeneralise<VanLeerG>, SeuilsVanLeer {
+  KOKKOS_INLINE_FUNCTION static double pente(double gradplus,
+                                             double gradmoins, double yplus,
+                                             double ymoins, double h0,
+                                             double hplus, double hmoins) {
+    double lambdaplus = (h0 / 2. + hplus) / (h0 + hplus + hmoins);
+    double lambdamoins = (h0 / 2. + hmoins) / (h0 + hplus + hmoins);
+    if ((lambdaplus * gradplus + lambdamoins * gradmoins) != 0.)
+      return gradplus * gradmoins /
+             (lambdaplus * gradplus + lambdamoins * gradmoins);
+    else
+      return 0.;
+  }
+};
+
+struct ArithmeticG : LimiteurGeneralise<ArithmeticG>, SeuilsArithmetic {
+  KOKKOS_INLINE_FUNCTION static double pente(double gradplus,
+                                             double gradmoins, double yplus,
+                                             double ymoins, double h0,
+                                             double hplus, double hmoins) {
+    double lambdaplus = (h0 / 2. + hplus) / (h0 + hplus + hmoins);
+    double lambdamoins = (h0 / 2. + hmoins) / (h0 + hplus + hmoins);
+    return lambdamoins * gradplus + lambdaplus * gradmoins;
+  }
+};
+
+struct UltrabeeG : LimiteurGeneralise<UltrabeeG>, SeuilsUltrabee {
+  KOKKOS_INLINE_FUNCTION static double pente(double gradplus,
+                                             double gradmoins, double yplus,
+                                             double ymoins, double h0,
+                                             double hplus, double hmoins) {
+    return (yplus - ymoins) / h0;
+  }
+};
+
+/**
+ * appelle f avec le limiteur d'identifiant id (valeurs de Limiteurs)
+ */
+template <class Functor>
+KOKKOS_INLINE_FUNCTION void dispatchLimiteur(const int id, const Functor& f) {
+  using Limiteurs = LimiteursClass::Limiteurs;
+  switch (id) {
+    case Limiteurs::minmod:
+      f(Minmod());
+      break;
+    case Limiteurs::superBee:
+      f(SuperBee());
+      break;
+    case Limiteurs::vanLeer:
+      f(VanLeer());
+      break;
+    case Limiteurs::minmodG:
+      f(MinmodG());
+      break;
+    case Limiteurs::superBeeG:
+      f(SuperBeeG());
+      break;
+    case Limiteurs::vanLeerG:
+      f(VanLeerG());
+      break;
+    case Limiteurs::arithmeticG:
+      f(ArithmeticG());
+      break;
+    case Limiteurs::ultrabeeG:
+      f(UltrabeeG());
+      break;
+    default:
+      f(Ordre1());
+  }
+}
+}  // namespace limiteurslib
+#endif  // LIMITEURSPROJECTION_H
@@ -0,0 +1,501 @@
+#include <math.h>  // for sqrt
+
+#include <Kokkos_Core.hpp>
+#include <algorithm>  // for copy
+#include <array>      // for array
+#include <iostream>   // for operator<<, basic_ostream::operat...
+#include <vector>     // for allocator, vector
+
+#include "../includes/VariablesLagRemap.h"
+#include "Remap.h"                 // for Remap, Remap::Opt...
+#include "UtilesRemap-Impl.h"      // for Remap::computeFluxPP
+#include "mesh/CartesianMesh2D.h"  // for CartesianMesh2D
+#include "types/MathFunctions.h"   // for dot
+#include "types/MultiArray.h"      // for operator<<
+#include "utils/Utils.h"           // for indexOf
+/**
+ *******************************************************************************
+ * \file computeUremap()
+ * \brief phase proj (1 ou 2) de projection dans une direction, en un seul
+ *        balayage par ligne de mailles : une equipe par ligne (une ligne de
+ *        mailles en x, une colonne en y)
+ *        - copie de la ligne et de ses mailles fantomes en memoire scratch
+ *        - gradient limite aux mailles (et flux plateau-pente)
+ *        - valeur reconstruite phiFace et flux des faces internes de la
+ *          ligne, puis flux des deux faces de bord (conditions de flux)
+ *        - Uremap par ajout ou retrait des flux, mises à jour de
+ *          l'indicateur mailles mixtes et de Phi (phase 1)
+ *        Les lignes peuvent depasser la memoire partagee : les tampons sont
+ *        pris dans la memoire scratch de niveau 1.
+ *        phiFace, FluxAuxFaces et DualphiFlux restent des tableaux globaux :
+ *        la projection duale les relit.
+ * \param  proj=1 ou 2 suivant l'etape de projection
+ * \return Uremap1 (phase 1) ou varlp->Uremap2 (phase 2), phiFace1 ou
+ *         phiFace2, FluxAuxFaces, DualphiFlux1 ou DualphiFlux2,
+ *         varlp->mixte, varlp->pure, varlp->Phi (phase 1)
+ *******************************************************************************
+ */
+template <int NBMAT, class Limiteur>
+void Remap::computeUremap(const int proj) noexcept {
+  typedef Kokkos::TeamPolicy<>::member_type member_type;
+  typedef Kokkos::View<RealArray1D<nbequamax>*,
+                       Kokkos::DefaultExecutionSpace::scratch_memory_space,
+                       Kokkos::MemoryTraits<Kokkos::Unmanaged>>
+      ScratchVecView;
+  typedef Kokkos::View<double*,
+                       Kokkos::DefaultExecutionSpace::scratch_memory_space,
+                       Kokkos::MemoryTraits<Kokkos::Unmanaged>>
+      ScratchRealView;
+  typedef Kokkos::View<int*,
+                       Kokkos::DefaultExecutionSpace::scratch_memory_space,
+                       Kokkos::MemoryTraits<Kokkos::Unmanaged>>
+      ScratchIntView;
+  constexpr int nbmat = NBMAT;
+  // la phase 2 projette dans l'autre direction, a partir de Uremap1
+  const bool dirX(proj == 1 ? varlp->x_then_y_n : !(varlp->x_then_y_n));
+  const RealArray1D<dim> exy = xThenYToDirection(dirX);
+  auto Uold(proj == 1 ? varlp->ULagrange : Uremap1);
+  auto Unew(proj == 1 ? Uremap1 : varlp->Uremap2);
+  auto phiFace(proj == 1 ? phiFace1 : phiFace2);
+  auto DualphiFlux(proj == 1 ? DualphiFlux1 : DualphiFlux2);
+  const int calcul_flux_dual(options->methode_flux_masse == 2 ? 1 : 0);
+  const int ordre(options->projectionOrder);
+  const int avecPP(limiteurs->projectionAvecPlateauPente);
+  const bool avecUv(ordre == 3 || avecPP == 0);
+  if (ordre > 1) fillGhostCells(Uold, exy);
+
+  const int g(ordre > 1 ? mesh->getNbGhostLayers() : 0);
+  const int n(dirX ? mesh->getNbXQuads() : mesh->getNbYQuads());
+  const int nbLignes(dirX ? mesh->getNbYQuads() : mesh->getNbXQuads());
+  const int nL(ordre > 1 ? n + 2 * g : 0);
+  const int nUv(avecUv ? n + 2 * g : 0);
+  const int nPP(avecPP == 1 ? n : 0);
+  // faces arriere et avant d'une maille de la ligne, faces dont la demi-somme
+  // des longueurs donne la largeur Hv de la maille
+  const CartesianMesh2D::Direction faceAr(dirX ? CartesianMesh2D::Left
+                                               : CartesianMesh2D::Bottom);
+  const CartesianMesh2D::Direction faceAv(dirX ? CartesianMesh2D::Right
+                                               : CartesianMesh2D::Top);
+  const int f1FacesOfCellC(dirX ? CartesianMesh2D::Bottom
+                                : CartesianMesh2D::Right);
+  const int f2FacesOfCellC(dirX ? CartesianMesh2D::Top : CartesianMesh2D::Left);
+  const int fluxBCAr(dirX ? cdl->leftFluxBC : cdl->bottomFluxBC);
+  const int fluxBCAv(dirX ? cdl->rightFluxBC : cdl->topFluxBC);
+  const size_t scratchBytes(
+      ScratchVecView::shmem_size(nL) + ScratchRealView::shmem_size(nL) +
+      2 * ScratchIntView::shmem_size(nL) + ScratchVecView::shmem_size(nUv) +
+      ScratchVecView::shmem_size(n) + 2 * ScratchVecView::shmem_size(nPP) +
+      ScratchVecView::shmem_size(n + 1));
+  Kokkos::parallel_for(
+      "computeUremap",
+      Kokkos::TeamPolicy<>(nbLignes, Kokkos::AUTO)
+          .set_scratch_size(1, Kokkos::PerTeam(scratchBytes)),
+      KOKKOS_LAMBDA(const member_type& team) {
+        const int ligne(team.league_rank());
+        // maille k et face k (arriere de la maille k, k = n : face avant de
+        // la derniere maille) de la ligne
+        auto cellOfLine = [&](const int k) -> int {
+          return (dirX ? mesh->cellAt(ligne, k) : mesh->cellAt(k, ligne));
+        };
+        auto faceOfLine = [&](const int k) -> int {
+          const Id cId(cellOfLine(k < n ? k : n - 1));
+          return mesh->getFaceIndex(
+              k < n ? (dirX ? mesh->getLeftFaceOfCell(cId)
+                            : mesh->getBottomFaceOfCell(cId))
+                    : (dirX ? mesh->getRightFaceOfCell(cId)
+                            : mesh->getTopFaceOfCell(cId)));
+        };
+        // tampons de la ligne, mailles fantomes comprises (indice k + g)
+        ScratchVecView PhiL(team.team_scratch(1), nL);
+        ScratchRealView HvL(team.team_scratch(1), nL);
+        ScratchIntView mixteL(team.team_scratch(1), nL);
+        ScratchIntView pureL(team.team_scratch(1), nL);
+        ScratchVecView UvL(team.team_scratch(1), nUv);
+        ScratchVecView gradPhiL(team.team_scratch(1), n);
+        ScratchVecView deltaPhiFaceAv(team.team_scratch(1), nPP);
+        ScratchVecView deltaPhiFaceAr(team.team_scratch(1), nPP);
+        ScratchVecView FluxL(team.team_scratch(1), n + 1);
+
+        // copie de la ligne : mailles du domaine puis mailles fantomes
+        Kokkos::parallel_for(
+            Kokkos::TeamThreadRange(team, n + 2 * g), [&](const int kg) {
+              const int k(kg - g);
+              if (k >= 0 && k < n) {
+                const int cCells(cellOfLine(k));
+                if (avecUv) UvL(kg) = Uold(cCells) / varlp->vLagrange(cCells);
+                if (ordre > 1) {
+                  auto facesOfCellC(mesh->getFacesOfCell(cCells));
+                  int f1Faces(mesh->getFaceIndex(facesOfCellC[f1FacesOfCellC]));
+                  int f2Faces(mesh->getFaceIndex(facesOfCellC[f2FacesOfCellC]));
+                  PhiL(kg) = varlp->Phi(cCells);
+                  HvL(kg) = 0.5 * varlp->faceLengthLagrange(f1Faces) +
+                            0.5 * varlp->faceLengthLagrange(f2Faces);
+                  mixteL(kg) = varlp->mixte(cCells);
+                  pureL(kg) = varlp->pure(cCells);
+                }
+              } else {
+                int hCells(dirX ? mesh->ghostCellAt(ligne, k)
+                                : mesh->ghostCellAt(k, ligne));
+                PhiL(kg) = PhiHalo(hCells);
+                HvL(kg) = HvHalo(hCells);
+                mixteL(kg) = mixteHalo(hCells);
+                pureL(kg) = pureHalo(hCells);
+                if (ordre == 3) UvL(kg) = UvHalo(hCells);
+              }
+            });
+        team.team_barrier();
+
+        // gradient limite aux mailles, flux plateau-pente arriere et avant
+        Kokkos::parallel_for(
+            Kokkos::TeamThreadRange(team, n), [&](const int k) {
+              if (ordre == 1) {
+                gradPhiL(k) = Uzero;
+                if (avecPP == 1) {
+                  deltaPhiFaceAv(k) = Uzero;
+                  deltaPhiFaceAr(k) = Uzero;
+                }
+                return;
+              }
+              const int cCells(cellOfLine(k));
+              const int kg(k + g);
+              const int fArFaces(faceOfLine(k));
+              const int fAvFaces(faceOfLine(k + 1));
+
+              // gradients aux faces avant et arriere, nuls aux faces de bord ;
+              // en y la face avant est celle du bas
+              RealArray1D<nbequamax> gradPhiFaceAv(Uzero);
+              RealArray1D<nbequamax> gradPhiFaceAr(Uzero);
+              if (dirX) {
+                if (k < n - 1)
+                  gradPhiFaceAv = (PhiL(kg + 1) - PhiL(kg)) /
+                                  varlp->deltaxLagrange(fAvFaces);
+                if (k > 0)
+                  gradPhiFaceAr = (PhiL(kg) - PhiL(kg - 1)) /
+                                  varlp->deltaxLagrange(fArFaces);
+              } else {
+                if (k > 0)
+                  gradPhiFaceAv = (PhiL(kg - 1) - PhiL(kg)) /
+                                  varlp->deltaxLagrange(fArFaces);
+                if (k < n - 1)
+                  gradPhiFaceAr = (PhiL(kg) - PhiL(kg + 1)) /
+                                  varlp->deltaxLagrange(fAvFaces);
+              }
+
+              bool voisinage_pure =
+                  (limiteurs->projectionLimiteurMixte == 1) &&
+                  (mixteL(kg) == 0 && mixteL(kg + 1) == 0 &&
+                   mixteL(kg - 1) == 0 && pureL(kg) == pureL(kg + 1) &&
+                   pureL(kg) == pureL(kg - 1));
+
+              // le limiteur des mailles pures a voisinage pur est choisi a la
+              // maille, les seuils servent aux flux arriere et avant
+              RealArray1D<nbequamax> y0plus, y0moins;
+              auto limitation = [&](auto limiteur) {
+                using L = decltype(limiteur);
+                gradPhiL(k) = computeAndLimitGradPhi<L>(
+                    gradPhiFaceAv, gradPhiFaceAr, PhiL(kg), PhiL(kg + 1),
+                    PhiL(kg - 1), HvL(kg), HvL(kg + 1), HvL(kg - 1));
+                if (avecPP == 1)
+                  computeY0<L>(PhiL(kg + 1), PhiL(kg - 1), HvL(kg), HvL(kg + 1),
+                               HvL(kg - 1), y0plus, y0moins);
+              };
+              if ((avecPP == 1) && voisinage_pure)
+                limiteurslib::dispatchLimiteur(
+                    limiteurs->projectionLimiterIdPure, limitation);
+              else
+                limitation(Limiteur());
+
+              if (avecPP == 1) {
+                RealArray1D<dim> exyF = exy;
+                if (cstmesh->cylindrical_mesh)
+                  exyF = varlp->faceNormal(fArFaces);
+
+                double Flux_sortant_ar =
+                    dot(varlp->outerFaceNormal(cCells, faceAr), exyF) *
+                    varlp->faceNormalVelocity(fArFaces);
+
+                if (cstmesh->cylindrical_mesh)
+                  exyF = varlp->faceNormal(fAvFaces);
+
+                double Flux_sortant_av =
+                    dot(varlp->outerFaceNormal(cCells, faceAv), exyF) *
+                    varlp->faceNormalVelocity(fAvFaces);
+
+                double flux_dual = 0.5 * (varlp->faceNormalVelocity(fArFaces) +
+                                          varlp->faceNormalVelocity(fAvFaces));
+                // seconde sortie du flux avant, inutilisee
+                RealArray1D<nbequamax> Bidon;
+
+                if (voisinage_pure)
+                  computeFluxPPPure(
+                      gradPhiL(k), PhiL(kg), PhiL(kg + 1), PhiL(kg - 1),
+                      HvL(kg), y0plus, y0moins, Flux_sortant_ar, gt->deltat_n,
+                      0, cCells, options->threshold,
+                      limiteurs->projectionPlateauPenteComplet, flux_dual,
+                      calcul_flux_dual, &deltaPhiFaceAr(k),
+                      &DualphiFlux(cCells));
+                else
+                  computeFluxPP(
+                      gradPhiL(k), PhiL(kg), PhiL(kg + 1), PhiL(kg - 1),
+                      HvL(kg), y0plus, y0moins, Flux_sortant_ar, gt->deltat_n,
+                      0, cCells, options->threshold,
+                      limiteurs->projectionPlateauPenteComplet, flux_dual,
+                      calcul_flux_dual, &deltaPhiFaceAr(k),
+                      &DualphiFlux(cCells));
+
+                // pour avoir un flux dual 2D
+                DualphiFlux(cCells) *= (varlp->faceLength(fArFaces) +
+                                        varlp->faceLength(fAvFaces)) *
+                                       0.5;
+
+                if (voisinage_pure)
+                  computeFluxPPPure(
+                      gradPhiL(k), PhiL(kg), PhiL(kg + 1), PhiL(kg - 1),
+                      HvL(kg), y0plus, y0moins, Flux_sortant_av, gt->deltat_n,
+                      1, cCells, options->threshold,
+                      limiteurs->projectionPlateauPenteComplet, flux_dual,
+                      calcul_flux_dual, &deltaPhiFaceAv(k), &Bidon);
+                else
+                  computeFluxPP(
+                      gradPhiL(k), PhiL(kg), PhiL(kg + 1), PhiL(kg - 1),
+                      HvL(kg), y0plus, y0moins, Flux_sortant_av, gt->deltat_n,
+                      1, cCells, options->threshold,
+                      limiteurs->projectionPlateauPenteComplet, flux_dual,
+                      calcul_flux_dual, &deltaPhiFaceAv(k), &Bidon);
+              }
+            });
+        team.team_barrier();
+
+        // faces internes de la ligne : phiFace correspond
+        // à la valeur de phi(x) à la face pour l'ordre 2 sans plateau pente
+        // à la valeur du flux (integration de phi(x)) pour l'ordre 2 avec
+        // Plateau-Pente et pour l'ordre 3
+        Kokkos::parallel_for(
+            Kokkos::TeamThreadRange(team, 1, n), [&](const int k) {
+              const int fFaces(faceOfLine(k));
+              RealArray1D<nbequamax> phi;
+              if (ordre <= 2) {
+                if (avecPP == 0) {
+                  // maille arriere (a gauche, ou au dessus en y) et avant
+                  int kb(dirX ? k - 1 : k);
+                  int kf(dirX ? k : k - 1);
+                  int cbCells(cellOfLine(kb));
+                  int cfCells(cellOfLine(kf));
+                  phi = computeUpwindFaceQuantities(
+                      varlp->faceNormal(fFaces),
+                      varlp->faceNormalVelocity(fFaces),
+                      varlp->deltaxLagrange(fFaces), varlp->Xf(fFaces),
+                      UvL(kb + g), gradPhiL(kb), varlp->XcLagrange(cbCells),
+                      UvL(kf + g), gradPhiL(kf), varlp->XcLagrange(cfCells));
+                } else {
+                  phi = deltaPhiFaceAv(k - 1) - deltaPhiFaceAr(k);
+                }
+              } else if (ordre == 3) {
+                // stencil de 6 mailles, 3 de part et d'autre de la face
+                const int kg(k + g);
+                phi = computeVecFluxOrdre3(
+                    UvL(kg - 3), UvL(kg - 2), UvL(kg - 1), UvL(kg),
+                    UvL(kg + 1), UvL(kg + 2), HvL(kg - 3), HvL(kg - 2),
+                    HvL(kg - 1), HvL(kg), HvL(kg + 1), HvL(kg + 2),
+                    varlp->faceNormalVelocity(fFaces), gt->deltat_n);
+              }
+              phiFace(fFaces) = phi;
+              // maillage cartesien : un seul flux par face, oriente suivant
+              // la normale de la face
+              if (cstmesh->cylindrical_mesh != 1) {
+                FluxL(k) = computeRemapFlux(
+                    ordre, avecPP, varlp->faceNormalVelocity(fFaces),
+                    varlp->faceNormal(fFaces), varlp->faceLength(fFaces), phi,
+                    varlp->faceNormal(fFaces), exy, gt->deltat_n);
+                FluxAuxFaces(fFaces) = FluxL(k);
+              }
+            });
+        team.team_barrier();
+
+        // faces de bord de la ligne : le flux sortant ou rentrant d'une face
+        // avec condition de flux est celui de la face opposee, nul sinon ;
+        // une maille a la fois sur deux bords opposes garde le flux de gauche
+        // (resp. du bas)
+        Kokkos::parallel_for(
+            Kokkos::TeamThreadRange(team, 2), [&](const int avant) {
+              const int k(avant ? n : 0);
+              FluxL(k) = Uzero;
+              if ((avant ? fluxBCAv : fluxBCAr) != 1 ||
+                  (avant && n == 1 && fluxBCAr == 1))
+                return;
+              const int cCells(cellOfLine(avant ? n - 1 : 0));
+              const int fsFaces(faceOfLine(k));
+              const int foFaces(faceOfLine(avant ? n - 1 : 1));
+              // maillage cartesien : la normale de la face sert de normale
+              // sortante comme aux faces internes
+              FluxL(k) = computeRemapFlux(
+                  ordre, avecPP, varlp->faceNormalVelocity(fsFaces),
+                  varlp->faceNormal(fsFaces), varlp->faceLength(fsFaces),
+                  phiFace(foFaces),
+                  (cstmesh->cylindrical_mesh == 1
+                       ? varlp->outerFaceNormal(cCells, avant ? faceAv : faceAr)
+                       : varlp->faceNormal(fsFaces)),
+                  exy, gt->deltat_n);
+            });
+        team.team_barrier();
+
+        // mise a jour des mailles de la ligne
+        Kokkos::parallel_for(
+            Kokkos::TeamThreadRange(team, n), [&](const int k) {
+              int cCells(cellOfLine(k));
+              int cId(cCells);
+
+              RealArray1D<nbequamax> reduction = Uzero;
+              if (cstmesh->cylindrical_mesh != 1) {
+                // flux des faces arriere et avant signes par la normale
+                // sortante, les faces transverses n'echangent rien
+                reduction =
+                    reduction +
+                    dot(varlp->outerFaceNormal(cCells, faceAr), exy) * FluxL(k);
+                reduction = reduction +
+                            dot(varlp->outerFaceNormal(cCells, faceAv), exy) *
+                                FluxL(k + 1);
+              } else {
+                // maillage cylindrique : flux calcule avec la normale sortante
+                auto neighbourCellsC(mesh->getNeighbourCells(cId));
+                for (int dNeighbourCellsC = 0;
+                     dNeighbourCellsC < neighbourCellsC.size();
+                     dNeighbourCellsC++) {
+                  int dId(neighbourCellsC[dNeighbourCellsC]);
+                  int fCommonFaceCD(mesh->getCommonFace(cId, dId));
+                  size_t fId(fCommonFaceCD);
+                  int fFaces(mesh->getFaceIndex(fId));
+                  int fFacesOfCellC(mesh->getFaceSlotOfCell(cId, fId));
+                  if (dot(varlp->faceNormal(fFaces), exy) > 0.)
+                    reduction =
+                        reduction +
+                        computeRemapFlux(
+                            ordre, avecPP, varlp->faceNormalVelocity(fFaces),
+                            varlp->faceNormal(fFaces),
+                            varlp->faceLength(fFaces), phiFace(fFaces),
+                            varlp->outerFaceNormal(cCells, fFacesOfCellC), exy,
+                            gt->deltat_n);
+                }
+                if (k == 0) reduction = reduction + FluxL(0);
+                if (k == n - 1) reduction = reduction + FluxL(n);
+              }
+
+              Unew(cCells) = Uold(cCells) - reduction;
+
+              for (int imat = 0; imat < nbmat; imat++) {
+                if (Unew(cCells)[nbmat + imat] < 0.) {
+                  if (abs(Unew(cCells)[nbmat + imat]) >
+                      1.e2 * options->threshold)
+                    std::cout << " cell " << cCells << " proj " << proj
+                              << " --masse tres faiblement negative   "
+                              << " avant " << Unew(cCells - 1)[nbmat + imat]
+                              << " cell " << Unew(cCells)[nbmat + imat]
+                              << " et volume " << Unew(cCells)[imat]
+                              << " apres " << Unew(cCells + 1)[nbmat + imat]
+                              << std::endl;
+                  Unew(cCells)[nbmat + imat] = 0.;
+                }
+                if (Unew(cCells)[2 * nbmat + imat] < 0.) {
+                  if (abs(Unew(cCells)[2 * nbmat + imat]) >
+                      1.e2 * options->threshold)
+                    std::cout << " cell " << cCells << " proj " << proj
+                              << " --energie tres faiblement negative "
+                              << " avant " << Unew(cCells - 1)[2 * nbmat + imat]
+                              << " cell " << Unew(cCells)[2 * nbmat + imat]
+                              << " apres " << Unew(cCells + 1)[2 * nbmat + imat]
+                              << std::endl;
+                  Unew(cCells)[2 * nbmat + imat] = 0.;
+                }
+              }
+              // la phase 2 ne met a jour ni Phi ni l'indicateur mailles mixtes
+              if (proj != 1) return;
+
+              if (avecPP == 1) {
+                // option ou on ne regarde pas la variation de rho, V et e
+                // phi = (f1, f2, rho1*f1, rho2*f2, Vx, Vy, e1, e2
+                // ce qui permet d'ecrire le flux telque
+                // Flux = (dv1 = f1dv, dv2=f2*dv, dm1=rho1*df1, dm2=rho2*df2,
+                // d(mVx) = Vx*(dm1+dm2), d(mVy) = Vy*(dm1+dm2),
+                // d(m1e1) = e1*dm1,  d(m2e2) = e2*dm2 dans computeFluxPP
+
+                double somme_volume = 0.;
+                for (int imat = 0; imat < nbmat; imat++) {
+                  somme_volume += Unew(cCells)[imat];
+                }
+                // Phi volume
+                double somme_masse = 0.;
+                for (int imat = 0; imat < nbmat; imat++) {
+                  varlp->Phi(cCells)[imat] = Unew(cCells)[imat] / somme_volume;
+                  // Phi masse
+                  if (Unew(cCells)[imat] != 0.)
+                    varlp->Phi(cCells)[nbmat + imat] =
+                        Unew(cCells)[nbmat + imat] / (Unew(cCells)[imat]);
+                  else
+                    varlp->Phi(cCells)[nbmat + imat] = 0.;
+                  somme_masse += Unew(cCells)[nbmat + imat];
+                }
+                // Phi Vitesse
+                varlp->Phi(cCells)[3 * nbmat] =
+                    Unew(cCells)[3 * nbmat] / somme_masse;
+                varlp->Phi(cCells)[3 * nbmat + 1] =
+                    Unew(cCells)[3 * nbmat + 1] / somme_masse;
+                // Phi energie
+                for (int imat = 0; imat < nbmat; imat++) {
+                  if (Unew(cCells)[nbmat + imat] != 0.)
+                    varlp->Phi(cCells)[2 * nbmat + imat] =
+                        Unew(cCells)[2 * nbmat + imat] /
+                        Unew(cCells)[nbmat + imat];
+                  else
+                    varlp->Phi(cCells)[2 * nbmat + imat] = 0.;
+                }
+                // Phi energie cinétique
+                if (options->projectionConservative == 1)
+                  varlp->Phi(cCells)[3 * nbmat + 2] =
+                      Unew(cCells)[3 * nbmat + 2] / somme_masse;
+
+              } else {
+                varlp->Phi(cCells) = Unew(cCells) / varlp->vLagrange(cCells);
+              }
+
+              // Mises à jour de l'indicateur mailles mixtes
+              int matcell(0);
+              int imatpure(-1);
+              for (int imat = 0; imat < nbmat; imat++)
+                if (varlp->Phi(cCells)[imat] > 0.) {
+                  matcell++;
+                  imatpure = imat;
+                }
+              if (matcell > 1) {
+                varlp->mixte(cCells) = 1;
+                varlp->pure(cCells) = -1;
+              } else {
+                varlp->mixte(cCells) = 0;
+                varlp->pure(cCells) = imatpure;
+              }
+            });
+      });
+}
+void Remap::computeUremap(const int proj) noexcept {
+  dispatchNbMat(options->nbmat, [&](auto nbmat) {
+    limiteurslib::dispatchLimiteur(
+        limiteurs->projectionLimiterId, [&](auto limiteur) {
+          computeUremap<decltype(nbmat)::value, decltype(limiteur)>(proj);
+        });
+  });
+}
+/**
+ *******************************************************************************
+ * \file computeUremap1()
+ * \brief phase 1 de projection dans la direction x_then_y_n
+ * \return Uremap1, varlp->mixte, varlp->pure, varlp->Phi
+ *******************************************************************************
+ */
+void Remap::computeUremap1() noexcept { computeUremap(1); }
+/**
+ *******************************************************************************
+ * \file computeUremap2()
+ * \brief phase 2 de projection dans l'autre direction, a partir de Uremap1
+ * \return varlp->Uremap2
+ *******************************************************************************
+ */
+void Remap::computeUremap2() noexcept { computeUremap(2); }
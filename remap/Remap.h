@@ -21,8 +21,10 @@
 #include "../includes/Freefunctions.h"
 #include "../includes/GestionTemps.h"
 #include "../includes/Limiteurs.h"
+#include "../includes/MaterialView.h"
 #include "../includes/Options.h"
 #include "../includes/VariablesLagRemap.h"
+#include "LimiteursProjection.h"
 #include "mesh/CartesianMesh2D.h"  // for CartesianMesh2D, CartesianM...
 #include "mesh/MeshGeometry.h"     // for MeshGeometry
 #include "mesh/PvdFileWriter2D.h"  // for PvdFileWriter2D
@@ -60,28 +62,16 @@ class Remap {
   int test_debug = 1;
 
   // Connectivity Variables
-  Kokkos::View<double*> LfLagrange;
-  Kokkos::View<double*> HvLagrange;
   Kokkos::View<RealArray1D<nbequamax>*> Uremap1;
   Kokkos::View<RealArray1D<nbequamax>*> UDualremap1;
-  Kokkos::View<RealArray1D<nbequamax>*> gradPhiFace1;
-  Kokkos::View<RealArray1D<nbequamax>*> gradPhiFace2;
-  Kokkos::View<RealArray1D<nbequamax>*> gradPhi1;
-  Kokkos::View<RealArray1D<nbequamax>*> gradPhi2;
   Kokkos::View<RealArray1D<nbequamax>*> phiFace1;
   Kokkos::View<RealArray1D<nbequamax>*> phiFace2;
   Kokkos::View<RealArray1D<nbequamax>*> DualphiFlux1;
   Kokkos::View<RealArray1D<nbequamax>*> DualphiFlux2;
-  Kokkos::View<RealArray1D<nbequamax>*> Bidon1;
-  Kokkos::View<RealArray1D<nbequamax>*> Bidon2;
-  Kokkos::View<RealArray1D<nbequamax>*> deltaPhiFaceAv;
-  Kokkos::View<RealArray1D<nbequamax>*> deltaPhiFaceAr;
-  Kokkos::View<RealArray1D<nbequamax>**> FluxFace1;
-  Kokkos::View<RealArray1D<nbequamax>**> FluxFace2;
-  Kokkos::View<RealArray1D<nbmatmax>*> RightFluxMassePartielle;
-  Kokkos::View<RealArray1D<nbmatmax>*> LeftFluxMassePartielle;
-  Kokkos::View<RealArray1D<nbmatmax>*> TopFluxMassePartielle;
-  Kokkos::View<RealArray1D<nbmatmax>*> BottomFluxMassePartielle;
+  MaterialView RightFluxMassePartielle;
+  MaterialView LeftFluxMassePartielle;
+  MaterialView TopFluxMassePartielle;
+  MaterialView BottomFluxMassePartielle;
   Kokkos::View<double*> RightFluxMasse;
   Kokkos::View<double*> LeftFluxMasse;
   Kokkos::View<double*> TopFluxMasse;
@@ -94,6 +84,18 @@ class Remap {
   Kokkos::View<RealArray1D<dimplus1>*> LeftupwindVelocity;
   Kokkos::View<RealArray1D<nbequamax>*> gradDualPhi1;
   Kokkos::View<RealArray1D<nbequamax>*> gradDualPhi2;
+  // couronne de mailles fantomes lue par les stencils de projection aux
+  // extremites des lignes (mesh->ghostCellAt)
+  Kokkos::View<RealArray1D<nbequamax>*> PhiHalo;
+  Kokkos::View<double*> HvHalo;
+  Kokkos::View<int*> mixteHalo;
+  Kokkos::View<int*> pureHalo;
+  Kokkos::View<RealArray1D<nbequamax>*> UvHalo;
+  // flux des faces internes de la direction projetee, calcule une fois par
+  // face et oriente suivant la normale de la face (maillage cartesien)
+  Kokkos::View<RealArray1D<nbequamax>*> FluxAuxFaces;
+  // vrai si le schema projette aussi les grandeurs aux noeuds (Vnr)
+  bool avecProjectionDuale;
 
  public:
   Remap(optionschemalib::OptionsSchema::Options* aOptions,
@@ -117,53 +119,56 @@ class Remap {
         nbNodesOfCell(CartesianMesh2D::MaxNbNodesOfCell),
         nbNodesOfFace(CartesianMesh2D::MaxNbNodesOfFace),
         nbFacesOfCell(CartesianMesh2D::MaxNbFacesOfCell),
-        LfLagrange("LfLagrange", nbFaces),
-        HvLagrange("HvLagrange", nbCells),
         Uremap1("Uremap1", nbCells),
-        UDualremap1("UDualremap1", nbNodes),
-        gradPhiFace1("gradPhiFace1", nbFaces),
-        gradPhiFace2("gradPhiFace2", nbFaces),
-        gradPhi1("gradPhi1", nbCells),
-        gradPhi2("gradPhi2", nbCells),
-        gradDualPhi1("gradPhi1", nbNodes),
-        gradDualPhi2("gradPhi2", nbNodes),
         phiFace1("phiFace1", nbFaces),
         phiFace2("phiFace2", nbFaces),
-        DualphiFlux1("DualphiFlux1", nbCells),
-        DualphiFlux2("DualphiFlux2", nbCells),
-        Bidon1("Bidon1", nbCells),
-        Bidon2("Bidon2", nbCells),
-        FluxFace1("FluxFace1", nbCells, nbFacesOfCell),
-        FluxFace2("FluxFace2", nbCells, nbFacesOfCell),
-        deltaPhiFaceAv("deltaPhiFaceAv", nbCells),
-        deltaPhiFaceAr("deltaPhiFaceAr", nbCells),
-        RightFluxMassePartielle("FluxMassePartielle", nbNodes),
-        LeftFluxMassePartielle("FluxMassePartielle", nbNodes),
-        TopFluxMassePartielle("FluxMassePartielle", nbNodes),
-        BottomFluxMassePartielle("FluxMassePartielle", nbNodes),
-        RightFluxMasse("FluxMasse", nbNodes),
-        LeftFluxMasse("FluxMasse", nbNodes),
-        TopFluxMasse("FluxMasse", nbNodes),
-        BottomFluxMasse("FluxMasse", nbNodes),
-        VerticalFaceOfNode("VFaceOfNode", nbNodes),
-        HorizontalFaceOfNode("HFaceOfNode", nbNodes),
-        TopupwindVelocity("upwindVelocity", nbNodes),
-        BottomupwindVelocity("upwindVelocity", nbNodes),
-        RightupwindVelocity("upwindVelocity", nbNodes),
-        LeftupwindVelocity("upwindVelocity", nbNodes) {}
+        avecProjectionDuale(false) {
+    // les tableaux de travail ne sont alloues que pour les options actives :
+    // flux plateau-pente avec l'option correspondante, projection duale par
+    // initDualRemap (Vnr)
+    if (cstmesh->cylindrical_mesh != 1)
+      FluxAuxFaces =
+          Kokkos::View<RealArray1D<nbequamax>*>("FluxAuxFaces", nbFaces);
+    if (limiteurs->projectionAvecPlateauPente == 1 &&
+        options->projectionOrder > 1) {
+      DualphiFlux1 =
+          Kokkos::View<RealArray1D<nbequamax>*>("DualphiFlux1", nbCells);
+      DualphiFlux2 =
+          Kokkos::View<RealArray1D<nbequamax>*>("DualphiFlux2", nbCells);
+    }
+    // une couche de mailles fantomes pour les gradients limites, deux pour le
+    // flux d'ordre 3 (stencil de 6 mailles)
+    if (options->projectionOrder > 1) {
+      mesh->setNbGhostLayers(options->projectionOrder > 2 ? 2 : 1);
+      const size_t nbGhostCells(mesh->getNbGhostCells());
+      PhiHalo = Kokkos::View<RealArray1D<nbequamax>*>("PhiHalo", nbGhostCells);
+      HvHalo = Kokkos::View<double*>("HvHalo", nbGhostCells);
+      mixteHalo = Kokkos::View<int*>("mixteHalo", nbGhostCells);
+      pureHalo = Kokkos::View<int*>("pureHalo", nbGhostCells);
+      if (options->projectionOrder > 2)
+        UvHalo = Kokkos::View<RealArray1D<nbequamax>*>("UvHalo", nbGhostCells);
+    }
+  }
 
-  void computeGradPhiFace1() noexcept;
-  void computeGradPhi1() noexcept;
-  void computeUpwindFaceQuantitiesForProjection1() noexcept;
   void computeUremap1() noexcept;
   void computeDualUremap1() noexcept;
+  template <int NBMAT>
+  void computeDualUremap1() noexcept;
 
-  void computeGradPhiFace2() noexcept;
-  void computeGradPhi2() noexcept;
-  void computeUpwindFaceQuantitiesForProjection2() noexcept;
   void computeUremap2() noexcept;
   void computeDualUremap2() noexcept;
+  template <int NBMAT>
+  void computeDualUremap2() noexcept;
+  void computeDualGradPhi(
+      const Kokkos::View<RealArray1D<nbequamax>*>& gradDualPhi,
+      const bool horizontal) noexcept;
+  template <class Limiteur>
+  void computeDualGradPhi(
+      const Kokkos::View<RealArray1D<nbequamax>*>& gradDualPhi,
+      const bool horizontal) noexcept;
   void FacesOfNode();
+  void initDualRemap();
+  size_t getAllocatedBytes() const noexcept;
 
   template <size_t d>
   RealArray1D<d> computeRemapFlux(int projectionOrder,
@@ -174,19 +179,19 @@ class Remap {
                                   RealArray1D<dim> outer_face_normal,
                                   RealArray1D<dim> exy, double deltat_n);
 
-  RealArray1D<nbequamax> computeBoundaryFluxes(int proj, int cCells,
-                                               RealArray1D<dim> exy);
-
  private:
-  int getLeftCells(const int cells);
-  int getRightCells(const int cells);
-  int getBottomCells(const int cells);
-  int getTopCells(const int cells);
+  void computeUremap(const int proj) noexcept;
+  template <int NBMAT, class Limiteur>
+  void computeUremap(const int proj) noexcept;
+  void fillGhostCells(const Kokkos::View<RealArray1D<nbequamax>*>& U,
+                      RealArray1D<dim> exy) noexcept;
   int getLeftNode(const int node);
   int getRightNode(const int node);
   int getBottomNode(const int node);
   int getTopNode(const int node);
 
+  RealArray1D<nbequamax> getFluxFaceOfCell(const int proj, const int cCells,
+                                           const int fFacesOfCellC);
   void getRightAndLeftFluxMasse1(const int nbmat, const size_t pNodes);
   void getRightAndLeftFluxMasse2(const int nbmat, const size_t pNodes);
   void getTopAndBottomFluxMasse1(const int nbmat, const size_t pNodes);
@@ -200,17 +205,11 @@ class Remap {
   void getTopAndBottomFluxMassePB1(const int nbmat, const size_t pNodes);
   void getTopAndBottomFluxMassePB2(const int nbmat, const size_t pNodes);
 
-  double fluxLimiter(int projectionLimiterId, double r);
-  double fluxLimiterG(int projectionLimiterId, double gradplus,
-                       double gradmoins, double y0, double yplus, double ymoins,
-                       double h0, double hplus, double hmoins);
-  double computeY0(int projectionLimiterId, double y0, double yplus,
-                   double ymoins, double h0, double hplus, double hmoins,
-                   int type);
-  double computexgxd(double y0, double yplus, double ymoins, double h0,
-                     double y0plus, double y0moins, int type);
-  double computeygyd(double y0, double yplus, double ymoins, double h0,
-                     double y0plus, double y0moins, double grady, int type);
+  void computexgxd(double y0, double yplus, double ymoins, double h0,
+                   double y0plus, double y0moins, double& xg, double& xd);
+  void computeygyd(double y0, double yplus, double ymoins, double h0,
+                   double y0plus, double y0moins, double grady, double& yg,
+                   double& yd);
   double INTY(double X, double x0, double y0, double x1, double y1);
 
   void getTopUpwindVelocity(const size_t TopNode, const size_t pNode,
@@ -229,25 +228,30 @@ class Remap {
                              RealArray1D<nbequamax> gradDualPhiL,
                              RealArray1D<nbequamax> gradDualPhi);
 
-  template <size_t d>
+  template <class Limiteur, size_t d>
   RealArray1D<d> computeDualHorizontalGradPhi(RealArray1D<d> gradphiplus,
                                               RealArray1D<d> gradphimoins,
                                               const size_t pNode);
-  template <size_t d>
+  template <class Limiteur, size_t d>
   RealArray1D<d> computeDualVerticalGradPhi(RealArray1D<d> gradphiplus,
                                             RealArray1D<d> gradphimoins,
                                             const size_t pNode);
-  template <size_t d>
+  template <class Limiteur, size_t d>
   RealArray1D<d> computeAndLimitGradPhi(
-      int projectionLimiterId, RealArray1D<d> gradphiplus,
-      RealArray1D<d> gradphimoins, RealArray1D<d> phi, RealArray1D<d> phiplus,
-      RealArray1D<d> phimoins, double h0, double hplus, double hmoins);
+      RealArray1D<d> gradphiplus, RealArray1D<d> gradphimoins,
+      RealArray1D<d> phi, RealArray1D<d> phiplus, RealArray1D<d> phimoins,
+      double h0, double hplus, double hmoins);
+  template <class Limiteur, size_t d>
+  void computeY0(RealArray1D<d> phiplus, RealArray1D<d> phimoins, double h0,
+                 double hplus, double hmoins, RealArray1D<d>& y0plus,
+                 RealArray1D<d>& y0moins);
 
   template <size_t d>
   void computeFluxPP(RealArray1D<d> gradphi, RealArray1D<d> phi,
                      RealArray1D<d> phiplus, RealArray1D<d> phimoins, double h0,
-                     double hplus, double hmoins, double face_normal_velocity,
-                     double deltat_n, int type, int cell, double flux_threhold,
+                     RealArray1D<d> y0plus, RealArray1D<d> y0moins,
+                     double face_normal_velocity, double deltat_n, int type,
+                     int cell, double flux_threhold,
                      int projectionPlateauPenteComplet,
                      double dual_normal_velocity, int calcul_flux_dual,
                      RealArray1D<d>* Flux, RealArray1D<d>* Flux_dual);
@@ -255,9 +259,10 @@ class Remap {
   template <size_t d>
   void computeFluxPPPure(RealArray1D<d> gradphi, RealArray1D<d> phi,
                          RealArray1D<d> phiplus, RealArray1D<d> phimoins,
-                         double h0, double hplus, double hmoins,
-                         double face_normal_velocity, double deltat_n, int type,
-                         int cell, double flux_threhold,
+                         double h0, RealArray1D<d> y0plus,
+                         RealArray1D<d> y0moins, double face_normal_velocity,
+                         double deltat_n, int type, int cell,
+                         double flux_threhold,
                          int projectionPlateauPenteComplet,
                          double dual_normal_velocity, int calcul_flux_dual,
                          RealArray1D<d>* Flux, RealArray1D<d>* Flux_dual);
@@ -6,13 +6,43 @@
 #include "Remap.h"                // for Remap, Remap::Options
 #include "types/MathFunctions.h"  // for min, max
 #include "utils/Utils.h"          // for indexOf
+/**
+ *******************************************************************************
+ * \file getFluxFaceOfCell
+ * \brief flux de la phase proj a travers la face fFacesOfCellC de la maille
+ *        cCells, oriente par la normale sortante de la maille : c'est la
+ *        valeur retiree a la maille par computeUremap.
+ *        Maillage cartesien : flux unique de la face (FluxAuxFaces) signe par
+ *        la normale sortante ; maillage cylindrique : flux recalcule avec la
+ *        normale sortante, nul pour les faces non projetees
+ * \param  proj, cCells, fFacesOfCellC
+ * \return flux de la face pour la maille
+ *******************************************************************************
+ */
+RealArray1D<nbequamax> Remap::getFluxFaceOfCell(const int proj,
+                                                const int cCells,
+                                                const int fFacesOfCellC) {
+  const RealArray1D<dim> exy(
+      xThenYToDirection(proj == 1 ? varlp->x_then_y_n : !varlp->x_then_y_n));
+  const int fFaces(
+      mesh->getFaceIndex(mesh->getFacesOfCell(cCells)[fFacesOfCellC]));
+  if (cstmesh->cylindrical_mesh != 1)
+    return dot(varlp->outerFaceNormal(cCells, fFacesOfCellC), exy) *
+           FluxAuxFaces(fFaces);
+  if (dot(varlp->faceNormal(fFaces), exy) <= 0.) return Uzero;
+  return computeRemapFlux(
+      options->projectionOrder, limiteurs->projectionAvecPlateauPente,
+      varlp->faceNormalVelocity(fFaces), varlp->faceNormal(fFaces),
+      varlp->faceLength(fFaces), (proj == 1 ? phiFace1 : phiFace2)(fFaces),
+      varlp->outerFaceNormal(cCells, fFacesOfCellC), exy, gt->deltat_n);
+}
 /**
  *******************************************************************************
  * \file getRightAndLeftFluxMasse1
  * \brief calcul des flux de masse sur les faces virtuelles
  *       gauche et droite de la maille duale
  *       pour l'etape 1 de la projection
- * \param  FluxFace1 (flux de masse aux mailles)
+ * \param  FluxAuxFaces, phiFace1 (flux aux faces de la phase 1)
  * \return RightFluxMasse, LeftFluxMasse
  *******************************************************************************
  */
@@ -32,27 +62,27 @@ void Remap::getRightAndLeftFluxMasse1(const int nbmat, const size_t pNodes) {
 
     if (VerticalFaceOfNode(pNodes)[0] != -1) {
       RightFluxMassePartielle(pNodes)[imat] +=
-          (FluxFace1(cfCell1, fOfcfCell1)[nbmat + imat] *
+          (getFluxFaceOfCell(1, cfCell1, fOfcfCell1)[nbmat + imat] *
                varlp->outerFaceNormal(cfCell1, fOfcfCell1)[0] +
-           FluxFace1(cfCell1, frOfcfCell1)[nbmat + imat] *
+           getFluxFaceOfCell(1, cfCell1, frOfcfCell1)[nbmat + imat] *
                varlp->outerFaceNormal(cfCell1, frOfcfCell1)[0]);
       LeftFluxMassePartielle(pNodes)[imat] +=
-          (FluxFace1(cbCell1, fOfcbCell1)[nbmat + imat] *
+          (getFluxFaceOfCell(1, cbCell1, fOfcbCell1)[nbmat + imat] *
                varlp->outerFaceNormal(cbCell1, fOfcbCell1)[0] +
-           FluxFace1(cbCell1, flOfcbCell1)[nbmat + imat] *
+           getFluxFaceOfCell(1, cbCell1, flOfcbCell1)[nbmat + imat] *
                varlp->outerFaceNormal(cbCell1, flOfcbCell1)[0]);
     }
 
     if (VerticalFaceOfNode(pNodes)[1] != -1) {
       RightFluxMassePartielle(pNodes)[imat] +=
-          (FluxFace1(cfCell2, fOfcfCell2)[nbmat + imat] *
+          (getFluxFaceOfCell(1, cfCell2, fOfcfCell2)[nbmat + imat] *
                varlp->outerFaceNormal(cfCell2, fOfcfCell2)[0] +
-           FluxFace1(cfCell2, frOfcfCell2)[nbmat + imat] *
+           getFluxFaceOfCell(1, cfCell2, frOfcfCell2)[nbmat + imat] *
                varlp->outerFaceNormal(cfCell2, frOfcfCell2)[0]);
       LeftFluxMassePartielle(pNodes)[imat] +=
-          (FluxFace1(cbCell2, fOfcbCell2)[nbmat + imat] *
+          (getFluxFaceOfCell(1, cbCell2, fOfcbCell2)[nbmat + imat] *
                varlp->outerFaceNormal(cbCell2, fOfcbCell2)[0] +
-           FluxFace1(cbCell2, flOfcbCell2)[nbmat + imat] *
+           getFluxFaceOfCell(1, cbCell2, flOfcbCell2)[nbmat + imat] *
                varlp->outerFaceNormal(cbCell2, flOfcbCell2)[0]);
     }
 
@@ -71,7 +101,7 @@ void Remap::getRightAndLeftFluxMasse1(const int nbmat, const size_t pNodes) {
  * \brief calcul des flux de masse sur les faces virtuelles
  *       gauche et droite de la maille duale
  *       pour l'etape 2 de la projection
- * \param  FluxFace2 (flux de masse aux mailles)
+ * \param  FluxAuxFaces, phiFace2 (flux aux faces de la phase 2)
  * \return RightFluxMasse, LeftFluxMasse
  *******************************************************************************
  */
@@ -91,27 +121,27 @@ void Remap::getRightAndLeftFluxMasse2(const int nbmat, const size_t pNodes) {
 
     if (VerticalFaceOfNode(pNodes)[0] != -1) {
       RightFluxMassePartielle(pNodes)[imat] +=
-          (FluxFace2(cfCell1, fOfcfCell1)[nbmat + imat] *
+          (getFluxFaceOfCell(2, cfCell1, fOfcfCell1)[nbmat + imat] *
                varlp->outerFaceNormal(cfCell1, fOfcfCell1)[0] +
-           FluxFace2(cfCell1, frOfcfCell1)[nbmat + imat] *
+           getFluxFaceOfCell(2, cfCell1, frOfcfCell1)[nbmat + imat] *
                varlp->outerFaceNormal(cfCell1, frOfcfCell1)[0]);
       LeftFluxMassePartielle(pNodes)[imat] +=
-          (FluxFace2(cbCell1, fOfcbCell1)[nbmat + imat] *
+          (getFluxFaceOfCell(2, cbCell1, fOfcbCell1)[nbmat + imat] *
                varlp->outerFaceNormal(cbCell1, fOfcbCell1)[0] +
-           FluxFace2(cbCell1, flOfcbCell1)[nbmat + imat] *
+           getFluxFaceOfCell(2, cbCell1, flOfcbCell1)[nbmat + imat] *
                varlp->outerFaceNormal(cbCell1, flOfcbCell1)[0]);
     }
 
     if (VerticalFaceOfNode(pNodes)[1] != -1) {
       RightFluxMassePartielle(pNodes)[imat] +=
-          (FluxFace2(cfCell2, fOfcfCell2)[nbmat + imat] *
+          (getFluxFaceOfCell(2, cfCell2, fOfcfCell2)[nbmat + imat] *
                varlp->outerFaceNormal(cfCell2, fOfcfCell2)[0] +
-           FluxFace2(cfCell2, frOfcfCell2)[nbmat + imat] *
+           getFluxFaceOfCell(2, cfCell2, frOfcfCell2)[nbmat + imat] *
                varlp->outerFaceNormal(cfCell2, frOfcfCell2)[0]);
       LeftFluxMassePartielle(pNodes)[imat] +=
-          (FluxFace2(cbCell2, fOfcbCell2)[nbmat + imat] *
+          (getFluxFaceOfCell(2, cbCell2, fOfcbCell2)[nbmat + imat] *
                varlp->outerFaceNormal(cbCell2, fOfcbCell2)[0] +
-           FluxFace2(cbCell2, flOfcbCell2)[nbmat + imat] *
+           getFluxFaceOfCell(2, cbCell2, flOfcbCell2)[nbmat + imat] *
                varlp->outerFaceNormal(cbCell2, flOfcbCell2)[0]);
     }
     if (nbfaces != 0) {
@@ -129,7 +159,7 @@ void Remap::getRightAndLeftFluxMasse2(const int nbmat, const size_t pNodes) {
  * \brief calcul des flux de masse sur les faces virtuelles
  *       haute et basse de la maille duale
  *       pour l'etape 1 de la projection
- * \param  FluxFace1 (flux de masse aux mailles)
+ * \param  FluxAuxFaces, phiFace1 (flux aux faces de la phase 1)
  * \return TopFluxMasse, BottomFluxMasse
  *******************************************************************************
  */
@@ -150,26 +180,26 @@ void Remap::getTopAndBottomFluxMasse1(const int nbmat, const size_t pNodes) {
 
     if (HorizontalFaceOfNode(pNodes)[0] != -1) {
       TopFluxMassePartielle(pNodes)[imat] +=
-          (FluxFace1(cbCell1, fOfcbCell1)[nbmat + imat] *
+          (getFluxFaceOfCell(1, cbCell1, fOfcbCell1)[nbmat + imat] *
                varlp->outerFaceNormal(cbCell1, fOfcbCell1)[1] +
-           FluxFace1(cbCell1, ftOfcbCell1)[nbmat + imat] *
+           getFluxFaceOfCell(1, cbCell1, ftOfcbCell1)[nbmat + imat] *
                varlp->outerFaceNormal(cbCell1, ftOfcbCell1)[1]);
       BottomFluxMassePartielle(pNodes)[imat] +=
-          (FluxFace1(cfCell1, fOfcfCell1)[nbmat + imat] *
+          (getFluxFaceOfCell(1, cfCell1, fOfcfCell1)[nbmat + imat] *
                varlp->outerFaceNormal(cfCell1, fOfcfCell1)[1] +
-           FluxFace1(cfCell1, fbOfcfCell1)[nbmat + imat] *
+           getFluxFaceOfCell(1, cfCell1, fbOfcfCell1)[nbmat + imat] *
                varlp->outerFaceNormal(cfCell1, fbOfcfCell1)[1]);
     }
     if (HorizontalFaceOfNode(pNodes)[1] != -1) {
       TopFluxMassePartielle(pNodes)[imat] +=
-          (FluxFace1(cbCell2, fOfcbCell2)[nbmat + imat] *
+          (getFluxFaceOfCell(1, cbCell2, fOfcbCell2)[nbmat + imat] *
                varlp->outerFaceNormal(cbCell2, fOfcbCell2)[1] +
-           FluxFace1(cbCell2, ftOfcbCell2)[nbmat + imat] *
+           getFluxFaceOfCell(1, cbCell2, ftOfcbCell2)[nbmat + imat] *
                varlp->outerFaceNormal(cbCell2, ftOfcbCell2)[1]);
       BottomFluxMassePartielle(pNodes)[imat] +=
-          (FluxFace1(cfCell2, fOfcfCell2)[nbmat + imat] *
+          (getFluxFaceOfCell(1, cfCell2, fOfcfCell2)[nbmat + imat] *
                varlp->outerFaceNormal(cfCell2, fOfcfCell2)[1] +
-           FluxFace1(cfCell2, fbOfcfCell2)[nbmat + imat] *
+           getFluxFaceOfCell(1, cfCell2, fbOfcfCell2)[nbmat + imat] *
                varlp->outerFaceNormal(cfCell2, fbOfcfCell2)[1]);
     }
     if (nbfaces != 0) {
@@ -187,7 +217,7 @@ void Remap::getTopAndBottomFluxMasse1(const int nbmat, const size_t pNodes) {
  * \brief calcul des flux de masse sur les faces virtuelles
  *       haute et basse de la maille duale
  *       pour l'etape 2 de la projection
- * \param  FluxFace2 (flux de masse aux mailles)
+ * \param  FluxAuxFaces, phiFace2 (flux aux faces de la phase 2)
  * \return TopFluxMasse, BottomFluxMasse
  *******************************************************************************
  */
@@ -207,26 +237,26 @@ void Remap::getTopAndBottomFluxMasse2(const int nbmat, const size_t pNodes) {
 
     if (HorizontalFaceOfNode(pNodes)[0] != -1) {
       TopFluxMassePartielle(pNodes)[imat] +=
-          (FluxFace2(cbCell1, fOfcbCell1)[nbmat + imat] *
+          (getFluxFaceOfCell(2, cbCell1, fOfcbCell1)[nbmat + imat] *
                varlp->outerFaceNormal(cbCell1, fOfcbCell1)[1] +
-           FluxFace2(cbCell1, ftOfcbCell1)[nbmat + imat] *
+           getFluxFaceOfCell(2, cbCell1, ftOfcbCell1)[nbmat + imat] *
                varlp->outerFaceNormal(cbCell1, ftOfcbCell1)[1]);
       BottomFluxMassePartielle(pNodes)[imat] +=
-          (FluxFace2(cfCell1, fOfcfCell1)[nbmat + imat] *
+          (getFluxFaceOfCell(2, cfCell1, fOfcfCell1)[nbmat + imat] *
                varlp->outerFaceNormal(cfCell1, fOfcfCell1)[1] +
-           FluxFace2(cfCell1, fbOfcfCell1)[nbmat + imat] *
+           getFluxFaceOfCell(2, cfCell1, fbOfcfCell1)[nbmat + imat] *
                varlp->outerFaceNormal(cfCell1, fbOfcfCell1)[1]);
     }
     if (HorizontalFaceOfNode(pNodes)[1] != -1) {
       TopFluxMassePartielle(pNodes)[imat] +=
-          (FluxFace2(cbCell2, fOfcbCell2)[nbmat + imat] *
+          (getFluxFaceOfCell(2, cbCell2, fOfcbCell2)[nbmat + imat] *
                varlp->outerFaceNormal(cbCell2, fOfcbCell2)[1] +
-           FluxFace2(cbCell2, ftOfcbCell2)[nbmat + imat] *
+           getFluxFaceOfCell(2, cbCell2, ftOfcbCell2)[nbmat + imat] *
                varlp->outerFaceNormal(cbCell2, ftOfcbCell2)[1]);
       BottomFluxMassePartielle(pNodes)[imat] +=
-          (FluxFace2(cfCell2, fOfcfCell2)[nbmat + imat] *
+          (getFluxFaceOfCell(2, cfCell2, fOfcfCell2)[nbmat + imat] *
                varlp->outerFaceNormal(cfCell2, fOfcfCell2)[1] +
-           FluxFace2(cfCell2, fbOfcfCell2)[nbmat + imat] *
+           getFluxFaceOfCell(2, cfCell2, fbOfcfCell2)[nbmat + imat] *
                varlp->outerFaceNormal(cfCell2, fbOfcfCell2)[1]);
     }
     if (nbfaces != 0) {
@@ -499,7 +529,7 @@ void Remap::getLeftUpwindVelocity(const size_t LeftNode, const size_t pNode,
  *       pour l'etape 1 de la projection
  *  Méthode A2
  *
- * \param  FluxFace1 (flux de masse aux mailles)
+ * \param  FluxAuxFaces, phiFace1 (flux aux faces de la phase 1)
  * \return RightFluxMasse, LeftFluxMasse
  *******************************************************************************
  */
@@ -521,30 +551,30 @@ void Remap::getRightAndLeftFluxMasseViaVol1(const int nbmat,
     if (VerticalFaceOfNode(pNodes)[0] != -1) {
       RightFluxMassePartielle(pNodes)[imat] +=
           varlp->rLagrange(cfCell1) *
-          (FluxFace1(cfCell1, fOfcfCell1)[imat] *
+          (getFluxFaceOfCell(1, cfCell1, fOfcfCell1)[imat] *
                varlp->outerFaceNormal(cfCell1, fOfcfCell1)[0] +
-           FluxFace1(cfCell1, frOfcfCell1)[imat] *
+           getFluxFaceOfCell(1, cfCell1, frOfcfCell1)[imat] *
                varlp->outerFaceNormal(cfCell1, frOfcfCell1)[0]);
       LeftFluxMassePartielle(pNodes)[imat] +=
           varlp->rLagrange(cbCell1) *
-          (FluxFace1(cbCell1, fOfcbCell1)[imat] *
+          (getFluxFaceOfCell(1, cbCell1, fOfcbCell1)[imat] *
                varlp->outerFaceNormal(cbCell1, fOfcbCell1)[0] +
-           FluxFace1(cbCell1, flOfcbCell1)[imat] *
+           getFluxFaceOfCell(1, cbCell1, flOfcbCell1)[imat] *
                varlp->outerFaceNormal(cbCell1, flOfcbCell1)[0]);
     }
 
     if (VerticalFaceOfNode(pNodes)[1] != -1) {
       RightFluxMassePartielle(pNodes)[imat] +=
           varlp->rLagrange(cfCell2) *
-          (FluxFace1(cfCell2, fOfcfCell2)[imat] *
+          (getFluxFaceOfCell(1, cfCell2, fOfcfCell2)[imat] *
                varlp->outerFaceNormal(cfCell2, fOfcfCell2)[0] +
-           FluxFace1(cfCell2, frOfcfCell2)[imat] *
+           getFluxFaceOfCell(1, cfCell2, frOfcfCell2)[imat] *
                varlp->outerFaceNormal(cfCell2, frOfcfCell2)[0]);
       LeftFluxMassePartielle(pNodes)[imat] +=
           varlp->rLagrange(cbCell2) *
-          (FluxFace1(cbCell2, fOfcbCell2)[imat] *
+          (getFluxFaceOfCell(1, cbCell2, fOfcbCell2)[imat] *
                varlp->outerFaceNormal(cbCell2, fOfcbCell2)[0] +
-           FluxFace1(cbCell2, flOfcbCell2)[imat] *
+           getFluxFaceOfCell(1, cbCell2, flOfcbCell2)[imat] *
                varlp->outerFaceNormal(cbCell2, flOfcbCell2)[0]);
     }
     // if (pNodes == 300 || pNodes == 301 || pNodes == 302) {
@@ -580,7 +610,7 @@ void Remap::getRightAndLeftFluxMasseViaVol1(const int nbmat,
  *       pour l'etape 2 de la projection
  *  Méthode A2
  *
- * \param  FluxFace1 (flux de masse aux mailles)
+ * \param  FluxAuxFaces, phiFace1 (flux aux faces de la phase 1)
  * \return RightFluxMasse, LeftFluxMasse
  *******************************************************************************
  */
@@ -602,30 +632,30 @@ void Remap::getRightAndLeftFluxMasseViaVol2(const int nbmat,
     if (VerticalFaceOfNode(pNodes)[0] != -1) {
       RightFluxMassePartielle(pNodes)[imat] +=
           varlp->rLagrange(cfCell1) *
-          (FluxFace2(cfCell1, fOfcfCell1)[imat] *
+          (getFluxFaceOfCell(2, cfCell1, fOfcfCell1)[imat] *
                varlp->outerFaceNormal(cfCell1, fOfcfCell1)[0] +
-           FluxFace2(cfCell1, frOfcfCell1)[imat] *
+           getFluxFaceOfCell(2, cfCell1, frOfcfCell1)[imat] *
                varlp->outerFaceNormal(cfCell1, frOfcfCell1)[0]);
       LeftFluxMassePartielle(pNodes)[imat] +=
           varlp->rLagrange(cbCell1) *
-          (FluxFace2(cbCell1, fOfcbCell1)[imat] *
+          (getFluxFaceOfCell(2, cbCell1, fOfcbCell1)[imat] *
                varlp->outerFaceNormal(cbCell1, fOfcbCell1)[0] +
-           FluxFace2(cbCell1, flOfcbCell1)[imat] *
+           getFluxFaceOfCell(2, cbCell1, flOfcbCell1)[imat] *
                varlp->outerFaceNormal(cbCell1, flOfcbCell1)[0]);
     }
 
     if (VerticalFaceOfNode(pNodes)[1] != -1) {
       RightFluxMassePartielle(pNodes)[imat] +=
           varlp->rLagrange(cfCell2) *
-          (FluxFace2(cfCell2, fOfcfCell2)[imat] *
+          (getFluxFaceOfCell(2, cfCell2, fOfcfCell2)[imat] *
                varlp->outerFaceNormal(cfCell2, fOfcfCell2)[0] +
-           FluxFace2(cfCell2, frOfcfCell2)[imat] *
+           getFluxFaceOfCell(2, cfCell2, frOfcfCell2)[imat] *
                varlp->outerFaceNormal(cfCell2, frOfcfCell2)[0]);
       LeftFluxMassePartielle(pNodes)[imat] +=
           varlp->rLagrange(cbCell2) *
-          (FluxFace2(cbCell2, fOfcbCell2)[imat] *
+          (getFluxFaceOfCell(2, cbCell2, fOfcbCell2)[imat] *
                varlp->outerFaceNormal(cbCell2, fOfcbCell2)[0] +
-           FluxFace2(cbCell2, flOfcbCell2)[imat] *
+           getFluxFaceOfCell(2, cbCell2, flOfcbCell2)[imat] *
                varlp->outerFaceNormal(cbCell2, flOfcbCell2)[0]);
     }
     // if (pNodes == 300 || pNodes == 301 || pNodes == 302) {
@@ -661,7 +691,7 @@ void Remap::getRightAndLeftFluxMasseViaVol2(const int nbmat,
  *       pour l'etape 1 de la projection
  *  Méthode A2
  *
- * \param  FluxFace1 (flux de masse aux mailles)
+ * \param  FluxAuxFaces, phiFace1 (flux aux faces de la phase 1)
  * \return TopFluxMasse, BottomFluxMasse
  *******************************************************************************
  */
@@ -684,29 +714,29 @@ void Remap::getTopAndBottomFluxMasseViaVol1(const int nbmat,
     if (HorizontalFaceOfNode(pNodes)[0] != -1) {
       TopFluxMassePartielle(pNodes)[imat] +=
           varlp->rLagrange(cbCell1) *
-          (FluxFace1(cbCell1, fOfcbCell1)[imat] *
+          (getFluxFaceOfCell(1, cbCell1, fOfcbCell1)[imat] *
                varlp->outerFaceNormal(cbCell1, fOfcbCell1)[1] +
-           FluxFace1(cbCell1, ftOfcbCell1)[imat] *
+           getFluxFaceOfCell(1, cbCell1, ftOfcbCell1)[imat] *
                varlp->outerFaceNormal(cbCell1, ftOfcbCell1)[1]);
       BottomFluxMassePartielle(pNodes)[imat] +=
           varlp->rLagrange(cfCell1) *
-          (FluxFace1(cfCell1, fOfcfCell1)[imat] *
+          (getFluxFaceOfCell(1, cfCell1, fOfcfCell1)[imat] *
                varlp->outerFaceNormal(cfCell1, fOfcfCell1)[1] +
-           FluxFace1(cfCell1, fbOfcfCell1)[imat] *
+           getFluxFaceOfCell(1, cfCell1, fbOfcfCell1)[imat] *
                varlp->outerFaceNormal(cfCell1, fbOfcfCell1)[1]);
     }
     if (HorizontalFaceOfNode(pNodes)[1] != -1) {
       TopFluxMassePartielle(pNodes)[imat] +=
           varlp->rLagrange(cbCell2) *
-          (FluxFace1(cbCell2, fOfcbCell2)[imat] *
+          (getFluxFaceOfCell(1, cbCell2, fOfcbCell2)[imat] *
                varlp->outerFaceNormal(cbCell2, fOfcbCell2)[1] +
-           FluxFace1(cbCell2, ftOfcbCell2)[imat] *
+           getFluxFaceOfCell(1, cbCell2, ftOfcbCell2)[imat] *
                varlp->outerFaceNormal(cbCell2, ftOfcbCell2)[1]);
       BottomFluxMassePartielle(pNodes)[imat] +=
           varlp->rLagrange(cfCell2) *
-          (FluxFace1(cfCell2, fOfcfCell2)[imat] *
+          (getFluxFaceOfCell(1, cfCell2, fOfcfCell2)[imat] *
                varlp->outerFaceNormal(cfCell2, fOfcfCell2)[1] +
-           FluxFace1(cfCell2, fbOfcfCell2)[imat] *
+           getFluxFaceOfCell(1, cfCell2, fbOfcfCell2)[imat] *
                varlp->outerFaceNormal(cfCell2, fbOfcfCell2)[1]);
     }
     if (nbfaces != 0) {
@@ -726,7 +756,7 @@ void Remap::getTopAndBottomFluxMasseViaVol1(const int nbmat,
  *       pour l'etape 2 de la projection
  *  Méthode A2
  *
- * \param  FluxFace2 (flux de masse aux mailles)
+ * \param  FluxAuxFaces, phiFace2 (flux aux faces de la phase 2)
  * \return TopFluxMasse, BottomFluxMasse
  *******************************************************************************
  */
@@ -748,29 +778,29 @@ void Remap::getTopAndBottomFluxMasseViaVol2(const int nbmat,
     if (HorizontalFaceOfNode(pNodes)[0] != -1) {
       TopFluxMassePartielle(pNodes)[imat] +=
           varlp->rLagrange(cbCell1) *
-          (FluxFace2(cbCell1, fOfcbCell1)[imat] *
+          (getFluxFaceOfCell(2, cbCell1, fOfcbCell1)[imat] *
                varlp->outerFaceNormal(cbCell1, fOfcbCell1)[1] +
-           FluxFace2(cbCell1, ftOfcbCell1)[imat] *
+           getFluxFaceOfCell(2, cbCell1, ftOfcbCell1)[imat] *
                varlp->outerFaceNormal(cbCell1, ftOfcbCell1)[1]);
       BottomFluxMassePartielle(pNodes)[imat] +=
           varlp->rLagrange(cfCell1) *
-          (FluxFace2(cfCell1, fOfcfCell1)[imat] *
+          (getFluxFaceOfCell(2, cfCell1, fOfcfCell1)[imat] *
                varlp->outerFaceNormal(cfCell1, fOfcfCell1)[1] +
-           FluxFace2(cfCell1, fbOfcfCell1)[imat] *
+           getFluxFaceOfCell(2, cfCell1, fbOfcfCell1)[imat] *
                varlp->outerFaceNormal(cfCell1, fbOfcfCell1)[1]);
     }
     if (HorizontalFaceOfNode(pNodes)[1] != -1) {
       TopFluxMassePartielle(pNodes)[imat] +=
           varlp->rLagrange(cbCell2) *
-          (FluxFace2(cbCell2, fOfcbCell2)[imat] *
+          (getFluxFaceOfCell(2, cbCell2, fOfcbCell2)[imat] *
                varlp->outerFaceNormal(cbCell2, fOfcbCell2)[1] +
-           FluxFace2(cbCell2, ftOfcbCell2)[imat] *
+           getFluxFaceOfCell(2, cbCell2, ftOfcbCell2)[imat] *
                varlp->outerFaceNormal(cbCell2, ftOfcbCell2)[1]);
       BottomFluxMassePartielle(pNodes)[imat] +=
           varlp->rLagrange(cfCell2) *
-          (FluxFace2(cfCell2, fOfcfCell2)[imat] *
+          (getFluxFaceOfCell(2, cfCell2, fOfcfCell2)[imat] *
                varlp->outerFaceNormal(cfCell2, fOfcfCell2)[1] +
-           FluxFace2(cfCell2, fbOfcfCell2)[imat] *
+           getFluxFaceOfCell(2, cfCell2, fbOfcfCell2)[imat] *
                varlp->outerFaceNormal(cfCell2, fbOfcfCell2)[1]);
     }
     if (nbfaces != 0) {
@@ -790,7 +820,7 @@ void Remap::getTopAndBottomFluxMasseViaVol2(const int nbmat,
  *       pour l'etape 1 de la projection
  *  Méthode Pente Borne
  *
- * \param  FluxFace1 (flux de masse aux mailles)
+ * \param  FluxAuxFaces, phiFace1 (flux aux faces de la phase 1)
  * \return RightFluxMasse, LeftFluxMasse
  *******************************************************************************
  */
@@ -859,7 +889,7 @@ void Remap::getRightAndLeftFluxMassePB1(const int nbmat, const size_t pNodes) {
  *       pour l'etape 2 de la projection
  *  Méthode Pente Borne
  *
- * \param  FluxFace2 (flux de masse aux mailles)
+ * \param  FluxAuxFaces, phiFace2 (flux aux faces de la phase 2)
  * \return RightFluxMasse, LeftFluxMasse
  *******************************************************************************
  */
@@ -926,7 +956,7 @@ void Remap::getRightAndLeftFluxMassePB2(const int nbmat, const size_t pNodes) {
  *       pour l'etape 2 de la projection
  *  Méthode Pente Borne
  *
- * \param  FluxFace2 (flux de masse aux mailles)
+ * \param  FluxAuxFaces, phiFace2 (flux aux faces de la phase 2)
  * \return TopFluxMasse, BottomFluxMasse
  *******************************************************************************
  */
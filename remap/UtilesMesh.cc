@@ -1,81 +1,109 @@
-#include "Remap.h"                 // for Remap, Remap::Options
-#include "mesh/CartesianMesh2D.h"  // for CartesianMesh2D
-#include "utils/Utils.h"           // for indexOf
+#include "../includes/TailleMemoire.h"  // for allocatedBytes
+#include "Remap.h"                       // for Remap, Remap::Options
+#include "mesh/CartesianMesh2D.h"        // for CartesianMesh2D
+#include "utils/Utils.h"                 // for indexOf
 /**
  *******************************************************************************
- * \file getLeftCells
- * \brief retourne l'Id de la cellule à gauche d'une cellule donnee
- * \param  cells
- * \return cbId (ou cells si il n'y a pas de cellule à gauche)
+ * \file fillGhostCells
+ * \brief remplit la couronne de mailles fantomes aux deux extremites des
+ *        lignes de la direction projetee : Phi, mixte, pure, U/v a l'ordre 3
+ *        et largeur HvLagrange de la maille dans cette direction
+ *        condition aux limites de la projection : une maille fantome prend
+ *        la valeur de la maille de bord qui lui fait face (gradient nul)
+ *        les mailles du domaine ne sont pas recopiees
+ * \param  U (ULagrange pour la phase 1, Uremap1 pour la phase 2), exy
+ * \return PhiHalo, HvHalo, mixteHalo, pureHalo, UvHalo
  *******************************************************************************
  */
-int Remap::getLeftCells(const int cells) {
-  int flLeftFaceOfCellC(mesh->getLeftFaceOfCell(cells));
-  size_t flId(flLeftFaceOfCellC);
-  int flFaces(utils::indexOf(mesh->getFaces(), flId));
-  int cbBackCellF(mesh->getBackCell(flId));
-  int cbId(cbBackCellF);
-  if (cbId == -1)
-    return cells;
-  else
-    return cbId;
-}
-/**
- *******************************************************************************
- * \file getRightCells
- * \brief retourne l'Id de la cellule à droite d'une cellule donnee
- * \param  cells
- * \return cbId (ou cells si il n'y a pas de cellule à droite)
- *******************************************************************************
- */
-int Remap::getRightCells(const int cells) {
-  int frRightFaceOfCellC(mesh->getRightFaceOfCell(cells));
-  size_t frId(frRightFaceOfCellC);
-  int frFaces(utils::indexOf(mesh->getFaces(), frId));
-  int cfFrontCellF(mesh->getFrontCell(frId));
-  int cfId(cfFrontCellF);
-  if (cfId == -1)
-    return cells;
-  else
-    return cfId;
+void Remap::fillGhostCells(const Kokkos::View<RealArray1D<nbequamax>*>& U,
+                           RealArray1D<dim> exy) noexcept {
+  const bool dirX(exy[0] == 1);
+  // HvLagrange : demi-somme des longueurs des faces paralleles a exy
+  const int f1FacesOfCellC(dirX ? CartesianMesh2D::Bottom
+                                : CartesianMesh2D::Right);
+  const int f2FacesOfCellC(dirX ? CartesianMesh2D::Top
+                                : CartesianMesh2D::Left);
+  const int g(mesh->getNbGhostLayers());
+  const int n(dirX ? mesh->getNbXQuads() : mesh->getNbYQuads());
+  const int nbLignes(dirX ? mesh->getNbYQuads() : mesh->getNbXQuads());
+  Kokkos::parallel_for(
+      "fillGhostCells", nbLignes * 2 * g, KOKKOS_LAMBDA(const int& idx) {
+        // g mailles avant la premiere maille de la ligne, g apres la derniere
+        const int ligne(idx / (2 * g));
+        const int s(idx % (2 * g));
+        const int k(s < g ? s - g : n + s - g);
+        const int i(dirX ? ligne : k);
+        const int j(dirX ? k : ligne);
+        int hCells(mesh->ghostCellAt(i, j));
+        int cCells(mesh->clampedCellAt(i, j));
+        auto facesOfCellC(mesh->getFacesOfCell(cCells));
+        int f1Faces(mesh->getFaceIndex(facesOfCellC[f1FacesOfCellC]));
+        int f2Faces(mesh->getFaceIndex(facesOfCellC[f2FacesOfCellC]));
+        PhiHalo(hCells) = varlp->Phi(cCells);
+        HvHalo(hCells) = 0.5 * varlp->faceLengthLagrange(f1Faces) +
+                         0.5 * varlp->faceLengthLagrange(f2Faces);
+        mixteHalo(hCells) = varlp->mixte(cCells);
+        pureHalo(hCells) = varlp->pure(cCells);
+        if (options->projectionOrder == 3)
+          UvHalo(hCells) = U(cCells) / varlp->vLagrange(cCells);
+      });
 }
 /**
  *******************************************************************************
- * \file getBottomCells
- * \brief retourne l'Id de la cellule en dessous d'une cellule donnee
- * \param  cells
- * \return cbId (ou cells si il n'y a pas de cellule en dessous)
+ * \file initDualRemap
+ * \brief allocation des tableaux de la projection duale (grandeurs aux
+ *        noeuds) et calcul des faces des noeuds, pour les schemas qui
+ *        projettent la vitesse nodale (Vnr)
+ * \return avecProjectionDuale, VerticalFaceOfNode, HorizontalFaceOfNode
  *******************************************************************************
  */
-int Remap::getBottomCells(const int cells) {
-  int fbBottomFaceOfCellC(mesh->getBottomFaceOfCell(cells));
-  size_t fbId(fbBottomFaceOfCellC);
-  int fbFaces(utils::indexOf(mesh->getFaces(), fbId));
-  int cfFrontCellF(mesh->getFrontCell(fbId));
-  int cfId(cfFrontCellF);
-  if (cfId == -1)
-    return cells;
-  else
-    return cfId;
+void Remap::initDualRemap() {
+  avecProjectionDuale = true;
+  UDualremap1 = Kokkos::View<RealArray1D<nbequamax>*>("UDualremap1", nbNodes);
+  gradDualPhi1 = Kokkos::View<RealArray1D<nbequamax>*>("gradDualPhi1", nbNodes);
+  gradDualPhi2 = Kokkos::View<RealArray1D<nbequamax>*>("gradDualPhi2", nbNodes);
+  if (DualphiFlux1.extent(0) == 0) {
+    DualphiFlux1 =
+        Kokkos::View<RealArray1D<nbequamax>*>("DualphiFlux1", nbCells);
+    DualphiFlux2 =
+        Kokkos::View<RealArray1D<nbequamax>*>("DualphiFlux2", nbCells);
+  }
+  RightFluxMassePartielle = MaterialView("FluxMassePartielle", nbNodes);
+  LeftFluxMassePartielle = MaterialView("FluxMassePartielle", nbNodes);
+  TopFluxMassePartielle = MaterialView("FluxMassePartielle", nbNodes);
+  BottomFluxMassePartielle = MaterialView("FluxMassePartielle", nbNodes);
+  RightFluxMasse = Kokkos::View<double*>("FluxMasse", nbNodes);
+  LeftFluxMasse = Kokkos::View<double*>("FluxMasse", nbNodes);
+  TopFluxMasse = Kokkos::View<double*>("FluxMasse", nbNodes);
+  BottomFluxMasse = Kokkos::View<double*>("FluxMasse", nbNodes);
+  VerticalFaceOfNode = Kokkos::View<RealArray1D<2>*>("VFaceOfNode", nbNodes);
+  HorizontalFaceOfNode = Kokkos::View<RealArray1D<2>*>("HFaceOfNode", nbNodes);
+  TopupwindVelocity =
+      Kokkos::View<RealArray1D<dimplus1>*>("upwindVelocity", nbNodes);
+  BottomupwindVelocity =
+      Kokkos::View<RealArray1D<dimplus1>*>("upwindVelocity", nbNodes);
+  RightupwindVelocity =
+      Kokkos::View<RealArray1D<dimplus1>*>("upwindVelocity", nbNodes);
+  LeftupwindVelocity =
+      Kokkos::View<RealArray1D<dimplus1>*>("upwindVelocity", nbNodes);
+  FacesOfNode();
 }
 /**
  *******************************************************************************
- * \file getTopCells
- * \brief retourne l'Id de la cellule au dessus d'une cellule donnee
- * \param  cells
- * \return cbId (ou cells si il n'y a pas de cellule au dessus)
+ * \file getAllocatedBytes
+ * \brief taille memoire des tableaux alloues par la projection
  *******************************************************************************
  */
-int Remap::getTopCells(const int cells) {
-  int ftTopFaceOfCellC(mesh->getTopFaceOfCell(cells));
-  size_t ftId(ftTopFaceOfCellC);
-  int ftFaces(utils::indexOf(mesh->getFaces(), ftId));
-  int cbBackCellF(mesh->getBackCell(ftId));
-  int cbId(cbBackCellF);
-  if (cbId == -1)
-    return cells;
-  else
-    return cbId;
+size_t Remap::getAllocatedBytes() const noexcept {
+  return allocatedBytes(Uremap1, UDualremap1, phiFace1, phiFace2, DualphiFlux1,
+                        DualphiFlux2, RightFluxMassePartielle,
+                        LeftFluxMassePartielle, TopFluxMassePartielle,
+                        BottomFluxMassePartielle, RightFluxMasse, LeftFluxMasse,
+                        TopFluxMasse, BottomFluxMasse, VerticalFaceOfNode,
+                        HorizontalFaceOfNode, TopupwindVelocity,
+                        BottomupwindVelocity, RightupwindVelocity,
+                        LeftupwindVelocity, gradDualPhi1, gradDualPhi2, PhiHalo,
+                        HvHalo, mixteHalo, pureHalo, UvHalo, FluxAuxFaces);
 }
 /**
  *******************************************************************************
@@ -99,7 +127,7 @@ void Remap::FacesOfNode() {
       "computenodalfluxes", nbInnerVerticalFaces,
       KOKKOS_LAMBDA(const int& fInnerVerticalFaces) {
         size_t fId(innerVerticalFaces[fInnerVerticalFaces]);
-        int fFaces(utils::indexOf(mesh->getFaces(), fId));
+        int fFaces(mesh->getFaceIndex(fId));
         int n1FirstNodeOfFaceF(mesh->getFirstNodeOfFace(fId));
         int n1Id(n1FirstNodeOfFaceF);
         int n1Nodes(n1Id);
@@ -123,7 +151,7 @@ void Remap::FacesOfNode() {
       "computenodalfluxes", nbInnerHorizontalFaces,
       KOKKOS_LAMBDA(const int& fInnerHorizontalFaces) {
         size_t fId(innerHorizontalFaces[fInnerHorizontalFaces]);
-        int fFaces(utils::indexOf(mesh->getFaces(), fId));
+        int fFaces(mesh->getFaceIndex(fId));
         int n1FirstNodeOfFaceF(mesh->getFirstNodeOfFace(fId));
         int n1Id(n1FirstNodeOfFaceF);
         int n1Nodes(n1Id);
@@ -15,11 +15,10 @@
  * \return valeur du gradient Vertical dual et limité
  *******************************************************************************
  */
-template <size_t d>
+template <class Limiteur, size_t d>
 RealArray1D<d> Remap::computeDualVerticalGradPhi(RealArray1D<d> grad_top,
                                                  RealArray1D<d> grad_bottom,
                                                  const size_t pNode) {
-  int limiter = limiteurs->projectionLimiterId;
   int TopNode = mesh->getTopNode(pNode);
   int BottomNode = mesh->getBottomNode(pNode);
 
@@ -60,9 +59,9 @@ RealArray1D<d> Remap::computeDualVerticalGradPhi(RealArray1D<d> grad_top,
   }
 
   RealArray1D<d> res;
-  res = computeAndLimitGradPhi(limiter, grad_top, grad_bottom,
-                               varlp->DualPhi(pNode), varlp->DualPhi(TopNode),
-                               varlp->DualPhi(BottomNode), h0, hplus, hmoins);
+  res = computeAndLimitGradPhi<Limiteur>(
+      grad_top, grad_bottom, varlp->DualPhi(pNode), varlp->DualPhi(TopNode),
+      varlp->DualPhi(BottomNode), h0, hplus, hmoins);
   // std::cout << " Nodes " << pNode << " gradV " << res << std::endl;
   // std::cout << " Nodes " << BottomBottomNode << " " << BottomNode << " " <<
   //   pNode << " " <<  TopNode << " " << TopTopNode << std::endl;
@@ -79,11 +78,10 @@ RealArray1D<d> Remap::computeDualVerticalGradPhi(RealArray1D<d> grad_top,
  * \return valeur du gradient Horizontal dual et limité
  *******************************************************************************
  */
-template <size_t d>
+template <class Limiteur, size_t d>
 RealArray1D<d> Remap::computeDualHorizontalGradPhi(RealArray1D<d> grad_right,
                                                    RealArray1D<d> grad_left,
                                                    const size_t pNode) {
-  int limiter = limiteurs->projectionLimiterId;
   int LeftNode = mesh->getLeftNode(pNode);
   int RightNode = mesh->getRightNode(pNode);
 
@@ -122,9 +120,9 @@ RealArray1D<d> Remap::computeDualHorizontalGradPhi(RealArray1D<d> grad_right,
   }
 
   RealArray1D<d> res;
-  res = computeAndLimitGradPhi(limiter, grad_right, grad_left,
-                               varlp->DualPhi(pNode), varlp->DualPhi(RightNode),
-                               varlp->DualPhi(LeftNode), h0, hplus, hmoins);
+  res = computeAndLimitGradPhi<Limiteur>(
+      grad_right, grad_left, varlp->DualPhi(pNode), varlp->DualPhi(RightNode),
+      varlp->DualPhi(LeftNode), h0, hplus, hmoins);
   // std::cout << " Nodes " << pNode << " gradH " << res << std::endl;
   return res;
 }
@@ -138,32 +136,36 @@ RealArray1D<d> Remap::computeDualHorizontalGradPhi(RealArray1D<d> grad_right,
  * \return valeur du gradient limité de chaque variables phi
  *******************************************************************************
  */
-template <size_t d>
+template <class Limiteur, size_t d>
 RealArray1D<d> Remap::computeAndLimitGradPhi(
-    int projectionLimiterId, RealArray1D<d> gradphiplus,
-    RealArray1D<d> gradphimoins, RealArray1D<d> phi, RealArray1D<d> phiplus,
-    RealArray1D<d> phimoins, double h0, double hplus, double hmoins) {
+    RealArray1D<d> gradphiplus, RealArray1D<d> gradphimoins, RealArray1D<d> phi,
+    RealArray1D<d> phiplus, RealArray1D<d> phimoins, double h0, double hplus,
+    double hmoins) {
   RealArray1D<d> res;
-  if (projectionLimiterId < limiteurs->minmodG) {
-    // std::cout << " Passage gradient limite Classique " << std::endl;
-    for (size_t i = 0; i < d; i++) {
-      res[i] = (fluxLimiter(projectionLimiterId,
-                            divideNoExcept(gradphiplus[i], gradphimoins[i])) *
-                    gradphimoins[i] +
-                fluxLimiter(projectionLimiterId,
-                            divideNoExcept(gradphimoins[i], gradphiplus[i])) *
-                    gradphiplus[i]) /
-               2.0;
-    }
-    return res;
-  } else {
-    // std::cout << " Passage gradient limite Genéralisé " << std::endl;
-    for (size_t i = 0; i < d; i++) {
-      res[i] =
-          fluxLimiterG(projectionLimiterId, gradphiplus[i], gradphimoins[i],
-                        phi[i], phiplus[i], phimoins[i], h0, hplus, hmoins);
-    }
-    return res;
+  for (size_t i = 0; i < d; i++) {
+    res[i] = Limiteur::gradient(gradphiplus[i], gradphimoins[i], phi[i],
+                                phiplus[i], phimoins[i], h0, hplus, hmoins);
+  }
+  return res;
+}
+/**
+ *******************************************************************************
+ * \file computeY0
+ * \brief calcul des Seuils de monotonie des reconstructions lineraires
+ *  simple-pente pour l'option pente-borne, pour chaque variable phi
+ *  calcules une fois par maille pour les flux arriere et avant
+ *
+ * \param  phiplus, phimoins, h0, hplus, hmoins
+ * \return y0plus, y0moins
+ *******************************************************************************
+ */
+template <class Limiteur, size_t d>
+void Remap::computeY0(RealArray1D<d> phiplus, RealArray1D<d> phimoins,
+                      double h0, double hplus, double hmoins,
+                      RealArray1D<d>& y0plus, RealArray1D<d>& y0moins) {
+  for (size_t i = 0; i < d; i++) {
+    Limiteur::seuils(phiplus[i], phimoins[i], h0, hplus, hmoins, y0plus[i],
+                     y0moins[i]);
   }
 }
 /**
@@ -216,9 +218,10 @@ RealArray1D<d> Remap::computeVecFluxOrdre3(
 template <size_t d>
 void Remap::computeFluxPP(RealArray1D<d> gradphi, RealArray1D<d> phi,
                           RealArray1D<d> phiplus, RealArray1D<d> phimoins,
-                          double h0, double hplus, double hmoins,
-                          double face_normal_velocity, double deltat_n,
-                          int type, int cell, double flux_threhold,
+                          double h0, RealArray1D<d> Y0plus,
+                          RealArray1D<d> Y0moins, double face_normal_velocity,
+                          double deltat_n, int type, int cell,
+                          double flux_threhold,
                           int projectionPlateauPenteComplet,
                           double dual_normal_velocity, int calcul_flux_dual,
                           RealArray1D<d> *pFlux, RealArray1D<d> *pFlux_dual) {
@@ -236,21 +239,16 @@ void Remap::computeFluxPP(RealArray1D<d> gradphi, RealArray1D<d> phi,
       0.5 * (dual_normal_velocity + abs(dual_normal_velocity)) * deltat_n;
   int cas_PP = 0;
   for (size_t i = 0; i < nbequamax; i++) {
-    // calcul des seuils y0plus, y0moins pour cCells
-    y0plus = computeY0(limiteurs->projectionLimiterId, phi[i], phiplus[i],
-                       phimoins[i], h0, hplus, hmoins, 0);
-    y0moins = computeY0(limiteurs->projectionLimiterId, phi[i], phiplus[i],
-                        phimoins[i], h0, hplus, hmoins, 1);
+    // seuils y0plus, y0moins de cCells calcules par computeY0
+    y0plus = Y0plus[i];
+    y0moins = Y0moins[i];
 
     // calcul des points d'intersections xd,xg
-    xg = computexgxd(phi[i], phiplus[i], phimoins[i], h0, y0plus, y0moins, 0);
-    xd = computexgxd(phi[i], phiplus[i], phimoins[i], h0, y0plus, y0moins, 1);
+    computexgxd(phi[i], phiplus[i], phimoins[i], h0, y0plus, y0moins, xg, xd);
 
     // calcul des valeurs sur ces points d'intersections
-    yg = computeygyd(phi[i], phiplus[i], phimoins[i], h0, y0plus, y0moins,
-                     gradphi[i], 0);
-    yd = computeygyd(phi[i], phiplus[i], phimoins[i], h0, y0plus, y0moins,
-                     gradphi[i], 1);
+    computeygyd(phi[i], phiplus[i], phimoins[i], h0, y0plus, y0moins,
+                gradphi[i], yg, yd);
 
     if (type == 0)  // flux arriere ou en dessous de cCells, integration entre
                     // -h0/2. et -h0/2.+abs(face_normal_velocity)*deltat_n
@@ -418,7 +416,8 @@ void Remap::computeFluxPP(RealArray1D<d> gradphi, RealArray1D<d> phi,
 template <size_t d>
 void Remap::computeFluxPPPure(RealArray1D<d> gradphi, RealArray1D<d> phi,
                               RealArray1D<d> phiplus, RealArray1D<d> phimoins,
-                              double h0, double hplus, double hmoins,
+                              double h0, RealArray1D<d> Y0plus,
+                              RealArray1D<d> Y0moins,
                               double face_normal_velocity, double deltat_n,
                               int type, int cell, double flux_threhold,
                               int projectionPlateauPenteComplet,
@@ -440,21 +439,16 @@ void Remap::computeFluxPPPure(RealArray1D<d> gradphi, RealArray1D<d> phi,
   int cas_PP = 0;
   // on ne fait que la projection des volumes et masses
   for (size_t i = 0; i < nbequamax; i++) {
-    // calcul des seuils y0plus, y0moins pour cCells
-    y0plus = computeY0(limiteurs->projectionLimiterIdPure, phi[i], phiplus[i],
-                       phimoins[i], h0, hplus, hmoins, 0);
-    y0moins = computeY0(limiteurs->projectionLimiterIdPure, phi[i], phiplus[i],
-                        phimoins[i], h0, hplus, hmoins, 1);
+    // seuils y0plus, y0moins de cCells calcules par computeY0
+    y0plus = Y0plus[i];
+    y0moins = Y0moins[i];
 
     // calcul des points d'intersections xd,xg
-    xg = computexgxd(phi[i], phiplus[i], phimoins[i], h0, y0plus, y0moins, 0);
-    xd = computexgxd(phi[i], phiplus[i], phimoins[i], h0, y0plus, y0moins, 1);
+    computexgxd(phi[i], phiplus[i], phimoins[i], h0, y0plus, y0moins, xg, xd);
 
     // calcul des valeurs sur ces points d'intersections
-    yg = computeygyd(phi[i], phiplus[i], phimoins[i], h0, y0plus, y0moins,
-                     gradphi[i], 0);
-    yd = computeygyd(phi[i], phiplus[i], phimoins[i], h0, y0plus, y0moins,
-                     gradphi[i], 1);
+    computeygyd(phi[i], phiplus[i], phimoins[i], h0, y0plus, y0moins,
+                gradphi[i], yg, yd);
 
     if (type == 0)  // flux arriere ou en dessous de cCells, integration entre
                     // -h0/2. et -h0/2.+abs(face_normal_velocity)*deltat_n
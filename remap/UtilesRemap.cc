@@ -5,149 +5,6 @@
 
 #include "Remap.h"                // for Remap, Remap::Options
 #include "types/MathFunctions.h"  // for min, max
-/**
- *******************************************************************************
- * \file fluxLimiter
- * \brief retourne le valeur du limiteur demandé par la méthode classique
- *        qui suppose que les 3 mailles (utilise pour le calcul des gradient)
- *        ont la meme largeur
- * \param  r = gradmoins / gradplus ou gradplus / gradmoins
- * \return valeur du limiteur demandé
- *******************************************************************************
- */
-double Remap::fluxLimiter(int projectionLimiterId, double r) {
-  if (projectionLimiterId == limiteurs->minmod) {
-    return MathFunctions::max(0.0, MathFunctions::min(1.0, r));
-  } else if (projectionLimiterId == limiteurs->superBee) {
-    return MathFunctions::max(
-        0.0, MathFunctions::max(MathFunctions::min(2.0 * r, 1.0),
-                                MathFunctions::min(r, 2.0)));
-  } else if (projectionLimiterId == limiteurs->vanLeer) {
-    if (r <= 0.0)
-      return 0.0;
-    else
-      return 2.0 * r / (1.0 + r);
-  } else
-    return 0.0;  // ordre 1
-}
-/**
- *******************************************************************************
- * \file fluxLimiterG
- * \brief retourne le valeur du limiteur demandé par la méthode exacte
- *        qui ne suppose pas que les 3 mailles (utilise pour le calcul des
- *gradient) ont la meme largeur (h0 != hplus != hmoins) \param  h0, hplus,
- *hmoins, gradplus, gradmoins \return valeur du limiteur demandé
- *******************************************************************************
- */
-double Remap::fluxLimiterG(int projectionLimiterId, double gradplus,
-                           double gradmoins, double y0, double yplus,
-                           double ymoins, double h0, double hplus,
-                           double hmoins) {
-  double grady, gradM, gradMplus, gradMmoins;
-  // limitation rupture de pente (formule 16 si on utilise pas le plateau pente)
-  if (gradplus * gradmoins < 0.0) return 0.;
-
-  if (projectionLimiterId == limiteurs->minmodG)  // formule 9c
-  {
-    if ((yplus - ymoins) > 0.)
-      grady = MathFunctions::min(fabs(gradplus), fabs(gradmoins));
-    else
-      grady = -MathFunctions::min(fabs(gradplus), fabs(gradmoins));
-  } else if (projectionLimiterId == limiteurs->superBeeG)  // formule 9g
-  {
-    if ((yplus - ymoins) > 0.)
-      grady = MathFunctions::max(fabs(gradplus), fabs(gradmoins));
-    else
-      grady = -MathFunctions::max(fabs(gradplus), fabs(gradmoins));
-  } else if (projectionLimiterId == limiteurs->vanLeerG)  // formule 9e
-  {
-    double lambdaplus = (h0 / 2. + hplus) / (h0 + hplus + hmoins);
-    double lambdamoins = (h0 / 2. + hmoins) / (h0 + hplus + hmoins);
-    if ((lambdaplus * gradplus + lambdamoins * gradmoins) != 0.) {
-      grady = gradplus * gradmoins /
-              (lambdaplus * gradplus + lambdamoins * gradmoins);
-    } else
-      grady = 0.;
-  } else if (projectionLimiterId == limiteurs->ultrabeeG) {
-    grady = (yplus - ymoins) / h0;
-  } else if (projectionLimiterId == limiteurs->arithmeticG) {
-    double lambdaplus = (h0 / 2. + hplus) / (h0 + hplus + hmoins);
-    double lambdamoins = (h0 / 2. + hmoins) / (h0 + hplus + hmoins);
-    grady = lambdamoins * gradplus + lambdaplus * gradmoins;
-  }
-  // limitation simple-pente (formule 10)
-  gradMplus = gradplus * (h0 + hplus) / h0;
-  gradMmoins = gradmoins * (h0 + hmoins) / h0;
-  gradM = MathFunctions::min(fabs(gradMplus), fabs(gradMmoins));
-  if ((yplus - ymoins) > 0.)
-    grady = MathFunctions::min(fabs(gradM), fabs(grady));
-  else
-    grady = -MathFunctions::min(fabs(gradM), fabs(grady));
-
-  return grady;
-}
-/**
- *******************************************************************************
- * \file computeY0
- * \brief calcul des Seuils de monotonie des reconstructions lineraires
- *  simple-pente pour l'option pente-borne
- *
- * \param  h0, hplus, hmoins, y0, yplus, ymoins
- * \return y0plus, y0moins
- *******************************************************************************
- */
-double Remap::computeY0(int projectionLimiterId, double y0, double yplus,
-                        double ymoins, double h0, double hplus, double hmoins,
-                        int type) {
-  // retourne {{y0plus, y0moins}}
-  double y0plus = 0., y0moins = 0.;
-  if (projectionLimiterId == limiteurs->minmodG ||
-      projectionLimiterId == limiteurs->minmod)  // minmod
-  {
-    y0plus = yplus;
-    y0moins = ymoins;
-  } else if (projectionLimiterId == limiteurs->superBeeG ||
-             projectionLimiterId == limiteurs->superBee)  // superbee
-  {
-    y0plus = ((h0 + hmoins) * yplus + h0 * ymoins) / (2 * h0 + hmoins);
-    y0moins = ((h0 + hplus) * ymoins + h0 * yplus) / (2 * h0 + hplus);
-  } else if (projectionLimiterId == limiteurs->vanLeerG ||
-             projectionLimiterId == limiteurs->vanLeer)  // vanleer
-  {
-    double a = MathFunctions::min(yplus, ymoins);
-    double b = MathFunctions::max(yplus, ymoins);
-    double xplus = (h0 * h0 + 3 * h0 * hmoins + 2 * hmoins * hmoins) * yplus;
-    double xmoins = (h0 * h0 + 3 * h0 * hplus + 2 * hplus * hplus) * ymoins;
-    xplus +=
-        (h0 * h0 - h0 * hplus - 2 * hplus * hplus + 2 * h0 * hmoins) * ymoins;
-    xmoins +=
-        (h0 * h0 - h0 * hmoins - 2 * hmoins * hmoins + 2 * h0 * hplus) * yplus;
-    xplus /= (2 * h0 * h0 + 5 * h0 * hmoins + 2 * hmoins * hmoins - h0 * hplus -
-              2 * hplus * hplus);
-    xmoins /= (2 * h0 * h0 + 5 * h0 * hplus + 2 * hplus * hplus - h0 * hmoins -
-               2 * hmoins * hmoins);
-
-    y0plus = MathFunctions::min(MathFunctions::max(xplus, a), b);
-    y0moins = MathFunctions::min(MathFunctions::max(xmoins, a), b);
-  } else if (projectionLimiterId == limiteurs->ultrabeeG) {
-    y0plus = (yplus + ymoins) / 2.;
-    y0moins = (yplus + ymoins) / 2.;
-  } else if (projectionLimiterId == limiteurs->arithmeticG) {
-    y0plus = ((h0 + hmoins + hplus) * yplus + h0 * ymoins) /
-             (2 * h0 + hmoins + hplus);
-    y0moins = ((h0 + hmoins + hplus) * ymoins + h0 * yplus) /
-              (2 * h0 + hmoins + hplus);
-  } else if (projectionLimiterId == 3000) {
-    y0plus = yplus;
-    y0moins = ymoins;
-  }
-  if (type == 0)
-    return y0plus;
-  else if (type == 1)
-    return y0moins;
-  else
-    return 0.0;  // lancer forcement avec type 0 ou 1 mais warning compile
-}
 /**
  *******************************************************************************
  * \file computexgxd
@@ -158,10 +15,8 @@ double Remap::computeY0(int projectionLimiterId, double y0, double yplus,
  * \return xg, xd
  *******************************************************************************
  */
-double Remap::computexgxd(double y0, double yplus, double ymoins, double h0,
-                          double y0plus, double y0moins, int type) {
-  // retourne {{xg, xd}}
-  double xd = 0., xg = 0.;
+void Remap::computexgxd(double y0, double yplus, double ymoins, double h0,
+                        double y0plus, double y0moins, double& xg, double& xd) {
   double xplus = 1.;
   if (abs(y0plus - yplus) > options->threshold)
     xplus = (y0 - yplus) / (y0plus - yplus) - 1. / 2.;
@@ -170,12 +25,6 @@ double Remap::computexgxd(double y0, double yplus, double ymoins, double h0,
     xmoins = (y0 - ymoins) / (y0moins - ymoins) - 1. / 2.;
   xd = +h0 * MathFunctions::min(MathFunctions::max(xplus, -1. / 2.), 1. / 2.);
   xg = -h0 * MathFunctions::min(MathFunctions::max(xmoins, -1. / 2.), 1. / 2.);
-  if (type == 0)
-    return xg;
-  else if (type == 1)
-    return xd;
-  else
-    return 0.0;  // lancer forcement avec type 0 ou 1 mais warning compile
 }
 /**
  *******************************************************************************
@@ -187,11 +36,9 @@ double Remap::computexgxd(double y0, double yplus, double ymoins, double h0,
  * \return yg, yd
  *******************************************************************************
  */
-double Remap::computeygyd(double y0, double yplus, double ymoins, double h0,
-                          double y0plus, double y0moins, double grady,
-                          int type) {
-  // retourne {{yg, yd}}
-  double yd, yg;
+void Remap::computeygyd(double y0, double yplus, double ymoins, double h0,
+                        double y0plus, double y0moins, double grady, double& yg,
+                        double& yd) {
   double xtd = y0 + h0 / 2 * grady;
   double xtg = y0 - h0 / 2 * grady;
   double ad = MathFunctions::min(yplus, 2. * y0moins - ymoins);
@@ -200,12 +47,6 @@ double Remap::computeygyd(double y0, double yplus, double ymoins, double h0,
   double bg = MathFunctions::max(ymoins, 2. * y0plus - yplus);
   yd = MathFunctions::min(MathFunctions::max(xtd, ad), bd);
   yg = MathFunctions::min(MathFunctions::max(xtg, ag), bg);
-  if (type == 0)
-    return yg;
-  else if (type == 1)
-    return yd;
-  else
-    return 0.0;  // lancer forcement avec type 0 ou 1 mais warning compile
 }
 /**
  *******************************************************************************
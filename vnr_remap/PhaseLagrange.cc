@@ -3,6 +3,7 @@
 using namespace nablalib;
 
 #include "../includes/Freefunctions.h"
+#include "../includes/GeometrieLagrange.h"
 #include "types/MathFunctions.h"  // for max, min, dot, matVectProduct
 #include "utils/Utils.h"          // for Indexof
 
@@ -36,22 +37,23 @@ void Vnr::computeCellMass() noexcept {
  *******************************************************************************
  */
 void Vnr::computeNodeMass() noexcept {
-  Kokkos::parallel_for(nbNodes, KOKKOS_LAMBDA(const size_t& pNodes) {
-    const Id pId(pNodes);
-    const auto cells_of_node(mesh->getCellsOfNode(pId));
-    double reduction0(0.0);
-    {
-      const auto cellsOfNodeP(mesh->getCellsOfNode(pId));
-      const size_t nbCellsOfNodeP(cellsOfNodeP.size());
-      for (size_t cCellsOfNodeP = 0; cCellsOfNodeP < nbCellsOfNodeP;
-           cCellsOfNodeP++) {
-        const Id cId(cellsOfNodeP[cCellsOfNodeP]);
-        const size_t cCells(cId);
-        reduction0 = sumR0(reduction0, m_cell_mass(cCells));
-      }
-    }
-    m_node_mass(pNodes) = reduction0 / cells_of_node.size();
-  });
+  mesh->parallelForNodes(
+      "computeNodeMass", KOKKOS_LAMBDA(const size_t& pNodes) {
+        const Id pId(pNodes);
+        const auto cells_of_node(mesh->getCellsOfNode(pId));
+        double reduction0(0.0);
+        {
+          const auto cellsOfNodeP(mesh->getCellsOfNode(pId));
+          const size_t nbCellsOfNodeP(cellsOfNodeP.size());
+          for (size_t cCellsOfNodeP = 0; cCellsOfNodeP < nbCellsOfNodeP;
+               cCellsOfNodeP++) {
+            const Id cId(cellsOfNodeP[cCellsOfNodeP]);
+            const size_t cCells(cId);
+            reduction0 = sumR0(reduction0, m_cell_mass(cCells));
+          }
+        }
+        m_node_mass(pNodes) = reduction0 / cells_of_node.size();
+      });
 }
 /**
  *******************************************************************************
@@ -63,6 +65,7 @@ void Vnr::computeNodeMass() noexcept {
  * \return m_pseudo_viscosity_nplus1, m_pseudo_viscosity_env_nplus1
  *******************************************************************************
  */
+template <int NBMAT>
 void Vnr::computeArtificialViscosity() noexcept {
   double reductionP(numeric_limits<double>::min());
   Kokkos::Max<double> reducer(reductionP);
@@ -104,12 +107,12 @@ void Vnr::computeArtificialViscosity() noexcept {
       //m_pseudo_viscosity_nplus1(cCells) = reductionP;
       //}
     // pour chaque matériau
-    for (int imat = 0; imat < options->nbmat; ++imat)
+    for (int imat = 0; imat < NBMAT; ++imat)
       m_pseudo_viscosity_env_nplus1(cCells)[imat] =
           m_fracvol_env(cCells)[imat] * m_pseudo_viscosity_nplus1(cCells);
     //
     if (m_pseudo_viscosity_nplus1(cCells) < 0.) {
-      for (int imat = 0; imat < options->nbmat; ++imat)
+      for (int imat = 0; imat < NBMAT; ++imat)
 	std::cout << "\n Pb pseudo " << cCells
 		  << " pseudo env " << m_pseudo_viscosity_env_nplus1(cCells)[imat]
 		  << " pseudo " << m_pseudo_viscosity_nplus1(cCells)
@@ -121,6 +124,11 @@ void Vnr::computeArtificialViscosity() noexcept {
       
   });
 }
+void Vnr::computeArtificialViscosity() noexcept {
+  dispatchNbMat(options->nbmat, [this](auto nbmat) {
+    computeArtificialViscosity<decltype(nbmat)::value>();
+  });
+}
 /**
  *******************************************************************************
  * \file computeCornerNormal()
@@ -152,37 +160,6 @@ void Vnr::computeCornerNormal() noexcept {
       }
     }
   });
-}/**
- *******************************************************************************
- * \file updateCornerNormal()
- * \brief Calcul des vecteurs de coin à tn+1
- *
- * \param  m_node_coord_nplus1
- * \return m_cqs_nplus
- *******************************************************************************
- */
-void Vnr::updateCornerNormal() noexcept {
-  Kokkos::parallel_for(nbCells, KOKKOS_LAMBDA(const size_t& cCells) {
-    const Id cId(cCells);
-    {
-      const auto nodesOfCellC(mesh->getNodesOfCell(cId));
-      const size_t nbNodesOfCellC(nodesOfCellC.size());
-      for (size_t pNodesOfCellC = 0; pNodesOfCellC < nbNodesOfCellC;
-           pNodesOfCellC++) {
-        const Id pId(nodesOfCellC[pNodesOfCellC]);
-        const Id pPlus1Id(
-            nodesOfCellC[(pNodesOfCellC + 1 + nbNodesOfCell) % nbNodesOfCell]);
-        const Id pMinus1Id(
-            nodesOfCellC[(pNodesOfCellC - 1 + nbNodesOfCell) % nbNodesOfCell]);
-        const size_t pNodes(pId);
-        const size_t pPlus1Nodes(pPlus1Id);
-        const size_t pMinus1Nodes(pMinus1Id);
-        m_cqs_nplus1(cCells, pNodesOfCellC) =
-            computeLpcNpc(m_node_coord_nplus1(pNodes), m_node_coord_nplus1(pPlus1Nodes),
-                          m_node_coord_nplus1(pMinus1Nodes));
-      }
-    }
-  });
 }
 /**
  *******************************************************************************
@@ -194,24 +171,88 @@ void Vnr::updateCornerNormal() noexcept {
  *******************************************************************************
  */
 void Vnr::computeNodeVolume() noexcept {
-  Kokkos::parallel_for(nbNodes, KOKKOS_LAMBDA(const size_t& pNodes) {
-    const Id pId(pNodes);
-    double reduction0(0.0);
-    {
-      const auto cellsOfNodeP(mesh->getCellsOfNode(pId));
-      const size_t nbCellsOfNodeP(cellsOfNodeP.size());
-      for (size_t cCellsOfNodeP = 0; cCellsOfNodeP < nbCellsOfNodeP;
-           cCellsOfNodeP++) {
-        const Id cId(cellsOfNodeP[cCellsOfNodeP]);
-        const size_t cCells(cId);
-        const size_t pNodesOfCellC(
-            utils::indexOf(mesh->getNodesOfCell(cId), pId));
-        reduction0 =
-            sumR0(reduction0, m_node_cellvolume_n(cCells, pNodesOfCellC));
-      }
-    }
-    m_node_volume(pNodes) = reduction0;
-  });
+  mesh->parallelForNodes(
+      "computeNodeVolume", KOKKOS_LAMBDA(const size_t& pNodes) {
+        const Id pId(pNodes);
+        double reduction0(0.0);
+        {
+          const auto cellsOfNodeP(mesh->getCellsOfNode(pId));
+          const size_t nbCellsOfNodeP(cellsOfNodeP.size());
+          for (size_t cCellsOfNodeP = 0; cCellsOfNodeP < nbCellsOfNodeP;
+               cCellsOfNodeP++) {
+            const Id cId(cellsOfNodeP[cCellsOfNodeP]);
+            const size_t cCells(cId);
+            const size_t pNodesOfCellC(
+                mesh->getNodeSlotInCell(pId, cCellsOfNodeP));
+            reduction0 =
+                sumR0(reduction0, m_node_cellvolume_n(cCells, pNodesOfCellC));
+          }
+        }
+        m_node_volume(pNodes) = reduction0;
+      });
+}
+/**
+ *******************************************************************************
+ * \file gatherNodePressureForce()
+ * \brief Rassemblement aux noeuds interieurs de la force de pression
+ *        somme des (p + q) * cqs des mailles du noeud, puis f(pNodes, force)
+ *
+ *        une equipe par ligne i de noeuds : p + q des lignes de mailles i-1
+ *        et i, lus chacun par 4 noeuds, sont d'abord copies en memoire
+ *        scratch, puis les threads de l'equipe parcourent les noeuds de la
+ *        ligne
+ * \param  pressure, pseudo_viscosity, m_cqs_n
+ * \return f(pNodes, force)
+ *******************************************************************************
+ */
+template <typename Functor>
+void Vnr::gatherNodePressureForce(
+    const Kokkos::View<double*>& pressure,
+    const Kokkos::View<double*>& pseudo_viscosity,
+    const Functor& f) noexcept {
+  typedef Kokkos::TeamPolicy<>::member_type member_type;
+  typedef Kokkos::View<double*,
+                       Kokkos::DefaultExecutionSpace::scratch_memory_space,
+                       Kokkos::MemoryTraits<Kokkos::Unmanaged>>
+      ScratchView;
+  const int nbX(mesh->getNbXQuads());
+  const int nbY(mesh->getNbYQuads());
+  const size_t scratchBytes(ScratchView::shmem_size(2 * nbX));
+  Kokkos::parallel_for(
+      "gatherNodePressureForce",
+      Kokkos::TeamPolicy<>(nbY - 1, Kokkos::AUTO)
+          .set_scratch_size(0, Kokkos::PerTeam(scratchBytes)),
+      KOKKOS_LAMBDA(const member_type& team) {
+        const int i(team.league_rank() + 1);
+        const Id c0(mesh->cellAt(i - 1, 0));
+        ScratchView pq(team.team_scratch(0), 2 * nbX);
+        Kokkos::parallel_for(Kokkos::TeamThreadRange(team, 2 * nbX),
+                             [&](const int k) {
+                               pq(k) = pressure(c0 + k) +
+                                       pseudo_viscosity(c0 + k);
+                             });
+        team.team_barrier();
+        Kokkos::parallel_for(
+            Kokkos::TeamThreadRange(team, 1, nbX), [&](const int j) {
+              const Id pId(mesh->nodeAt(i, j));
+              const size_t pNodes(pId);
+              RealArray1D<2> reduction0({0.0, 0.0});
+              {
+                const auto cellsOfNodeP(mesh->getCellsOfNode(pId));
+                const size_t nbCellsOfNodeP(cellsOfNodeP.size());
+                for (size_t cCellsOfNodeP = 0; cCellsOfNodeP < nbCellsOfNodeP;
+                     cCellsOfNodeP++) {
+                  const Id cId(cellsOfNodeP[cCellsOfNodeP]);
+                  const size_t pNodesOfCellC(
+                      mesh->getNodeSlotInCell(pId, cCellsOfNodeP));
+                  reduction0 =
+                      sumR1(reduction0,
+                            pq(cId - c0) * m_cqs_n(cId, pNodesOfCellC));
+                }
+              }
+              f(pNodes, reduction0);
+            });
+      });
 }
 /**
  *******************************************************************************
@@ -225,34 +266,14 @@ void Vnr::computeNodeVolume() noexcept {
  */
 void Vnr::updateVelocity() noexcept {
   const double dt(0.5 * (gt->deltat_nplus1 + gt->deltat_n));
-  {
-    const auto innerNodes(mesh->getInnerNodes());
-    const size_t nbInnerNodes(mesh->getNbInnerNodes());
-    Kokkos::parallel_for(
-        nbInnerNodes, KOKKOS_LAMBDA(const size_t& pInnerNodes) {
-          const Id pId(innerNodes[pInnerNodes]);
-          const size_t pNodes(pId);
-          RealArray1D<2> reduction0({0.0, 0.0});
-          {
-            const auto cellsOfNodeP(mesh->getCellsOfNode(pId));
-            const size_t nbCellsOfNodeP(cellsOfNodeP.size());
-            for (size_t cCellsOfNodeP = 0; cCellsOfNodeP < nbCellsOfNodeP;
-                 cCellsOfNodeP++) {
-              const Id cId(cellsOfNodeP[cCellsOfNodeP]);
-              const size_t cCells(cId);
-              const size_t pNodesOfCellC(
-                  utils::indexOf(mesh->getNodesOfCell(cId), pId));
-              reduction0 = sumR1(reduction0, (m_pressure_n(cCells) +
-                                              m_pseudo_viscosity_n(cCells)) *
-                                                 m_cqs_n(cCells, pNodesOfCellC));
-            }
-          }
-          m_node_velocity_nplus1(pNodes) =
-              m_node_velocity_n(pNodes) + dt / m_node_mass(pNodes) * reduction0;
-          m_x_velocity(pNodes) = m_node_velocity_nplus1(pNodes)[0];
-          m_y_velocity(pNodes) = m_node_velocity_nplus1(pNodes)[1];
-        });
-  }
+  gatherNodePressureForce(
+      m_pressure_n, m_pseudo_viscosity_n,
+      KOKKOS_LAMBDA(const size_t& pNodes, const RealArray1D<2>& reduction0) {
+        m_node_velocity_nplus1(pNodes) =
+            m_node_velocity_n(pNodes) + dt / m_node_mass(pNodes) * reduction0;
+        m_x_velocity(pNodes) = m_node_velocity_nplus1(pNodes)[0];
+        m_y_velocity(pNodes) = m_node_velocity_nplus1(pNodes)[1];
+      });
 }
 /**
  *******************************************************************************
@@ -266,32 +287,12 @@ void Vnr::updateVelocity() noexcept {
  */
 void Vnr::updateVelocitybackward() noexcept {
   const double dt(-0.5 * gt->deltat_n);
-  {
-    const auto innerNodes(mesh->getInnerNodes());
-    const size_t nbInnerNodes(mesh->getNbInnerNodes());
-    Kokkos::parallel_for(
-        nbInnerNodes, KOKKOS_LAMBDA(const size_t& pInnerNodes) {
-          const Id pId(innerNodes[pInnerNodes]);
-          const size_t pNodes(pId);
-          RealArray1D<2> reduction0({0.0, 0.0});
-          {
-            const auto cellsOfNodeP(mesh->getCellsOfNode(pId));
-            const size_t nbCellsOfNodeP(cellsOfNodeP.size());
-            for (size_t cCellsOfNodeP = 0; cCellsOfNodeP < nbCellsOfNodeP;
-                 cCellsOfNodeP++) {
-              const Id cId(cellsOfNodeP[cCellsOfNodeP]);
-              const size_t cCells(cId);
-              const size_t pNodesOfCellC(
-                  utils::indexOf(mesh->getNodesOfCell(cId), pId));
-              reduction0 = sumR1(reduction0, (m_pressure_n(cCells) +
-                                              m_pseudo_viscosity_n(cCells)) *
-                                                 m_cqs_n(cCells, pNodesOfCellC));
-            }
-          }
-          m_node_velocity_n(pNodes) =
-              m_node_velocity_n(pNodes) + dt / m_node_mass(pNodes) * reduction0;
-        });
-  }
+  gatherNodePressureForce(
+      m_pressure_n, m_pseudo_viscosity_n,
+      KOKKOS_LAMBDA(const size_t& pNodes, const RealArray1D<2>& reduction0) {
+        m_node_velocity_n(pNodes) =
+            m_node_velocity_n(pNodes) + dt / m_node_mass(pNodes) * reduction0;
+      });
 }/**
  *******************************************************************************
  * \file updateVelocityforward()
@@ -304,32 +305,12 @@ void Vnr::updateVelocitybackward() noexcept {
  */
 void Vnr::updateVelocityforward() noexcept {
   const double dt(0.5 * gt->deltat_nplus1);
-  {
-    const auto innerNodes(mesh->getInnerNodes());
-    const size_t nbInnerNodes(mesh->getNbInnerNodes());
-    Kokkos::parallel_for(
-        nbInnerNodes, KOKKOS_LAMBDA(const size_t& pInnerNodes) {
-          const Id pId(innerNodes[pInnerNodes]);
-          const size_t pNodes(pId);
-          RealArray1D<2> reduction0({0.0, 0.0});
-          {
-            const auto cellsOfNodeP(mesh->getCellsOfNode(pId));
-            const size_t nbCellsOfNodeP(cellsOfNodeP.size());
-            for (size_t cCellsOfNodeP = 0; cCellsOfNodeP < nbCellsOfNodeP;
-                 cCellsOfNodeP++) {
-              const Id cId(cellsOfNodeP[cCellsOfNodeP]);
-              const size_t cCells(cId);
-              const size_t pNodesOfCellC(
-                  utils::indexOf(mesh->getNodesOfCell(cId), pId));
-              reduction0 = sumR1(reduction0, (m_pressure_nplus1(cCells) +
-                                              m_pseudo_viscosity_nplus1(cCells)) *
-                                                 m_cqs_n(cCells, pNodesOfCellC));
-            }
-          }
-          m_node_velocity_nplus1(pNodes) =
-              m_node_velocity_nplus1(pNodes) + dt / m_node_mass(pNodes) * reduction0;	 
-        });
-  }
+  gatherNodePressureForce(
+      m_pressure_nplus1, m_pseudo_viscosity_nplus1,
+      KOKKOS_LAMBDA(const size_t& pNodes, const RealArray1D<2>& reduction0) {
+        m_node_velocity_nplus1(pNodes) = m_node_velocity_nplus1(pNodes) +
+                                         dt / m_node_mass(pNodes) * reduction0;
+      });
 }
 /**
  *******************************************************************************
@@ -379,94 +360,42 @@ void Vnr::updatePosition() noexcept {
 }
 /**
  *******************************************************************************
- * \file updateCellPos()
- * \brief Calcul de la position du centre de la maille
- *
- * \param  m_node_coord_nplus1
- * \return m_cell_coord_nplus1
- *******************************************************************************
- */
-void Vnr::updateCellPos() noexcept {
-  Kokkos::parallel_for(nbCells, KOKKOS_LAMBDA(const size_t& cCells) {
-    const Id cId(cCells);
-    RealArray1D<2> reduction0({0.0, 0.0});
-    {
-      const auto nodesOfCellC(mesh->getNodesOfCell(cId));
-      const size_t nbNodesOfCellC(nodesOfCellC.size());
-      for (size_t pNodesOfCellC = 0; pNodesOfCellC < nbNodesOfCellC;
-           pNodesOfCellC++) {
-        const Id pId(nodesOfCellC[pNodesOfCellC]);
-        const size_t pNodes(pId);
-        reduction0 = sumR1(reduction0, m_node_coord_nplus1(pNodes));
-      }
-    }
-    m_cell_coord_nplus1(cCells) = 0.25 * reduction0;
-  });
-}
-/**
- *******************************************************************************
- * \file computeSubVol()
- * \brief Calcul des sous-volumes aux noeuds de chaque maille
- *
- * \param  m_node_coord_nplus1
- * \return m_node_cellvolume_nplus1
- *******************************************************************************
- */
-void Vnr::computeSubVol() noexcept {
-  Kokkos::parallel_for(nbCells, KOKKOS_LAMBDA(const size_t& cCells) {
-    const Id cId(cCells);
-    {
-      const auto nodesOfCellC(mesh->getNodesOfCell(cId));
-      const size_t nbNodesOfCellC(nodesOfCellC.size());
-      for (size_t pNodesOfCellC = 0; pNodesOfCellC < nbNodesOfCellC;
-           pNodesOfCellC++) {
-        const Id pMinus1Id(
-            nodesOfCellC[(pNodesOfCellC - 1 + nbNodesOfCell) % nbNodesOfCell]);
-        const Id pId(nodesOfCellC[pNodesOfCellC]);
-        const Id pPlus1Id(
-            nodesOfCellC[(pNodesOfCellC + 1 + nbNodesOfCell) % nbNodesOfCell]);
-        const size_t pMinus1Nodes(pMinus1Id);
-        const size_t pNodes(pId);
-        const size_t pPlus1Nodes(pPlus1Id);
-        const RealArray1D<2> x1(m_cell_coord_nplus1(cCells));
-        const RealArray1D<2> x2(0.5 * (m_node_coord_nplus1(pMinus1Nodes) +
-                                       m_node_coord_nplus1(pNodes)));
-        const RealArray1D<2> x3(m_node_coord_nplus1(pNodes));
-        const RealArray1D<2> x4(0.5 * (m_node_coord_nplus1(pPlus1Nodes) +
-                                       m_node_coord_nplus1(pNodes)));
-        m_node_cellvolume_nplus1(cCells, pNodesOfCellC) =
-            0.5 * (crossProduct2d(x1, x2) + crossProduct2d(x2, x3) +
-                   crossProduct2d(x3, x4) + crossProduct2d(x4, x1));
-      }
-    }
-  });
-}
-/**
- *******************************************************************************
- * \file updateRho()
- * \brief Calcul du volume lagrange et de la densité
+ * \file updateCellGeometry()
+ * \brief Calcul de la geometrie des mailles a tn+1 en une seule passe : les
+ *        4 noeuds de chaque maille sont lus une fois pour le centre, les
+ *        sous-volumes, le volume lagrange, la densite et les vecteurs de coin
  *
- * \param  m_node_cellvolume_nplus1, m_cell_mass_env, m_fracvol_env
- * \return varlp->vLagrange, m_density_nplus1, m_density_env_nplus1
+ * \param  m_node_coord_nplus1, m_cell_mass_env, m_fracvol_env
+ * \return m_cell_coord_nplus1, m_node_cellvolume_nplus1, varlp->vLagrange,
+ *         m_density_nplus1, m_density_env_nplus1, m_cqs_nplus1
  *******************************************************************************
  */
-void Vnr::updateRho() noexcept {
+template <int NBMAT>
+void Vnr::updateCellGeometry() noexcept {
+  const bool avecCqs(options->sansLagrange == 0);
   Kokkos::parallel_for(nbCells, KOKKOS_LAMBDA(const size_t& cCells) {
     const Id cId(cCells);
+    const geometrielib::GeometrieMaille geom(m_node_coord_nplus1,
+                                             mesh->getNodesOfCell(cId));
+    // centre de la maille
+    const RealArray1D<2> xc(geom.centre());
+    m_cell_coord_nplus1(cCells) = xc;
+    // sous-volumes aux noeuds et volume lagrange
     double reduction0(0.0);
-    {
-      const auto nodesOfCellC(mesh->getNodesOfCell(cId));
-      const size_t nbNodesOfCellC(nodesOfCellC.size());
-      for (size_t pNodesOfCellC = 0; pNodesOfCellC < nbNodesOfCellC;
-           pNodesOfCellC++) {
-        reduction0 =
-            sumR0(reduction0, m_node_cellvolume_nplus1(cCells, pNodesOfCellC));
-      }
+    for (int pNodesOfCellC = 0;
+         pNodesOfCellC < geometrielib::GeometrieMaille::nbNoeuds;
+         pNodesOfCellC++) {
+      const double sousVolume(geom.sousVolume(pNodesOfCellC, xc));
+      m_node_cellvolume_nplus1(cCells, pNodesOfCellC) = sousVolume;
+      reduction0 = sumR0(reduction0, sousVolume);
+      // vecteurs de coin a tn+1
+      if (avecCqs)
+        m_cqs_nplus1(cCells, pNodesOfCellC) = geom.lpcNpc(pNodesOfCellC);
     }
     varlp->vLagrange(cCells) = reduction0;
     m_lagrange_volume_nplus1(cCells) = reduction0;
     m_density_nplus1(cCells) = 0.;
-    for (int imat = 0; imat < options->nbmat; ++imat) {
+    for (int imat = 0; imat < NBMAT; ++imat) {
       if (m_fracvol_env(cCells)[imat] > options->threshold)
         m_density_env_nplus1(cCells)[imat] =
             m_cell_mass_env(cCells)[imat] /
@@ -485,6 +414,11 @@ void Vnr::updateRho() noexcept {
     }
   });
 }
+void Vnr::updateCellGeometry() noexcept {
+  dispatchNbMat(options->nbmat, [this](auto nbmat) {
+    updateCellGeometry<decltype(nbmat)::value>();
+  });
+}
 /**
  *******************************************************************************
  * \file computeTau()
@@ -495,13 +429,14 @@ void Vnr::updateRho() noexcept {
  * \return m_tau_density_nplus1, m_tau_density_env_nplus1
  *******************************************************************************
  */
+template <int NBMAT>
 void Vnr::computeTau() noexcept {
   Kokkos::parallel_for(nbCells, KOKKOS_LAMBDA(const size_t& cCells) {
     m_tau_density_nplus1(cCells) =
         0.5 * (1.0 / m_density_nplus1(cCells) + 1.0 / m_density_n(cCells));
     m_tau_volume_nplus1(cCells) =
         0.5 * (1.0 / m_lagrange_volume_nplus1(cCells) + 1.0 / m_lagrange_volume_n(cCells));
-    for (int imat = 0; imat < options->nbmat; ++imat) {
+    for (int imat = 0; imat < NBMAT; ++imat) {
       m_tau_density_env_nplus1(cCells)[imat] = 0.;
       if ((m_density_env_nplus1(cCells)[imat] > options->threshold) &&
           (m_density_env_n(cCells)[imat] > options->threshold))
@@ -514,6 +449,11 @@ void Vnr::computeTau() noexcept {
     }
   });
 }
+void Vnr::computeTau() noexcept {
+  dispatchNbMat(options->nbmat, [this](auto nbmat) {
+    computeTau<decltype(nbmat)::value>();
+  });
+}
 /**
  *******************************************************************************
  * \file updateEnergy()
@@ -526,10 +466,11 @@ void Vnr::computeTau() noexcept {
  * \return m_internal_energy_env_nplus1, m_internal_energy_nplus1
  *******************************************************************************
  */
+template <int NBMAT>
 void Vnr::updateEnergy() noexcept {
   Kokkos::parallel_for(nbCells, KOKKOS_LAMBDA(const size_t& cCells) {
     m_internal_energy_nplus1(cCells) = 0.;
-    for (int imat = 0; imat < options->nbmat; ++imat) {
+    for (int imat = 0; imat < NBMAT; ++imat) {
       m_internal_energy_env_nplus1(cCells)[imat] = 0.;
       if ((m_density_env_nplus1(cCells)[imat] > options->threshold) &&
           (m_density_env_n(cCells)[imat] > options->threshold)) {
@@ -571,6 +512,74 @@ void Vnr::updateEnergy() noexcept {
     }
   });
 }
+void Vnr::updateEnergy() noexcept {
+  dispatchNbMat(options->nbmat, [this](auto nbmat) {
+    updateEnergy<decltype(nbmat)::value>();
+  });
+}
+/**
+ *******************************************************************************
+ * \file newtonParPaquet()
+ * \brief Newton sur l'energie interne de W mailles a la fois : une maille du
+ *        paquet est masquee des qu'elle a converge, le paquet s'arrete quand
+ *        toutes ses mailles ont converge ou apres itermax iterations (la
+ *        premiere iteration est toujours faite)
+ *
+ * \param  calcul (mailles du paquet a resoudre), epsilon, itermax,
+ *         eos(l, e, p, c, dpde), residu(l, e, p, dpde), derivee(l, e, p, dpde)
+ * \return e, p, c, dpde, nbIter (nombre d'iterations de chaque maille)
+ *******************************************************************************
+ */
+constexpr int taillePaquetNewton = 8;
+template <int W, class Eos, class Residu, class Derivee>
+KOKKOS_INLINE_FUNCTION void newtonParPaquet(
+    const bool calcul[W], const double epsilon, const int itermax, double e[W],
+    double p[W], double c[W], double dpde[W], int nbIter[W], const Eos& eos,
+    const Residu& residu, const Derivee& derivee) {
+  bool actif[W];
+  int nbActifs(0);
+  for (int l = 0; l < W; ++l) {
+    actif[l] = calcul[l];
+    nbIter[l] = 0;
+    nbActifs += actif[l];
+  }
+  for (int i = 0; i < itermax && nbActifs > 0; ++i) {
+    nbActifs = 0;
+    for (int l = 0; l < W; ++l) {
+      if (!actif[l]) continue;
+      eos(l, e[l], p[l], c[l], dpde[l]);
+      e[l] = e[l] - residu(l, e[l], p[l], dpde[l]) /
+                        derivee(l, e[l], p[l], dpde[l]);
+      nbIter[l] = i + 1;
+      actif[l] = (std::abs(residu(l, e[l], p[l], dpde[l])) >= epsilon);
+      nbActifs += actif[l];
+    }
+  }
+}
+/**
+ *******************************************************************************
+ * \file compteIterations()
+ * \brief ajout des iterations d'un paquet a l'histogramme : les mailles
+ *        consecutives de meme nombre d'iterations sont comptees ensemble
+ *        pour limiter les operations atomiques
+ *******************************************************************************
+ */
+template <int W>
+KOKKOS_INLINE_FUNCTION void compteIterations(
+    const bool calcul[W], const int nbIter[W],
+    const Kokkos::View<int*>& histogramme) {
+  int nbIterCourant(-1), compte(0);
+  for (int l = 0; l < W; ++l) {
+    if (!calcul[l]) continue;
+    if (nbIter[l] != nbIterCourant) {
+      if (compte > 0) Kokkos::atomic_add(&histogramme(nbIterCourant), compte);
+      nbIterCourant = nbIter[l];
+      compte = 0;
+    }
+    ++compte;
+  }
+  if (compte > 0) Kokkos::atomic_add(&histogramme(nbIterCourant), compte);
+}
 /**
  *******************************************************************************
  * \file updateEnergyite()
@@ -600,72 +609,96 @@ inline double fvnrderiv(double e, double p, double dpde, double rn1, double rn)
 /*
  *******************************************************************************
 */
+template <int NBMAT>
 void Vnr::updateEnergyite() noexcept {
-  Kokkos::parallel_for(nbCells, KOKKOS_LAMBDA(const size_t& cCells) {
-    RealArray1D<3> sortie_eos;  // pression puis sound_speed
-    m_internal_energy_nplus1(cCells) = 0.;
-    for (int imat = 0; imat < options->nbmat; ++imat) {
-      m_internal_energy_env_nplus1(cCells)[imat] = 0.;
-      if ((m_density_env_nplus1(cCells)[imat] > options->threshold) &&
-          (m_density_env_n(cCells)[imat] > options->threshold)) {
-        // calcul du DV a changer utiliser divU
-        double pseudo(0.);
-        if ((options->pseudo_centree == 1)
-	    &&
-            ((m_pseudo_viscosity_env_nplus1(cCells)[imat] +
-              m_pseudo_viscosity_env_n(cCells)[imat]) *
-                 (1.0 / m_density_env_nplus1(cCells)[imat] -
-                  1.0 / m_density_env_n(cCells)[imat]) <
-             0.)
-	    ) {
-          pseudo = 0.5 * (m_pseudo_viscosity_env_nplus1(cCells)[imat] +
-                          m_pseudo_viscosity_env_n(cCells)[imat]);
-        }
-        if (options->pseudo_centree == 0
-	    &&
-            ((m_pseudo_viscosity_env_nplus1(cCells)[imat]) *
-                 (1.0 / m_density_env_nplus1(cCells)[imat] -
-                  1.0 / m_density_env_n(cCells)[imat]) <
-             0.)
-	    ) {
-	 
-	  // test sur la positivité du travail dans le calcul de
-	  // m_pseudo_viscosity_nplus1(cCells)
-          pseudo = m_pseudo_viscosity_env_nplus1(cCells)[imat];
+  constexpr int W(taillePaquetNewton);
+  const int nbPaquets((nbCells + W - 1) / W);
+  Kokkos::deep_copy(m_newton_histogram, 0);
+  Kokkos::parallel_for(
+      "updateEnergyite", nbPaquets, KOKKOS_LAMBDA(const int& paquet) {
+        const int debut(paquet * W);
+        const int nb(nbCells - debut < W ? nbCells - debut : W);
+        for (int l = 0; l < nb; ++l) m_internal_energy_nplus1(debut + l) = 0.;
+        for (int imat = 0; imat < NBMAT; ++imat) {
+          bool calcul[W];
+          double rn[W], pn[W], qnn1[W], rn1[W], en[W];
+          double e[W], p[W], c[W], dpde[W];
+          int nbIter[W];
+          for (int l = 0; l < W; ++l) {
+            calcul[l] = false;
+            if (l >= nb) continue;
+            const int cCells(debut + l);
+            m_internal_energy_env_nplus1(cCells)[imat] = 0.;
+            if (!((m_density_env_nplus1(cCells)[imat] > options->threshold) &&
+                  (m_density_env_n(cCells)[imat] > options->threshold)))
+              continue;
+            // calcul du DV a changer utiliser divU
+            double pseudo(0.);
+            if ((options->pseudo_centree == 1) &&
+                ((m_pseudo_viscosity_env_nplus1(cCells)[imat] +
+                  m_pseudo_viscosity_env_n(cCells)[imat]) *
+                     (1.0 / m_density_env_nplus1(cCells)[imat] -
+                      1.0 / m_density_env_n(cCells)[imat]) <
+                 0.)) {
+              pseudo = 0.5 * (m_pseudo_viscosity_env_nplus1(cCells)[imat] +
+                              m_pseudo_viscosity_env_n(cCells)[imat]);
+            }
+            if (options->pseudo_centree == 0 &&
+                ((m_pseudo_viscosity_env_nplus1(cCells)[imat]) *
+                     (1.0 / m_density_env_nplus1(cCells)[imat] -
+                      1.0 / m_density_env_n(cCells)[imat]) <
+                 0.)) {
+              // test sur la positivité du travail dans le calcul de
+              // m_pseudo_viscosity_nplus1(cCells)
+              pseudo = m_pseudo_viscosity_env_nplus1(cCells)[imat];
+            }
+            calcul[l] = true;
+            rn[l] = m_density_env_n(cCells)[imat];
+            pn[l] = m_pressure_env_n(cCells)[imat];
+            qnn1[l] = pseudo;
+            rn1[l] = m_density_env_nplus1(cCells)[imat];
+            en[l] = m_internal_energy_env_n(cCells)[imat];
+            e[l] = en[l];
+          }
+          // les iterations de newton
+          newtonParPaquet<W>(
+              calcul, options->threshold, newtonItermax, e, p, c, dpde,
+              nbIter,
+              [&](const int l, const double el, double& pl, double& cl,
+                  double& dpdel) {
+                RealArray1D<3> sortie_eos =
+                    eos->computeEOSMateriau(imat, rn1[l], el);
+                pl = sortie_eos[0];
+                cl = sortie_eos[1];
+                dpdel = sortie_eos[2];
+              },
+              [&](const int l, const double el, const double pl,
+                  const double dpdel) {
+                return fvnr(el, pl, dpdel, en[l], qnn1[l], pn[l], rn1[l],
+                            rn[l]);
+              },
+              [&](const int l, const double el, const double pl,
+                  const double dpdel) {
+                return fvnrderiv(el, pl, dpdel, rn1[l], rn[l]);
+              });
+          for (int l = 0; l < nb; ++l) {
+            if (!calcul[l]) continue;
+            const int cCells(debut + l);
+            m_internal_energy_env_nplus1(cCells)[imat] = e[l];
+            m_speed_velocity_env_nplus1(cCells)[imat] = c[l];
+            m_pressure_env_nplus1(cCells)[imat] = p[l];
+            m_internal_energy_nplus1(cCells) +=
+                m_mass_fraction_env(cCells)[imat] *
+                m_internal_energy_env_nplus1(cCells)[imat];
+          }
+          compteIterations<W>(calcul, nbIter, m_newton_histogram);
         }
-	double rn  = m_density_env_n(cCells)[imat];
-	double pn  = m_pressure_env_n(cCells)[imat];
-	double qnn1 = pseudo;
-	double m   = m_cell_mass_env(cCells)[imat];
-	double rn1 = m_density_env_nplus1(cCells)[imat];
-	double en  = m_internal_energy_env_n(cCells)[imat];
-	double g = eos->gamma[imat];
-        double t = eos->tension_limit[imat];
-
-	// les iterations de newton
-	double epsilon = options->threshold;
-	double itermax = 50;
-	double enew=0, e=en, p, c, dpde;
-	int i = 0;
-	while(i<itermax && abs(fvnr(e, p, dpde, en, qnn1, pn, rn1, rn))>=epsilon)
-	  {
-	    sortie_eos = eos->computeEOS(eos->Nom[imat], g, t, rn1, e);
-	    p = sortie_eos[0];
-	    c = sortie_eos[1];
-	    dpde = sortie_eos[2];
-	    enew = e - fvnr(e, p, dpde, en, qnn1, pn, rn1, rn) / fvnrderiv(e, p, dpde, rn1, rn);
-	    e = enew;
-	    i++;
-	  }
-	m_internal_energy_env_nplus1(cCells)[imat] = e;
-	m_speed_velocity_env_nplus1(cCells)[imat] = c;
-	m_pressure_env_nplus1(cCells)[imat] = p;
-        m_internal_energy_nplus1(cCells) +=
-            m_mass_fraction_env(cCells)[imat] *
-            m_internal_energy_env_nplus1(cCells)[imat];
-      }
-    }
-    });
+      });
+}
+void Vnr::updateEnergyite() noexcept {
+  dispatchNbMat(options->nbmat, [this](auto nbmat) {
+    updateEnergyite<decltype(nbmat)::value>();
+  });
 }
 /**
  *******************************************************************************
@@ -683,10 +716,11 @@ void Vnr::updateEnergyite() noexcept {
  * \return m_internal_energy_env_nplus1, m_internal_energy_nplus1
  *******************************************************************************
  */
+template <int NBMAT>
 void Vnr::updateEnergycsts() noexcept {
   Kokkos::parallel_for(nbCells, KOKKOS_LAMBDA(const size_t& cCells) {
     m_internal_energy_nplus1(cCells) = 0.;
-    for (int imat = 0; imat < options->nbmat; ++imat) {
+    for (int imat = 0; imat < NBMAT; ++imat) {
       m_internal_energy_env_nplus1(cCells)[imat] = 0.;
       if (m_density_env_nplus1(cCells)[imat] > options->threshold) {
 	const Id cId(cCells);
@@ -724,6 +758,11 @@ void Vnr::updateEnergycsts() noexcept {
     }
   });
 }
+void Vnr::updateEnergycsts() noexcept {
+  dispatchNbMat(options->nbmat, [this](auto nbmat) {
+    updateEnergycsts<decltype(nbmat)::value>();
+  });
+}
 /**
  *******************************************************************************
  * \file updateEnergycqsite()
@@ -755,64 +794,115 @@ inline double fderiv(double e, double p, double dpde, double cn1, double m)
 /*
  *******************************************************************************
 */
+template <int NBMAT>
 void Vnr::updateEnergycstsite() noexcept {
-  Kokkos::parallel_for(nbCells, KOKKOS_LAMBDA(const size_t& cCells) {
-    RealArray1D<3> sortie_eos;  // pression puis sound_speed
-    m_internal_energy_nplus1(cCells) = 0.;
-    for (int imat = 0; imat < options->nbmat; ++imat) {
-      m_internal_energy_env_nplus1(cCells)[imat] = 0.;
-      if (m_density_env_nplus1(cCells)[imat] > options->threshold) {
-	const Id cId(cCells);
-	const auto nodesOfCellC(mesh->getNodesOfCell(cId));
-	const size_t nbNodesOfCellC(nodesOfCellC.size());
-	double cqs_v_nplus1(0.);
-	double cqs_v_n(0.);
-	for (size_t pNodesOfCellC = 0; pNodesOfCellC < nbNodesOfCellC;
-	     pNodesOfCellC++) {
-	  const Id pId(nodesOfCellC[pNodesOfCellC]);
-	  const size_t pNodes(pId);
-	  cqs_v_nplus1 += dot(m_cqs_nplus1(cCells, pNodesOfCellC),
-			      m_node_velocity_nplus1(pNodes))
-	             * gt->deltat_nplus1;
-	  cqs_v_n += dot(m_cqs_n(cCells, pNodesOfCellC),
-	  		 m_node_velocity_nplus1(pNodes))
-	    * gt->deltat_nplus1 ;	  
-	}
-	double pn = m_pressure_env_n(cCells)[imat];
-	double qn = m_pseudo_viscosity_env_n(cCells)[imat];
-	double qn1= m_pseudo_viscosity_env_nplus1(cCells)[imat];
-	double m  = m_cell_mass_env(cCells)[imat];
-	double r  = m_density_env_nplus1(cCells)[imat];
-	double en = m_internal_energy_env_n(cCells)[imat];
-	double g = eos->gamma[imat];
-        double t = eos->tension_limit[imat];
-	double cn1 = cqs_v_nplus1;
-	double cn = cqs_v_n;
-
-	// les iterations de newton
-	double epsilon = options->threshold;
-	double itermax = 50;
-	double enew=0, e=en, p, c, dpde;
-	int i = 0;
-	while(i<itermax && abs(f(e, p, dpde, en, qn, pn, cn1, cn, m, qn1))>=epsilon)
-	  {
-	    sortie_eos = eos->computeEOS(eos->Nom[imat], g, t, r, e);
-	    p = sortie_eos[0];
-	    c = sortie_eos[1];
-	    dpde = sortie_eos[2];
-	    enew = e - f(e, p, dpde, en, qn, pn, cn1, cn, m, qn1) / fderiv(e, p, dpde, cn1, m);
-	    e = enew;
-	    i++;
-	  }
-	m_internal_energy_env_nplus1(cCells)[imat] = e;
-	m_speed_velocity_env_nplus1(cCells)[imat] = c;
-	m_pressure_env_nplus1(cCells)[imat] = p;
-        m_internal_energy_nplus1(cCells) +=
-            m_mass_fraction_env(cCells)[imat] *
-            m_internal_energy_env_nplus1(cCells)[imat];
-      }
-    }
-    });
+  constexpr int W(taillePaquetNewton);
+  const int nbPaquets((nbCells + W - 1) / W);
+  Kokkos::deep_copy(m_newton_histogram, 0);
+  Kokkos::parallel_for(
+      "updateEnergycstsite", nbPaquets, KOKKOS_LAMBDA(const int& paquet) {
+        const int debut(paquet * W);
+        const int nb(nbCells - debut < W ? nbCells - debut : W);
+        for (int l = 0; l < nb; ++l) m_internal_energy_nplus1(debut + l) = 0.;
+        for (int imat = 0; imat < NBMAT; ++imat) {
+          bool calcul[W];
+          double pn[W], qn[W], qn1[W], m[W], r[W], en[W], cn1[W], cn[W];
+          double e[W], p[W], c[W], dpde[W];
+          int nbIter[W];
+          for (int l = 0; l < W; ++l) {
+            calcul[l] = false;
+            if (l >= nb) continue;
+            const int cCells(debut + l);
+            m_internal_energy_env_nplus1(cCells)[imat] = 0.;
+            if (!(m_density_env_nplus1(cCells)[imat] > options->threshold))
+              continue;
+            const Id cId(cCells);
+            const auto nodesOfCellC(mesh->getNodesOfCell(cId));
+            const size_t nbNodesOfCellC(nodesOfCellC.size());
+            double cqs_v_nplus1(0.);
+            double cqs_v_n(0.);
+            for (size_t pNodesOfCellC = 0; pNodesOfCellC < nbNodesOfCellC;
+                 pNodesOfCellC++) {
+              const Id pId(nodesOfCellC[pNodesOfCellC]);
+              const size_t pNodes(pId);
+              cqs_v_nplus1 += dot(m_cqs_nplus1(cCells, pNodesOfCellC),
+                                  m_node_velocity_nplus1(pNodes)) *
+                              gt->deltat_nplus1;
+              cqs_v_n += dot(m_cqs_n(cCells, pNodesOfCellC),
+                             m_node_velocity_nplus1(pNodes)) *
+                         gt->deltat_nplus1;
+            }
+            calcul[l] = true;
+            pn[l] = m_pressure_env_n(cCells)[imat];
+            qn[l] = m_pseudo_viscosity_env_n(cCells)[imat];
+            qn1[l] = m_pseudo_viscosity_env_nplus1(cCells)[imat];
+            m[l] = m_cell_mass_env(cCells)[imat];
+            r[l] = m_density_env_nplus1(cCells)[imat];
+            en[l] = m_internal_energy_env_n(cCells)[imat];
+            cn1[l] = cqs_v_nplus1;
+            cn[l] = cqs_v_n;
+            e[l] = en[l];
+          }
+          // les iterations de newton
+          newtonParPaquet<W>(
+              calcul, options->threshold, newtonItermax, e, p, c, dpde,
+              nbIter,
+              [&](const int l, const double el, double& pl, double& cl,
+                  double& dpdel) {
+                RealArray1D<3> sortie_eos =
+                    eos->computeEOSMateriau(imat, r[l], el);
+                pl = sortie_eos[0];
+                cl = sortie_eos[1];
+                dpdel = sortie_eos[2];
+              },
+              [&](const int l, const double el, const double pl,
+                  const double dpdel) {
+                return f(el, pl, dpdel, en[l], qn[l], pn[l], cn1[l], cn[l],
+                         m[l], qn1[l]);
+              },
+              [&](const int l, const double el, const double pl,
+                  const double dpdel) {
+                return fderiv(el, pl, dpdel, cn1[l], m[l]);
+              });
+          for (int l = 0; l < nb; ++l) {
+            if (!calcul[l]) continue;
+            const int cCells(debut + l);
+            m_internal_energy_env_nplus1(cCells)[imat] = e[l];
+            m_speed_velocity_env_nplus1(cCells)[imat] = c[l];
+            m_pressure_env_nplus1(cCells)[imat] = p[l];
+            m_internal_energy_nplus1(cCells) +=
+                m_mass_fraction_env(cCells)[imat] *
+                m_internal_energy_env_nplus1(cCells)[imat];
+          }
+          compteIterations<W>(calcul, nbIter, m_newton_histogram);
+        }
+      });
+}
+void Vnr::updateEnergycstsite() noexcept {
+  dispatchNbMat(options->nbmat, [this](auto nbmat) {
+    updateEnergycstsite<decltype(nbmat)::value>();
+  });
+}
+/**
+ *******************************************************************************
+ * \file printNewtonHistogram()
+ * \brief affichage de l'histogramme des iterations du Newton sur l'energie
+ *        interne au pas de temps : nombre d'iterations (nombre de couples
+ *        maille-materiau), la derniere classe regroupe les couples arretes
+ *        au nombre maximal d'iterations
+ *
+ * \param  m_newton_histogram
+ *******************************************************************************
+ */
+void Vnr::printNewtonHistogram() noexcept {
+  bool vide(true);
+  for (int i = 1; i <= newtonItermax; ++i) {
+    if (m_newton_histogram(i) == 0) continue;
+    if (vide) std::cout << " Newton :";
+    std::cout << " " << i << "(" << m_newton_histogram(i) << ")";
+    vide = false;
+  }
+  if (!vide) std::cout << std::endl;
 }
 /**
  *******************************************************************************
@@ -826,6 +916,7 @@ void Vnr::updateEnergycstsite() noexcept {
  * \return m_internal_energy_env_nplus1, m_internal_energy_nplus1
  *******************************************************************************
  */
+template <int NBMAT>
 void Vnr::updateEnergyForTotalEnergyConservation() noexcept {
   Kokkos::parallel_for(nbCells, KOKKOS_LAMBDA(const size_t& cCells) {
       m_internal_energy_nplus1(cCells) = 0.;
@@ -833,7 +924,7 @@ void Vnr::updateEnergyForTotalEnergyConservation() noexcept {
       const Id cId(cCells);
       const auto nodesOfCellC(mesh->getNodesOfCell(cId));
       const size_t nbNodesOfCellC(nodesOfCellC.size());
-      for (int imat = 0; imat < options->nbmat; ++imat) {
+      for (int imat = 0; imat < NBMAT; ++imat) {
 	if (m_density_env_nplus1(cCells)[imat] > options->threshold) {
 	  for (size_t pNodesOfCellC = 0; pNodesOfCellC < nbNodesOfCellC;
 	       pNodesOfCellC++) {
@@ -860,6 +951,11 @@ void Vnr::updateEnergyForTotalEnergyConservation() noexcept {
       }
   });
 }
+void Vnr::updateEnergyForTotalEnergyConservation() noexcept {
+  dispatchNbMat(options->nbmat, [this](auto nbmat) {
+    updateEnergyForTotalEnergyConservation<decltype(nbmat)::value>();
+  });
+}
       
 /**
  *******************************************************************************
@@ -902,22 +998,36 @@ void Vnr::computeDivU() noexcept {
  *******************************************************************************
  */
 void Vnr::computeEOS() {
-  Kokkos::parallel_for(nbCells, KOKKOS_LAMBDA(const size_t& cCells) {
-    for (int imat = 0; imat < options->nbmat; ++imat) {
-      double pression;  // = m_pressure_env_nplus1(cCells)[imat];
-      double density = m_density_env_nplus1(cCells)[imat];
-      double energy = m_internal_energy_env_nplus1(cCells)[imat];
-      double gamma = eos->gamma[imat];
-      double tension_limit = eos->tension_limit[imat];
-      double sound_speed;  // = m_speed_velocity_env_nplus1(cCells)[imat];
-      RealArray1D<3> sortie_eos;  // pression puis sound_speed
-      //
-      sortie_eos = eos->computeEOS(eos->Nom[imat], gamma, tension_limit, density, energy);
-      m_pressure_env_nplus1(cCells)[imat] = sortie_eos[0];
-      m_speed_velocity_env_nplus1(cCells)[imat] = sortie_eos[1];
-      m_dpde_env(cCells)[imat] = sortie_eos[2];
-    }
-  });
+  // mailles pures : seule la loi du materiau present est evaluee, sur les
+  // valeurs du tableau dense (un materiau absent n'a ni pression ni vitesse
+  // du son)
+  auto slot(varlp->layout.slot);
+  auto density(m_density_env_nplus1.bulk());
+  auto energy(m_internal_energy_env_nplus1.bulk());
+  auto pression(m_pressure_env_nplus1.bulk());
+  auto soundSpeed(m_speed_velocity_env_nplus1.bulk());
+  auto dpde(m_dpde_env.bulk());
+  Kokkos::parallel_for(
+      "computeEOSPure", nbCells, KOKKOS_LAMBDA(const size_t& cCells) {
+        const int s(slot(cCells));
+        if (s >= 0) return;
+        // pression puis sound_speed puis dpde
+        RealArray1D<3> sortie_eos = eos->computeEOSMateriau(
+            -1 - s, density(cCells), energy(cCells));
+        pression(cCells) = sortie_eos[0];
+        soundSpeed(cCells) = sortie_eos[1];
+        dpde(cCells) = sortie_eos[2];
+      });
+  // mailles mixtes : un noyau par materiau sur les valeurs contigues de la
+  // liste compacte, la loi est choisie une fois par materiau (evaluation par
+  // lot sans branchement)
+  for (int imat = 0; imat < options->nbmat; ++imat)
+    eos->computeEOSBatch(imat, varlp->layout.nbMixedCells, MixedRank(),
+                         m_density_env_nplus1.mixedMaterial(imat),
+                         m_internal_energy_env_nplus1.mixedMaterial(imat),
+                         m_pressure_env_nplus1.mixedMaterial(imat),
+                         m_speed_velocity_env_nplus1.mixedMaterial(imat),
+                         m_dpde_env.mixedMaterial(imat));
 }
 /**
  *******************************************************************************
@@ -928,31 +1038,85 @@ void Vnr::computeEOS() {
  * \return m_pressure_nplus1, m_speed_velocity_nplus1
  *******************************************************************************
  */
+template <int NBMAT>
+void Vnr::computePressionMoyenne() noexcept {
+  // mailles pures : un seul materiau contribue
+  auto slot(varlp->layout.slot);
+  auto fracvol(m_fracvol_env.bulk());
+  auto pression(m_pressure_env_nplus1.bulk());
+  auto soundSpeed(m_speed_velocity_env_nplus1.bulk());
+  Kokkos::parallel_for(
+      "computePressionMoyennePure", nbCells,
+      KOKKOS_LAMBDA(const size_t& cCells) {
+        if (slot(cCells) >= 0) return;
+        m_pressure_nplus1(cCells) = fracvol(cCells) * pression(cCells);
+        m_speed_velocity_nplus1(cCells) = MathFunctions::max(
+            m_speed_velocity_nplus1(cCells), soundSpeed(cCells));
+      });
+  // mailles mixtes : somme sur les materiaux de la liste compacte
+  auto mixedCells(varlp->layout.mixedCells);
+  auto fracvolMixte(m_fracvol_env.mixed());
+  auto pressionMixte(m_pressure_env_nplus1.mixed());
+  auto soundSpeedMixte(m_speed_velocity_env_nplus1.mixed());
+  Kokkos::parallel_for(
+      "computePressionMoyenneMixte", varlp->layout.nbMixedCells,
+      KOKKOS_LAMBDA(const int& mCells) {
+        const int cCells(mixedCells(mCells));
+        m_pressure_nplus1(cCells) = 0.;
+        for (int imat = 0; imat < NBMAT; ++imat) {
+          m_pressure_nplus1(cCells) +=
+              fracvolMixte(mCells, imat) * pressionMixte(mCells, imat);
+          m_speed_velocity_nplus1(cCells) =
+              MathFunctions::max(m_speed_velocity_nplus1(cCells),
+                                 soundSpeedMixte(mCells, imat));
+        }
+      });
+  Kokkos::parallel_for(
+      "computePressionMoyenne", nbCells, KOKKOS_LAMBDA(const size_t& cCells) {
+        // NONREG GP A SUPPRIMER
+        if (m_internal_energy_nplus1(cCells) > options->threshold) {
+          m_speed_velocity_nplus1(cCells) =
+              std::sqrt(eos->gamma[0] * (eos->gamma[0] - 1.0) *
+                        m_internal_energy_nplus1(cCells));
+        }
+        for (int imat = 0; imat < NBMAT; ++imat)
+          if (eos->Nom[imat] == eos->Void)
+            m_internal_energy_nplus1(cCells) +=
+                m_mass_fraction_env(cCells)[imat] *
+                m_internal_energy_env_nplus1(cCells)[imat];
+      });
+  checkSpeedVelocityNaN();
+}
 void Vnr::computePressionMoyenne() noexcept {
+  dispatchNbMat(options->nbmat, [this](auto nbmat) {
+    computePressionMoyenne<decltype(nbmat)::value>();
+  });
+}
+/**
+ *******************************************************************************
+ * \file checkSpeedVelocityNaN()
+ * \brief Detection des vitesses du son non definies (NaN) : les mailles
+ *        fautives sont comptees par reduction puis listees apres le noyau
+ *
+ * \param  m_speed_velocity_nplus1, m_internal_energy_nplus1
+ *******************************************************************************
+ */
+void Vnr::checkSpeedVelocityNaN() noexcept {
+  int nbNaNCells(0);
+  Kokkos::Sum<int> reducer(nbNaNCells);
+  Kokkos::parallel_reduce(
+      "checkSpeedVelocityNaN", nbCells,
+      KOKKOS_LAMBDA(const int& cCells, int& x) {
+        const double c(m_speed_velocity_nplus1(cCells));
+        reducer.join(x, (c != c ? 1 : 0));
+      },
+      reducer);
+  if (nbNaNCells == 0) return;
   for (int cCells = 0; cCells < nbCells; cCells++) {
-    m_pressure_nplus1(cCells) = 0.;
-    for (int imat = 0; imat < options->nbmat; ++imat) {
-      m_pressure_nplus1(cCells) +=
-          m_fracvol_env(cCells)[imat] * m_pressure_env_nplus1(cCells)[imat];
-      m_speed_velocity_nplus1(cCells) =
-          MathFunctions::max(m_speed_velocity_nplus1(cCells),
-                             m_speed_velocity_env_nplus1(cCells)[imat]);
-    }
-    // NONREG GP A SUPPRIMER
-    if (m_internal_energy_nplus1(cCells) > options->threshold) {
-      m_speed_velocity_nplus1(cCells) =
-          std::sqrt(eos->gamma[0] * (eos->gamma[0] - 1.0) *
-                    m_internal_energy_nplus1(cCells));
-    }
-    if (m_speed_velocity_nplus1(cCells) != m_speed_velocity_nplus1(cCells)) {
-      std::cout << "\n Pb CC" << cCells  << "  " << m_speed_velocity_nplus1(cCells) << "  " << m_internal_energy_nplus1(cCells)
-		<< std::endl;
-    }
-    for (int imat = 0; imat < options->nbmat; ++imat)
-      if (eos->Nom[imat] == eos->Void)
-        m_internal_energy_nplus1(cCells) +=
-            m_mass_fraction_env(cCells)[imat] *
-            m_internal_energy_env_nplus1(cCells)[imat];
+    if (m_speed_velocity_nplus1(cCells) != m_speed_velocity_nplus1(cCells))
+      std::cout << "\n Pb CC" << cCells << "  "
+                << m_speed_velocity_nplus1(cCells) << "  "
+                << m_internal_energy_nplus1(cCells) << std::endl;
   }
 }
 /**
@@ -961,55 +1125,50 @@ void Vnr::computePressionMoyenne() noexcept {
  * \brief Calcul de l'energie totale et la masse initiale du systeme apres lagrange
  *
  * \param  m_cell_velocity_nplus, m_density_nplus, m_euler_volume
- * \return m_total_energy_L, m_global_masse_L,
- *         m_global_total_energy_L, m_total_masse_L
+ * \return m_global_total_energy_L, m_global_total_masse_L,
+ *         m_global_total_masse_env_L
  *
  *******************************************************************************
  */
 void Vnr::computeVariablesGlobalesL() noexcept {
-  m_global_total_energy_L = 0.;
   int nbmat = options->nbmat;
-  Kokkos::parallel_for(
-      "remapVariables", nbCells, KOKKOS_LAMBDA(const int& cCells) {
-	const Id cId(cCells);
-	const auto nodesOfCellC(mesh->getNodesOfCell(cId));
-	const size_t nbNodesOfCellC(nodesOfCellC.size());
-	double ec_reconst(0.);
-	for (size_t pNodesOfCellC = 0; pNodesOfCellC < nbNodesOfCellC;
-	     pNodesOfCellC++) {
-	  const Id pId(nodesOfCellC[pNodesOfCellC]);
-	  const size_t pNodes(pId);
-	  ec_reconst += 0.25 * 0.5 *
-	    (m_node_velocity_nplus1(pNodes)[0] * m_node_velocity_nplus1(pNodes)[0] +
-	     m_node_velocity_nplus1(pNodes)[1] * m_node_velocity_nplus1(pNodes)[1]);
-	}
-        m_total_energy_L(cCells) = m_density_nplus1(cCells) * m_lagrange_volume_nplus1(cCells) *
-	  (m_internal_energy_nplus1(cCells) + ec_reconst);
-        m_total_masse_L(cCells) = 0.;
-        for (int imat = 0; imat < nbmat; imat++)
-          m_total_masse_L(cCells) += m_density_env_nplus1(cCells)[imat]
-                                     * m_lagrange_volume_nplus1(cCells) *
-                                     m_fracvol_env(cCells)[imat];
-        // m_mass_fraction_env(cCells)[imat] * (density_nplus1 * vol) ; //
-        // m_density_env_nplus1(cCells)[imat] * vol_nplus1[imat];
-      });
-  double reductionE(0.), reductionM(0.);
-  {
-    Kokkos::Sum<double> reducerE(reductionE);
-    Kokkos::parallel_reduce("reductionE", nbCells,
-                            KOKKOS_LAMBDA(const int& cCells, double& x) {
-                              reducerE.join(x, m_total_energy_L(cCells));
-                            },
-                            reducerE);
-    Kokkos::Sum<double> reducerM(reductionM);
-    Kokkos::parallel_reduce("reductionM", nbCells,
-                            KOKKOS_LAMBDA(const int& cCells, double& x) {
-                              reducerM.join(x, m_total_masse_L(cCells));
-                            },
-                            reducerM);
-  }
-  m_global_total_energy_L = reductionE;
-  m_global_total_masse_L = reductionM;
+  conservationlib::Bilan bilan;
+  conservationlib::ReducteurBilan reducer(bilan);
+  Kokkos::parallel_reduce(
+      "computeVariablesGlobalesL", nbCells,
+      KOKKOS_LAMBDA(const int& cCells, conservationlib::Bilan& x) {
+        const Id cId(cCells);
+        const auto nodesOfCellC(mesh->getNodesOfCell(cId));
+        const size_t nbNodesOfCellC(nodesOfCellC.size());
+        double ec_reconst(0.);
+        for (size_t pNodesOfCellC = 0; pNodesOfCellC < nbNodesOfCellC;
+             pNodesOfCellC++) {
+          const Id pId(nodesOfCellC[pNodesOfCellC]);
+          const size_t pNodes(pId);
+          ec_reconst += 0.25 * 0.5 *
+                        (m_node_velocity_nplus1(pNodes)[0] *
+                             m_node_velocity_nplus1(pNodes)[0] +
+                         m_node_velocity_nplus1(pNodes)[1] *
+                             m_node_velocity_nplus1(pNodes)[1]);
+        }
+        x.energie += m_density_nplus1(cCells) *
+                     m_lagrange_volume_nplus1(cCells) *
+                     (m_internal_energy_nplus1(cCells) + ec_reconst);
+        double masse(0.);
+        for (int imat = 0; imat < nbmat; imat++) {
+          const double masseEnv(m_density_env_nplus1(cCells)[imat] *
+                                m_lagrange_volume_nplus1(cCells) *
+                                m_fracvol_env(cCells)[imat]);
+          masse += masseEnv;
+          x.masseEnv[imat] += masseEnv;
+        }
+        x.masse += masse;
+      },
+      reducer);
+  m_global_total_energy_L = bilan.energie;
+  m_global_total_masse_L = bilan.masse;
+  for (int imat = 0; imat < nbmatmax; imat++)
+    m_global_total_masse_env_L[imat] = bilan.masseEnv[imat];
 }
 /**
  *******************************************************************************
@@ -1017,53 +1176,47 @@ void Vnr::computeVariablesGlobalesL() noexcept {
  * \brief Calcul de l'energie totale et la masse initiale du systeme avant lagrange
  *
  * \param  m_cell_velocity_nplus, m_density_nplus, m_euler_volume
- * \return m_total_energy_L, m_global_masse_L,
- *         m_global_total_energy_L, m_total_masse_L
+ * \return m_global_total_energy_L0, m_global_total_masse_L0,
+ *         m_global_total_masse_env_L0
  *
  *******************************************************************************
  */
 void Vnr::computeVariablesGlobalesL0() noexcept {
-  m_global_total_energy_L0 = 0.;
   int nbmat = options->nbmat;
-  Kokkos::parallel_for(
-      "remapVariables", nbCells, KOKKOS_LAMBDA(const int& cCells) {
-	const Id cId(cCells);
-	const auto nodesOfCellC(mesh->getNodesOfCell(cId));
-	const size_t nbNodesOfCellC(nodesOfCellC.size());
-	double ec_reconst(0.);
-	for (size_t pNodesOfCellC = 0; pNodesOfCellC < nbNodesOfCellC;
-	     pNodesOfCellC++) {
-	  const Id pId(nodesOfCellC[pNodesOfCellC]);
-	  const size_t pNodes(pId);
-	  ec_reconst += 0.25 * 0.5 *
-	    (m_node_velocity_n(pNodes)[0] * m_node_velocity_n(pNodes)[0] +
-	     m_node_velocity_n(pNodes)[1] * m_node_velocity_n(pNodes)[1]);
-	}
-        m_total_energy_L0(cCells) = m_density_n(cCells) * m_lagrange_volume_n(cCells) *
-	  (m_internal_energy_n(cCells) + ec_reconst);
-        m_total_masse_L0(cCells) = 0.;
-        for (int imat = 0; imat < nbmat; imat++)
-          m_total_masse_L0(cCells) += m_density_env_n(cCells)[imat] *
-                                     m_lagrange_volume_n(cCells) *
-                                     m_fracvol_env(cCells)[imat];
-        // m_mass_fraction_env(cCells)[imat] * (density_nplus1 * vol) ; //
-        // m_density_env_nplus1(cCells)[imat] * vol_nplus1[imat];
-      });
-  double reductionE(0.), reductionM(0.);
-  {
-    Kokkos::Sum<double> reducerE(reductionE);
-    Kokkos::parallel_reduce("reductionE", nbCells,
-                            KOKKOS_LAMBDA(const int& cCells, double& x) {
-                              reducerE.join(x, m_total_energy_L0(cCells));
-                            },
-                            reducerE);
-    Kokkos::Sum<double> reducerM(reductionM);
-    Kokkos::parallel_reduce("reductionM", nbCells,
-                            KOKKOS_LAMBDA(const int& cCells, double& x) {
-                              reducerM.join(x, m_total_masse_L0(cCells));
-                            },
-                            reducerM);
-  }
-  m_global_total_energy_L0 = reductionE;
-  m_global_total_masse_L0 = reductionM;
+  conservationlib::Bilan bilan;
+  conservationlib::ReducteurBilan reducer(bilan);
+  Kokkos::parallel_reduce(
+      "computeVariablesGlobalesL0", nbCells,
+      KOKKOS_LAMBDA(const int& cCells, conservationlib::Bilan& x) {
+        const Id cId(cCells);
+        const auto nodesOfCellC(mesh->getNodesOfCell(cId));
+        const size_t nbNodesOfCellC(nodesOfCellC.size());
+        double ec_reconst(0.);
+        for (size_t pNodesOfCellC = 0; pNodesOfCellC < nbNodesOfCellC;
+             pNodesOfCellC++) {
+          const Id pId(nodesOfCellC[pNodesOfCellC]);
+          const size_t pNodes(pId);
+          ec_reconst += 0.25 * 0.5 *
+                        (m_node_velocity_n(pNodes)[0] *
+                             m_node_velocity_n(pNodes)[0] +
+                         m_node_velocity_n(pNodes)[1] *
+                             m_node_velocity_n(pNodes)[1]);
+        }
+        x.energie += m_density_n(cCells) * m_lagrange_volume_n(cCells) *
+                     (m_internal_energy_n(cCells) + ec_reconst);
+        double masse(0.);
+        for (int imat = 0; imat < nbmat; imat++) {
+          const double masseEnv(m_density_env_n(cCells)[imat] *
+                                m_lagrange_volume_n(cCells) *
+                                m_fracvol_env(cCells)[imat]);
+          masse += masseEnv;
+          x.masseEnv[imat] += masseEnv;
+        }
+        x.masse += masse;
+      },
+      reducer);
+  m_global_total_energy_L0 = bilan.energie;
+  m_global_total_masse_L0 = bilan.masse;
+  for (int imat = 0; imat < nbmatmax; imat++)
+    m_global_total_masse_env_L0[imat] = bilan.masseEnv[imat];
 }
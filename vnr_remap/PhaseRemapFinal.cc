@@ -9,6 +9,78 @@
 #include "types/MathFunctions.h"  // for max, min
 #include "types/MultiArray.h"     // for operator<<
 
+/**
+ *******************************************************************************
+ * \file computeRemapFracvol()
+ * \brief Fractions volumiques projetees d'une maille : volumes partiels
+ *        normalises par le volume euler, fractions sous le seuil annulees
+ *
+ * \param  varlp->Uremap2, m_euler_volume
+ *******************************************************************************
+ */
+template <int NBMAT>
+KOKKOS_INLINE_FUNCTION RealArray1D<nbmatmax> Vnr::computeRemapFracvol(
+    const int cCells) const noexcept {
+  constexpr int nbmat = NBMAT;
+  double vol = m_euler_volume(cCells);  // volume euler
+  double volt = 0.;
+  RealArray1D<nbmatmax> vol_nplus1;
+  for (int imat = 0; imat < nbmat; imat++) {
+    vol_nplus1[imat] = varlp->Uremap2(cCells)[imat];
+    volt += vol_nplus1[imat];
+  }
+  double volt_normalise = 0.;
+  // normalisation des volumes + somme
+  for (int imat = 0; imat < nbmat; imat++) {
+    vol_nplus1[imat] *= vol / volt;
+    volt_normalise += vol_nplus1[imat];
+  }
+  RealArray1D<nbmatmax> fracvol = zeroVectmat;
+  double somme_frac = 0.;
+  for (int imat = 0; imat < nbmat; imat++) {
+    fracvol[imat] = vol_nplus1[imat] / volt_normalise;
+    if (fracvol[imat] < options->threshold) fracvol[imat] = 0.;
+    somme_frac += fracvol[imat];
+  }
+  for (int imat = 0; imat < nbmat; imat++)
+    fracvol[imat] = fracvol[imat] / somme_frac;
+  return fracvol;
+}
+/**
+ *******************************************************************************
+ * \file classifyRemapCells()
+ * \brief Classement des mailles apres projection : indicateurs mixte et pure
+ *        de la projection et materiau unique de la maille pour la
+ *        repartition des grandeurs par materiau
+ *
+ * \param  varlp->Uremap2
+ * \return varlp->mixte, varlp->pure, varlp->layout.cellMaterial
+ *******************************************************************************
+ */
+template <int NBMAT>
+void Vnr::classifyRemapCells() noexcept {
+  Kokkos::parallel_for(
+      "classifyRemapCells", nbCells, KOKKOS_LAMBDA(const int& cCells) {
+        const RealArray1D<nbmatmax> fracvol(
+            computeRemapFracvol<NBMAT>(cCells));
+        int matcell(0);
+        int imatpure(-1);
+        for (int imat = 0; imat < NBMAT; imat++)
+          if (fracvol[imat] > 0.) {
+            matcell++;
+            imatpure = imat;
+          }
+        if (matcell > 1) {
+          varlp->mixte(cCells) = 1;
+          varlp->pure(cCells) = -1;
+        } else {
+          varlp->mixte(cCells) = 0;
+          varlp->pure(cCells) = imatpure;
+        }
+        // une maille sans materiau est rangee avec les mailles mixtes
+        varlp->layout.cellMaterial(cCells) = (matcell == 1 ? imatpure : -1);
+      });
+}
 /**
  *******************************************************************************
  * \file remapVariables()
@@ -16,16 +88,16 @@
  *
  * \param  varlp->Uremap2
  * \return m_fracvol_env, m_mass_fraction_env
- *         varlp->mixte, varlp->pure
  *         m_density_nplus1, m_density_env_nplus1
  *         m_internal_energy_nplus1, m_internal_energy_env_nplus1
  *         m_cell_mass, m_cell_mass_env
  *         m_node_velocity_nplus1, m_x_velocity, m_y_velocity
  *******************************************************************************
  */
+template <int NBMAT>
 void Vnr::remapVariables() noexcept {
   varlp->x_then_y_nplus1 = !(varlp->x_then_y_n);
-  int nbmat = options->nbmat;
+  constexpr int nbmat = NBMAT;
   // variables am_x_velocity cellulles
   Kokkos::parallel_for(
       "remapVariables", nbCells, KOKKOS_LAMBDA(const int& cCells) {
@@ -46,31 +118,10 @@ void Vnr::remapVariables() noexcept {
           vol_nplus1[imat] *= vol / volt;
           volt_normalise += vol_nplus1[imat];
         }
-        double somme_frac = 0.;
-        for (int imat = 0; imat < nbmat; imat++) {
-          m_fracvol_env(cCells)[imat] = vol_nplus1[imat] / volt_normalise;
-          if (m_fracvol_env(cCells)[imat] < options->threshold)
-            m_fracvol_env(cCells)[imat] = 0.;
-          somme_frac += m_fracvol_env(cCells)[imat];
-        }
+        const RealArray1D<nbmatmax> fracvol(
+            computeRemapFracvol<NBMAT>(cCells));
         for (int imat = 0; imat < nbmat; imat++)
-          m_fracvol_env(cCells)[imat] =
-              m_fracvol_env(cCells)[imat] / somme_frac;
-
-        int matcell(0);
-        int imatpure(-1);
-        for (int imat = 0; imat < nbmat; imat++)
-          if (m_fracvol_env(cCells)[imat] > 0.) {
-            matcell++;
-            imatpure = imat;
-          }
-        if (matcell > 1) {
-          varlp->mixte(cCells) = 1;
-          varlp->pure(cCells) = -1;
-        } else {
-          varlp->mixte(cCells) = 0;
-          varlp->pure(cCells) = imatpure;
-        }
+          m_fracvol_env(cCells)[imat] = fracvol[imat];
         // on ne recalcule par les mailles à masses nulles - cas advection
         if (masset != 0.)
           for (int imat = 0; imat < nbmat; imat++)
@@ -256,59 +307,62 @@ void Vnr::remapVariables() noexcept {
       });
   } 
 }
+void Vnr::remapVariables() noexcept {
+  dispatchNbMat(options->nbmat, [this](auto nbmat) {
+    // les fractions volumiques changent : les mailles sont classees puis les
+    // grandeurs par materiau reclassees avant d'etre ecrites
+    classifyRemapCells<decltype(nbmat)::value>();
+    buildMaterialLayout();
+    remapVariables<decltype(nbmat)::value>();
+  });
+}
 /**
  *******************************************************************************
  * \file computeVariablesGlobalesT()
  * \brief Calcul de l'energie totale et la masse initiale du systeme apres projection
  *
  * \param  m_cell_velocity_nplus, m_density_nplus, m_euler_volume
- * \return m_total_energy_T, m_global_masse_T,
- *         m_global_total_energy_T, m_total_masse_T
+ * \return m_global_total_energy_T, m_global_total_masse_T,
+ *         m_global_total_masse_env_T
  *
  *******************************************************************************
  */
 void Vnr::computeVariablesGlobalesT() noexcept {
-  m_global_total_energy_T = 0.;
   int nbmat = options->nbmat;
-  Kokkos::parallel_for(
-      "remapVariables", nbCells, KOKKOS_LAMBDA(const int& cCells) {
-	const Id cId(cCells);
-	const auto nodesOfCellC(mesh->getNodesOfCell(cId));
-	const size_t nbNodesOfCellC(nodesOfCellC.size());
-	double ec_reconst(0.);
-	for (size_t pNodesOfCellC = 0; pNodesOfCellC < nbNodesOfCellC;
-	     pNodesOfCellC++) {
-	  const Id pId(nodesOfCellC[pNodesOfCellC]);
-	  const size_t pNodes(pId);
-	  ec_reconst += 0.25 * 0.5 *
-	    (m_node_velocity_nplus1(pNodes)[0] * m_node_velocity_nplus1(pNodes)[0] +
-	     m_node_velocity_nplus1(pNodes)[1] * m_node_velocity_nplus1(pNodes)[1]);
-	}
-        m_total_energy_T(cCells) = m_density_nplus1(cCells) * m_euler_volume(cCells) *
-	  (m_internal_energy_nplus1(cCells) + ec_reconst);
-        m_total_masse_T(cCells) = 0.;
-        for (int imat = 0; imat < nbmat; imat++)
-          m_total_masse_T(cCells) += m_density_env_nplus1(cCells)[imat] *
-                                     m_euler_volume(cCells) *
-                                     m_fracvol_env(cCells)[imat];
-        // m_mass_fraction_env(cCells)[imat] * (density_nplus1 * vol) ; //
-        // m_density_env_nplus1(cCells)[imat] * vol_nplus1[imat];
-      });
-  double reductionE(0.), reductionM(0.);
-  {
-    Kokkos::Sum<double> reducerE(reductionE);
-    Kokkos::parallel_reduce("reductionE", nbCells,
-                            KOKKOS_LAMBDA(const int& cCells, double& x) {
-                              reducerE.join(x, m_total_energy_T(cCells));
-                            },
-                            reducerE);
-    Kokkos::Sum<double> reducerM(reductionM);
-    Kokkos::parallel_reduce("reductionM", nbCells,
-                            KOKKOS_LAMBDA(const int& cCells, double& x) {
-                              reducerM.join(x, m_total_masse_T(cCells));
-                            },
-                            reducerM);
-  }
-  m_global_total_energy_T = reductionE;
-  m_global_total_masse_T = reductionM;
+  conservationlib::Bilan bilan;
+  conservationlib::ReducteurBilan reducer(bilan);
+  Kokkos::parallel_reduce(
+      "computeVariablesGlobalesT", nbCells,
+      KOKKOS_LAMBDA(const int& cCells, conservationlib::Bilan& x) {
+        const Id cId(cCells);
+        const auto nodesOfCellC(mesh->getNodesOfCell(cId));
+        const size_t nbNodesOfCellC(nodesOfCellC.size());
+        double ec_reconst(0.);
+        for (size_t pNodesOfCellC = 0; pNodesOfCellC < nbNodesOfCellC;
+             pNodesOfCellC++) {
+          const Id pId(nodesOfCellC[pNodesOfCellC]);
+          const size_t pNodes(pId);
+          ec_reconst += 0.25 * 0.5 *
+                        (m_node_velocity_nplus1(pNodes)[0] *
+                             m_node_velocity_nplus1(pNodes)[0] +
+                         m_node_velocity_nplus1(pNodes)[1] *
+                             m_node_velocity_nplus1(pNodes)[1]);
+        }
+        x.energie += m_density_nplus1(cCells) * m_euler_volume(cCells) *
+                     (m_internal_energy_nplus1(cCells) + ec_reconst);
+        double masse(0.);
+        for (int imat = 0; imat < nbmat; imat++) {
+          const double masseEnv(m_density_env_nplus1(cCells)[imat] *
+                                m_euler_volume(cCells) *
+                                m_fracvol_env(cCells)[imat]);
+          masse += masseEnv;
+          x.masseEnv[imat] += masseEnv;
+        }
+        x.masse += masse;
+      },
+      reducer);
+  m_global_total_energy_T = bilan.energie;
+  m_global_total_masse_T = bilan.masse;
+  for (int imat = 0; imat < nbmatmax; imat++)
+    m_global_total_masse_env_T[imat] = bilan.masseEnv[imat];
 }
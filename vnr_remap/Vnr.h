@@ -17,6 +17,7 @@
 /* #include <cmath> */
 /* #include <Kokkos_hwloc.hpp> */
 
+#include "../includes/BilanConservation.h"
 #include "../includes/CasTest.h"
 #include "../includes/ConditionsLimites.h"
 #include "../includes/Constantes.h"
@@ -24,6 +25,7 @@
 #include "../includes/Eos.h"
 #include "../includes/GestionTemps.h"
 #include "../includes/Limiteurs.h"
+#include "../includes/MaterialView.h"
 #include "../includes/Options.h"
 #include "../includes/SchemaLagrange.h"
 #include "../includes/Sortie.h"
@@ -95,6 +97,9 @@ class Vnr {
   double m_global_total_energy_L, m_global_total_energy_T,
     m_global_total_energy_0, m_global_total_energy_L0;
   double m_global_total_masse_L, m_global_total_masse_T, m_global_total_masse_0, m_global_total_masse_L0;
+  // masses globales par materiau
+  RealArray1D<nbmatmax> m_global_total_masse_env_L, m_global_total_masse_env_T,
+      m_global_total_masse_env_0, m_global_total_masse_env_L0;
 
   // coordonnees
   Kokkos::View<RealArray1D<dim>*> m_node_coord_n;
@@ -108,27 +113,27 @@ class Vnr {
   // densite
   Kokkos::View<double*> m_density_n;
   Kokkos::View<double*> m_density_nplus1;
-  Kokkos::View<RealArray1D<nbmatmax>*> m_density_env_n;
-  Kokkos::View<RealArray1D<nbmatmax>*> m_density_env_nplus1;
+  CellMaterialView m_density_env_n;
+  CellMaterialView m_density_env_nplus1;
   // masse
   Kokkos::View<double*> m_cell_mass;
-  Kokkos::View<RealArray1D<nbmatmax>*> m_cell_mass_env;
+  CellMaterialView m_cell_mass_env;
   // masse aux noeuds
   Kokkos::View<double*> m_node_mass;
   // pression 
   Kokkos::View<double*> m_pressure_n;
   Kokkos::View<double*> m_pressure_nplus1;
-  Kokkos::View<RealArray1D<nbmatmax>*> m_pressure_env_n;
-  Kokkos::View<RealArray1D<nbmatmax>*> m_pressure_env_nplus1;
+  CellMaterialView m_pressure_env_n;
+  CellMaterialView m_pressure_env_nplus1;
   Kokkos::View<double*> m_pressure_env1;
   Kokkos::View<double*> m_pressure_env2;
   Kokkos::View<double*> m_pressure_env3;
   // energie interne
   Kokkos::View<double*> m_internal_energy_n;
   Kokkos::View<double*> m_internal_energy_nplus1;
-  Kokkos::View<RealArray1D<nbmatmax>*> m_internal_energy_env_n;
-  Kokkos::View<RealArray1D<nbmatmax>*> m_internal_energy_env_nplus1;
-  Kokkos::View<RealArray1D<nbmatmax>*> m_dpde_env;
+  CellMaterialView m_internal_energy_env_n;
+  CellMaterialView m_internal_energy_env_nplus1;
+  CellMaterialView m_dpde_env;
   // vitesse aux noeuds
   Kokkos::View<RealArray1D<dim>*> m_node_velocity_n;
   Kokkos::View<RealArray1D<dim>*> m_node_velocity_nplus1;
@@ -139,48 +144,46 @@ class Vnr {
   // vitesse du son
   Kokkos::View<double*> m_speed_velocity_n;
   Kokkos::View<double*> m_speed_velocity_nplus1;
-  Kokkos::View<RealArray1D<nbmatmax>*> m_speed_velocity_env_n;
-  Kokkos::View<RealArray1D<nbmatmax>*> m_speed_velocity_env_nplus1;
+  CellMaterialView m_speed_velocity_env_n;
+  CellMaterialView m_speed_velocity_env_nplus1;
   // fraction volumique
-  Kokkos::View<RealArray1D<nbmatmax>*> m_fracvol_env;
+  CellMaterialView m_fracvol_env;
   Kokkos::View<double*> m_fracvol_env1;
   Kokkos::View<double*> m_fracvol_env2;
   Kokkos::View<double*> m_fracvol_env3;
-  Kokkos::View<RealArray1D<nbmatmax>*> m_node_fracvol;
+  MaterialView m_node_fracvol;
   // fraction massique
-  Kokkos::View<RealArray1D<nbmatmax>*> m_mass_fraction_env;
+  CellMaterialView m_mass_fraction_env;
   // sorties interface
   Kokkos::View<double*> m_interface12;
   Kokkos::View<double*> m_interface13;
   Kokkos::View<double*> m_interface23;
-  // sortie energie et masse globales
-  Kokkos::View<double*> m_total_energy_0;
-  Kokkos::View<double*> m_total_energy_T;
-  Kokkos::View<double*> m_total_energy_L;
-  Kokkos::View<double*> m_total_energy_L0;
-  Kokkos::View<double*> m_total_masse_0;
-  Kokkos::View<double*> m_total_masse_T;
-  Kokkos::View<double*> m_total_masse_L;
-  Kokkos::View<double*> m_total_masse_L0;
-
   Kokkos::View<double**> m_node_cellvolume_n;
   Kokkos::View<double**> m_node_cellvolume_nplus1;
   Kokkos::View<double*> m_pseudo_viscosity_n;
   Kokkos::View<double*> m_pseudo_viscosity_nplus1;
-  Kokkos::View<RealArray1D<nbmatmax>*> m_pseudo_viscosity_env_n;
-  Kokkos::View<RealArray1D<nbmatmax>*> m_pseudo_viscosity_env_nplus1;
+  CellMaterialView m_pseudo_viscosity_env_n;
+  CellMaterialView m_pseudo_viscosity_env_nplus1;
   Kokkos::View<double*> m_tau_density_n;
   Kokkos::View<double*> m_tau_density_nplus1;
-  Kokkos::View<RealArray1D<nbmatmax>*> m_tau_density_env_n;
-  Kokkos::View<RealArray1D<nbmatmax>*> m_tau_density_env_nplus1;
+  CellMaterialView m_tau_density_env_n;
+  CellMaterialView m_tau_density_env_nplus1;
   Kokkos::View<double*> m_tau_volume_n;
   Kokkos::View<double*> m_tau_volume_nplus1;
-  Kokkos::View<RealArray1D<nbmatmax>*> m_tau_volume_env_n;
-  Kokkos::View<RealArray1D<nbmatmax>*> m_tau_volume_env_nplus1;
+  CellMaterialView m_tau_volume_env_n;
+  CellMaterialView m_tau_volume_env_nplus1;
   Kokkos::View<double*> m_divu_n;
   Kokkos::View<double*> m_divu_nplus1;
   Kokkos::View<RealArray1D<dim>**> m_cqs_n;
   Kokkos::View<RealArray1D<dim>**> m_cqs_nplus1;
+  // Newton sur l'energie interne : nombre maximal d'iterations et
+  // histogramme du nombre d'iterations par maille et materiau du pas de temps
+  static constexpr int newtonItermax = 50;
+  Kokkos::View<int*> m_newton_histogram;
+  // pas de temps local, alloue seulement si sa sortie est demandee, et
+  // maille limitante du pas de temps
+  Kokkos::View<double*> m_cell_deltat;
+  int m_cell_deltat_loc;
 
   utils::Timer global_timer;
   utils::Timer cpu_timer;
@@ -231,62 +234,56 @@ class Vnr {
         m_node_cellvolume_nplus1("node_cellvolume_nplus1", nbCells,
                                  nbNodesOfCell),
         m_node_volume("node_volume", nbNodes),
-        m_total_energy_0("total_energy_0", nbCells),
-        m_total_energy_T("total_energy_T", nbCells),
-        m_total_energy_L("total_energy_L", nbCells),
-        m_total_energy_L0("total_energy_L0", nbCells),
-        m_total_masse_0("total_masse_0", nbCells),
-        m_total_masse_T("total_masse_T", nbCells),
-        m_total_masse_L("total_masse_L", nbCells),
-        m_total_masse_L0("total_masse_L0", nbCells),
         m_density_n("density_n", nbCells),
         m_density_nplus1("density_nplus1", nbCells),
-        m_density_env_n("density_env_n", nbCells),
-        m_density_env_nplus1("density_env_nplus1", nbCells),
+        m_density_env_n("density_env_n", varlp->layout),
+        m_density_env_nplus1("density_env_nplus1", varlp->layout),
         m_pressure_n("pressure_n", nbCells),
         m_pressure_nplus1("pressure_nplus1", nbCells),
         m_pressure_env1("pressure_env1", nbCells),
         m_pressure_env2("pressure_env2", nbCells),
         m_pressure_env3("pressure_env3", nbCells),
-        m_pressure_env_n("pressure_env_n", nbCells),
-        m_pressure_env_nplus1("pressure_env_nplus1", nbCells),
+        m_pressure_env_n("pressure_env_n", varlp->layout),
+        m_pressure_env_nplus1("pressure_env_nplus1", varlp->layout),
         m_pseudo_viscosity_n("pseudo_viscosity_n", nbCells),
         m_pseudo_viscosity_nplus1("pseudo_viscosity_nplus1", nbCells),
-        m_pseudo_viscosity_env_n("pseudo_viscosity_env_n", nbCells),
-        m_pseudo_viscosity_env_nplus1("pseudo_viscosity_env_nplus1", nbCells),
+        m_pseudo_viscosity_env_n("pseudo_viscosity_env_n", varlp->layout),
+        m_pseudo_viscosity_env_nplus1("pseudo_viscosity_env_nplus1",
+                                      varlp->layout),
         m_tau_density_n("tau_density_n", nbCells),
         m_tau_density_nplus1("tau_density_nplus1", nbCells),
-        m_tau_density_env_n("tau_density_env_n", nbCells),
-        m_tau_density_env_nplus1("tau_density_env_nplus1", nbCells),
+        m_tau_density_env_n("tau_density_env_n", varlp->layout),
+        m_tau_density_env_nplus1("tau_density_env_nplus1", varlp->layout),
         m_tau_volume_n("tau_volume_n", nbCells),
         m_tau_volume_nplus1("tau_volume_nplus1", nbCells),
-        m_tau_volume_env_n("tau_volume_env_n", nbCells),
-        m_tau_volume_env_nplus1("tau_volume_env_nplus1", nbCells),
+        m_tau_volume_env_n("tau_volume_env_n", varlp->layout),
+        m_tau_volume_env_nplus1("tau_volume_env_nplus1", varlp->layout),
         m_divu_n("divu_n", nbCells),
         m_divu_nplus1("divu_nplus1", nbCells),
         m_speed_velocity_n("speed_velocity_n", nbCells),
         m_speed_velocity_nplus1("speed_velocity_nplus1", nbCells),
-        m_speed_velocity_env_n("speed_velocity_n", nbCells),
-        m_speed_velocity_env_nplus1("speed_velocity_nplus1", nbCells),
+        m_speed_velocity_env_n("speed_velocity_n", varlp->layout),
+        m_speed_velocity_env_nplus1("speed_velocity_nplus1", varlp->layout),
         m_internal_energy_n("internal_energy_n", nbCells),
         m_internal_energy_nplus1("internal_energy_nplus1", nbCells),
-        m_internal_energy_env_n("internal_energy_env_n", nbCells),
-        m_internal_energy_env_nplus1("internal_energy_env_nplus1", nbCells),
-        m_dpde_env("dpde_env", nbCells),
+        m_internal_energy_env_n("internal_energy_env_n", varlp->layout),
+        m_internal_energy_env_nplus1("internal_energy_env_nplus1",
+                                     varlp->layout),
+        m_dpde_env("dpde_env", varlp->layout),
         m_node_velocity_n("node_velocity_n", nbNodes),
         m_node_velocity_nplus1("node_velocity_nplus1", nbNodes),
         m_x_velocity("x_velocity", nbNodes),
         m_y_velocity("y_velocity", nbNodes),
         m_node_mass("node_mass", nbNodes),
         m_cell_mass("cell_mass", nbCells),
-        m_cell_mass_env("cell_mass_env", nbCells),
+        m_cell_mass_env("cell_mass_env", varlp->layout),
         m_cell_coord_n("cell_coord_n", nbCells),
         m_cell_coord_nplus1("cell_coord_nplus1", nbCells),
         m_euler_volume("euler_volume", nbCells),
         m_lagrange_volume_n("lagrange_volume_n", nbCells),
         m_lagrange_volume_nplus1("lagrange_volume_nplus1", nbCells),
-        m_mass_fraction_env("mass_fraction_env", nbCells),
-        m_fracvol_env("fracvol_env", nbCells),
+        m_mass_fraction_env("mass_fraction_env", varlp->layout),
+        m_fracvol_env("fracvol_env", varlp->layout),
         m_node_fracvol("node_fracvol", nbNodes),
         m_fracvol_env1("fracvol_env1", nbCells),
         m_fracvol_env2("fracvol_env2", nbCells),
@@ -295,7 +292,9 @@ class Vnr {
         m_interface23("interface23", nbCells),
         m_interface13("interface13", nbCells),
         m_cqs_n("cqs_n", nbCells, nbNodesOfCell),
-        m_cqs_nplus1("cqs_nplus1", nbCells, nbNodesOfCell) {
+        m_cqs_nplus1("cqs_nplus1", nbCells, nbNodesOfCell),
+        m_newton_histogram("newton_histogram", newtonItermax + 1),
+        m_cell_deltat("cell_deltat", so->pas_de_temps ? nbCells : 0) {
     // Copy node coordinates
     const auto& gNodes = mesh->getGeometry()->getNodes();
     for (size_t rNodes = 0; rNodes < nbNodes; rNodes++) {
@@ -319,6 +318,7 @@ class Vnr {
 
   KOKKOS_INLINE_FUNCTION
   void setUpTimeLoopN() noexcept;
+  void buildMaterialLayout() noexcept;
 
   KOKKOS_INLINE_FUNCTION
   void executeTimeLoopN() noexcept;
@@ -327,11 +327,16 @@ class Vnr {
 
   // dans PhaseLagrange.cc
 
+  void computeArtificialViscosity() noexcept;
+  template <int NBMAT>
   void computeArtificialViscosity() noexcept;
 
   void computeCornerNormal() noexcept;
-  void updateCornerNormal() noexcept;
 
+  template <typename Functor>
+  void gatherNodePressureForce(const Kokkos::View<double*>& pressure,
+                               const Kokkos::View<double*>& pseudo_viscosity,
+                               const Functor& f) noexcept;
   void updateVelocity() noexcept;
   void updateVelocitybackward() noexcept;
   void updateVelocityforward() noexcept;
@@ -342,22 +347,32 @@ class Vnr {
 
   void updatePosition() noexcept;
 
-  void updateCellPos() noexcept;
-
   void computeNodeMass() noexcept;
 
   void computeNodeVolume() noexcept;
 
-  void computeSubVol() noexcept;
-
-  void updateRho() noexcept;
+  void updateCellGeometry() noexcept;
+  template <int NBMAT>
+  void updateCellGeometry() noexcept;
 
+  void computeTau() noexcept;
+  template <int NBMAT>
   void computeTau() noexcept;
 
+  void updateEnergy() noexcept;
+  template <int NBMAT>
   void updateEnergy() noexcept;
   void updateEnergyite() noexcept;
+  template <int NBMAT>
+  void updateEnergyite() noexcept;
+  void updateEnergycsts() noexcept;
+  template <int NBMAT>
   void updateEnergycsts() noexcept;
   void updateEnergycstsite() noexcept;
+  template <int NBMAT>
+  void updateEnergycstsite() noexcept;
+  void updateEnergyForTotalEnergyConservation() noexcept;
+  template <int NBMAT>
   void updateEnergyForTotalEnergyConservation() noexcept;
   
   void computeDivU() noexcept;
@@ -365,6 +380,10 @@ class Vnr {
   void computeEOS();
   
   void computePressionMoyenne() noexcept;
+  template <int NBMAT>
+  void computePressionMoyenne() noexcept;
+  void checkSpeedVelocityNaN() noexcept;
+  void printNewtonHistogram() noexcept;
 
   void updateNodeBoundaryConditions() noexcept;
   void updateCellBoundaryConditions() noexcept;
@@ -372,9 +391,17 @@ class Vnr {
   void computeFaceQuantitesForRemap() noexcept;
   void computeCellQuantitesForRemap() noexcept;
   void remapVariables() noexcept;
+  template <int NBMAT>
+  void remapVariables() noexcept;
+  template <int NBMAT>
+  KOKKOS_INLINE_FUNCTION RealArray1D<nbmatmax> computeRemapFracvol(
+      const int cCells) const noexcept;
+  template <int NBMAT>
+  void classifyRemapCells() noexcept;
 
  public:
   void simulate();
+  size_t getAllocatedBytes() const noexcept;
 };
 
 #endif  // VNRREMAP_H
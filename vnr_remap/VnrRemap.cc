@@ -5,19 +5,21 @@ using namespace nablalib;
 #include <iomanip>  // for operator<<, setw, setiosflags
 
 #include "../includes/Freefunctions.h"
+#include "../includes/TailleMemoire.h"  // for printAllocatedBytes
 #include "utils/Utils.h"  // for __RESET__, __BOLD__, __GREEN__
 
 /**
  *******************************************************************************
  * \file computeDeltaT()
- * \brief Calcul du pas de temps
+ * \brief Calcul du pas de temps : le pas de temps local est reduit (min et
+ *        maille limitante) dans le noyau qui le calcule, m_cell_deltat n'est
+ *        rempli que si sa sortie est demandee
  *
  * \param  m_speed_velocity_n, m_node_velocity_n, gt->deltat_n
- * \return gt->deltat_nplus1
+ * \return gt->deltat_nplus1, m_cell_deltat_loc, m_cell_deltat
  *******************************************************************************
  */
 void Vnr::computeDeltaT() noexcept {
-  double reduction0;
   double Aveccfleuler(0.);
   double cfl(0.1);
   if (options->AvecProjection == 1) {
@@ -25,9 +27,12 @@ void Vnr::computeDeltaT() noexcept {
     Aveccfleuler = 1;
     cfl = 0.05;  // explication à trouver, permet de passer les cas euler ?
   }
+  const bool avecSortie(m_cell_deltat.extent(0) > 0);
+  Kokkos::MinLoc<double, int>::value_type minLoc;
   Kokkos::parallel_reduce(
-      nbCells,
-      KOKKOS_LAMBDA(const size_t& cCells, double& accu) {
+      "computeDeltaT", nbCells,
+      KOKKOS_LAMBDA(const int& cCells,
+                    Kokkos::MinLoc<double, int>::value_type& x) {
         const Id cId(cCells);
         double uc(0.0);
         double reduction1(0.0);
@@ -48,13 +53,23 @@ void Vnr::computeDeltaT() noexcept {
           }
         }
         // 0.05 a expliquer
-        accu =
-            minR0(accu, cfl * std::sqrt(reduction1) /
-                            (Aveccfleuler * uc + m_speed_velocity_n(cCells)));
+        const double cellDeltat(
+            cfl * std::sqrt(reduction1) /
+            (Aveccfleuler * uc + m_speed_velocity_n(cCells)));
+        if (avecSortie) m_cell_deltat(cCells) = cellDeltat;
+        if (cellDeltat < x.val) {
+          x.val = cellDeltat;
+          x.loc = cCells;
+        }
       },
-      KokkosJoiner<double>(reduction0, numeric_limits<double>::max(), &minR0));
-  
-  gt->deltat_nplus1 = std::min(reduction0, 1.05 * gt->deltat_n);
+      Kokkos::MinLoc<double, int>(minLoc));
+  m_cell_deltat_loc = minLoc.loc;
+
+  gt->deltat_nplus1 = std::min(minLoc.val, 1.05 * gt->deltat_n);
+  if (gt->deltat_nplus1 < gt->deltat_min)
+    std::cerr << "Pas de temps " << gt->deltat_nplus1 << " < "
+              << gt->deltat_min << " limite par la maille "
+              << m_cell_deltat_loc << std::endl;
 }
 /**
  *******************************************************************************
@@ -102,42 +117,34 @@ void Vnr::computeDeltaTinit() noexcept {
  * \file computeVariablesGlobalesInit()
  * \brief Calcul de l'energie totale et la masse initiale du systeme
  *
- * \param  m_cell_velocity_n0, m_density_n0, m_euler_volume
- * \return m_total_energy_0, m_global_masse_0,
- *         m_global_total_energy_0, m_total_masse_0
+ * \param  m_cell_velocity_n0, m_cell_mass, m_cell_mass_env
+ * \return m_global_total_energy_0, m_global_total_masse_0,
+ *         m_global_total_masse_env_0
  *
  *******************************************************************************
  */
 void Vnr::computeVariablesGlobalesInit() noexcept {
-  m_global_total_energy_0 = 0.;
-  Kokkos::parallel_for(
-      "init_m_global_total_var_0", nbCells, KOKKOS_LAMBDA(const int& cCells) {
-        m_total_energy_0(cCells) =
-	  m_cell_mass(cCells) *
-            (init->m_internal_energy_n0(cCells) +
-             0.5 * (init->m_cell_velocity_n0(cCells)[0] *
-                        init->m_cell_velocity_n0(cCells)[0] +
-                    init->m_cell_velocity_n0(cCells)[1] *
-                        init->m_cell_velocity_n0(cCells)[1]));
-        m_total_masse_0(cCells) = m_cell_mass(cCells);
-      });
-  double reductionE(0.), reductionM(0.);
-  {
-    Kokkos::Sum<double> reducerE(reductionE);
-    Kokkos::parallel_reduce("reductionE", nbCells,
-                            KOKKOS_LAMBDA(const int& cCells, double& x) {
-                              reducerE.join(x, m_total_energy_0(cCells));
-                            },
-                            reducerE);
-    Kokkos::Sum<double> reducerM(reductionM);
-    Kokkos::parallel_reduce("reductionM", nbCells,
-                            KOKKOS_LAMBDA(const int& cCells, double& x) {
-                              reducerM.join(x, m_total_masse_0(cCells));
-                            },
-                            reducerM);
-  }
-  m_global_total_energy_0 = reductionE;
-  m_global_total_masse_0 = reductionM;
+  int nbmat = options->nbmat;
+  conservationlib::Bilan bilan;
+  conservationlib::ReducteurBilan reducer(bilan);
+  Kokkos::parallel_reduce(
+      "init_m_global_total_var_0", nbCells,
+      KOKKOS_LAMBDA(const int& cCells, conservationlib::Bilan& x) {
+        x.energie += m_cell_mass(cCells) *
+                     (init->m_internal_energy_n0(cCells) +
+                      0.5 * (init->m_cell_velocity_n0(cCells)[0] *
+                                 init->m_cell_velocity_n0(cCells)[0] +
+                             init->m_cell_velocity_n0(cCells)[1] *
+                                 init->m_cell_velocity_n0(cCells)[1]));
+        x.masse += m_cell_mass(cCells);
+        for (int imat = 0; imat < nbmat; imat++)
+          x.masseEnv[imat] += m_cell_mass_env(cCells)[imat];
+      },
+      reducer);
+  m_global_total_energy_0 = bilan.energie;
+  m_global_total_masse_0 = bilan.masse;
+  for (int imat = 0; imat < nbmatmax; imat++)
+    m_global_total_masse_env_0[imat] = bilan.masseEnv[imat];
 }
 /**
  *******************************************************************************
@@ -166,6 +173,28 @@ void Vnr::computeVariablesSortiesInit() noexcept {
     m_y_velocity(pNodes) = init->m_node_velocity_n0(pNodes)[1];
   });
 }
+/**
+ *******************************************************************************
+ * \file buildMaterialLayout()
+ * \brief Repartition pure/mixte des grandeurs par materiau : liste des
+ *        mailles mixtes construite a partir de varlp->layout.cellMaterial
+ *        puis reclassement de toutes les grandeurs par materiau aux mailles
+ *
+ * \param  varlp->layout.cellMaterial
+ * \return varlp->layout, m_..._env
+ *******************************************************************************
+ */
+void Vnr::buildMaterialLayout() noexcept {
+  varlp->layout.build();
+  relayoutMaterials(
+      varlp->layout, m_density_env_n, m_density_env_nplus1, m_cell_mass_env,
+      m_pressure_env_n, m_pressure_env_nplus1, m_internal_energy_env_n,
+      m_internal_energy_env_nplus1, m_dpde_env, m_speed_velocity_env_n,
+      m_speed_velocity_env_nplus1, m_fracvol_env, m_mass_fraction_env,
+      m_pseudo_viscosity_env_n, m_pseudo_viscosity_env_nplus1,
+      m_tau_density_env_n, m_tau_density_env_nplus1, m_tau_volume_env_n,
+      m_tau_volume_env_nplus1);
+}
 /**
  *******************************************************************************
  * \file setUpTimeLoopN()
@@ -198,6 +227,13 @@ void Vnr::setUpTimeLoopN() noexcept {
   deep_copy(m_divu_n, init->m_divu_n0);
   deep_copy(m_speed_velocity_n, init->m_speed_velocity_n0);
   deep_copy(m_speed_velocity_env_n, init->m_speed_velocity_env_n0);
+  // en mode Euler, chaque cycle repart du maillage initial : les vecteurs de
+  // coin m_cqs_n et les volumes aux noeuds m_node_volume sont calcules une
+  // seule fois ici au lieu d'etre recalcules a chaque cycle
+  if (options->AvecProjection == 1 && options->sansLagrange == 0) {
+    computeCornerNormal();
+    computeNodeVolume();
+  }
   // pas de temps
   gt->deltat_n = gt->deltat_init;
 }
@@ -220,16 +256,19 @@ void Vnr::executeTimeLoopN() noexcept {
                 << __RESET__ "] t = " << __BOLD__
                 << setiosflags(std::ios::scientific) << setprecision(8)
                 << setw(16) << gt->t_n << __RESET__;
+    // bilans globaux de conservation seulement tous les frequenceBilan cycles
+    const bool avecBilan(n % options->frequenceBilan == 0);
     // Calcul de l'energie totale et la masse du systeme en debut de Lagrange
-    computeVariablesGlobalesL0();
+    if (avecBilan) computeVariablesGlobalesL0();
     
     if (options->sansLagrange == 0) {
-      // calcul des m_cqs_n
-      computeCornerNormal();
+      // calcul des m_cqs_n (en mode Euler : fait dans setUpTimeLoopN)
+      if (options->AvecProjection == 0) computeCornerNormal();
       // retour a la vitesse en n-1/2 : m_velocity_n
       if (scheme->schema == scheme->CSTS && options->AvecProjection == 1) updateVelocitybackward();
-      // calcul du volume de chaque noeud du maillage : m_node_cellvolume_n
-      computeNodeVolume();
+      // calcul du volume de chaque noeud du maillage : m_node_volume
+      // (en mode Euler : fait dans setUpTimeLoopN)
+      if (options->AvecProjection == 0) computeNodeVolume();
       // Calcul du pas de temps : gt->deltat_nplus1
       computeDeltaT();
     } else {
@@ -248,16 +287,12 @@ void Vnr::executeTimeLoopN() noexcept {
     }
     // Calcul des positions en n+1 : m_node_coord_nplus1 
     updatePosition();
-    // Calcul du centre des mailles : m_cell_coord_nplus1
-    updateCellPos();
-    // Calcul des sous-volumes aux noeuds : m_node_cellvolume_nplus1
-    computeSubVol();
-    // Calcul du volume lagrange et de la densité : m_density_nplus1
-    updateRho();
+    // Calcul en une passe du centre des mailles (m_cell_coord_nplus1), des
+    // sous-volumes aux noeuds (m_node_cellvolume_nplus1), du volume lagrange,
+    // de la densité (m_density_nplus1) et des m_cqs_nplus1
+    updateCellGeometry();
 
     if (options->sansLagrange == 0) {
-      // Calcul des m_cqs_nplus1
-      updateCornerNormal();
       // Calcul de la variation du volume specifique
       computeTau();
       // Calcul de la divergence de la vitesse : m_divu_nplus1
@@ -285,7 +320,7 @@ void Vnr::executeTimeLoopN() noexcept {
     // Calcul des conditions aux limites dans les mailles
     updateCellBoundaryConditions();
     // Calcul des quantites apres la phase Lagrange
-    computeVariablesGlobalesL();
+    if (avecBilan) computeVariablesGlobalesL();
     
     if (options->AvecProjection == 1) {
       // Calcul de la vitesse de n+1/2 a n+1 : m_node_velocity_nplus1
@@ -298,15 +333,9 @@ void Vnr::executeTimeLoopN() noexcept {
       // Calcul de quantites aux faces pour la projection
       computeFaceQuantitesForRemap();
       // phase de projection : premiere direction
-      remap->computeGradPhiFace1();
-      remap->computeGradPhi1();
-      remap->computeUpwindFaceQuantitiesForProjection1();
       remap->computeUremap1();
       remap->computeDualUremap1();
       // phase de projection : seconde direction
-      remap->computeGradPhiFace2();
-      remap->computeGradPhi2();
-      remap->computeUpwindFaceQuantitiesForProjection2();
       remap->computeUremap2();
       remap->computeDualUremap2();
       // Calcul des variables aux mailles et aux noeuds qui ont ete projetees
@@ -323,7 +352,7 @@ void Vnr::executeTimeLoopN() noexcept {
       // Calcul de la pression moyenne : m_pressure_nplus1
       computePressionMoyenne();  // rappel Pression moyenne apres projection     
       // Calcul des quantites apres la phase de projection
-      computeVariablesGlobalesT();
+      if (avecBilan) computeVariablesGlobalesT();
     }
     // Evaluate loop condition with variables at time n
     continueLoop =
@@ -361,7 +390,7 @@ void Vnr::executeTimeLoopN() noexcept {
     ofstream fichierE(options->fichier_sortie1D, ios::app);  // ouverture en écriture avec effacement du fichier ouvert
     //ofstream fichierM("Mtotale.txt", ios::app);  // ouverture en écriture avec effacement du fichier ouvert
  
-    if(fichierE)
+    if(fichierE && avecBilan)
         {
 	  fichierE  << gt->t_n << " " << m_global_total_energy_L;	  
 	  if (options->AvecProjection == 1)
@@ -380,6 +409,7 @@ void Vnr::executeTimeLoopN() noexcept {
     // 	}
 											   
     std::cout << " DT  = " << gt->deltat_nplus1 << std::endl;
+    printNewtonHistogram();
     cpu_timer.stop();
     global_timer.stop();
 
@@ -461,6 +491,9 @@ void Vnr::dumpVariables() noexcept {
       nodeVariables.insert(
           pair<string, double*>("VitesseY", m_y_velocity.data()));
     }
+    if (so->pas_de_temps)
+      cellVariables.insert(
+          pair<string, double*>("CellDeltat", m_cell_deltat.data()));
     auto quads = mesh->getGeometry()->getQuads();
     writer.writeFile(nbCalls, gt->t_n, nbNodes, m_node_coord_n.data(), nbCells,
                      quads.data(), cellVariables, nodeVariables);
@@ -470,6 +503,40 @@ void Vnr::dumpVariables() noexcept {
     cpu_timer.start();
   }
 }
+/**
+ *******************************************************************************
+ * \file getAllocatedBytes()
+ * \brief taille memoire des tableaux du schema
+ *******************************************************************************
+ */
+size_t Vnr::getAllocatedBytes() const noexcept {
+  return allocatedBytes(m_node_coord_n, m_cell_coord_n, m_cell_coord_nplus1,
+                        m_node_volume, m_euler_volume, m_lagrange_volume_n,
+                        m_lagrange_volume_nplus1, m_density_n, m_density_nplus1,
+                        m_density_env_n, m_density_env_nplus1, m_cell_mass,
+                        m_cell_mass_env, m_node_mass, m_pressure_n,
+                        m_pressure_nplus1, m_pressure_env_n,
+                        m_pressure_env_nplus1, m_pressure_env1, m_pressure_env2,
+                        m_pressure_env3, m_internal_energy_n,
+                        m_internal_energy_nplus1, m_internal_energy_env_n,
+                        m_internal_energy_env_nplus1, m_dpde_env,
+                        m_node_velocity_n, m_node_velocity_nplus1, m_x_velocity,
+                        m_y_velocity, m_node_coord_nplus1, m_speed_velocity_n,
+                        m_speed_velocity_nplus1, m_speed_velocity_env_n,
+                        m_speed_velocity_env_nplus1, m_fracvol_env,
+                        m_fracvol_env1, m_fracvol_env2, m_fracvol_env3,
+                        m_node_fracvol, m_mass_fraction_env, m_interface12,
+                        m_interface13, m_interface23, m_node_cellvolume_n,
+                        m_node_cellvolume_nplus1, m_pseudo_viscosity_n,
+                        m_pseudo_viscosity_nplus1, m_pseudo_viscosity_env_n,
+                        m_pseudo_viscosity_env_nplus1, m_tau_density_n,
+                        m_tau_density_nplus1, m_tau_density_env_n,
+                        m_tau_density_env_nplus1, m_tau_volume_n,
+                        m_tau_volume_nplus1, m_tau_volume_env_n,
+                        m_tau_volume_env_nplus1, m_divu_n, m_divu_nplus1,
+                        m_cqs_n, m_cqs_nplus1, m_newton_histogram,
+                        m_cell_deltat);
+}
 /**
  *******************************************************************************
  * \file simulate()
@@ -517,9 +584,10 @@ void Vnr::simulate() {
   init->initBoundaryConditions();
   init->initCellPos();
   init->initVar();
+  buildMaterialLayout();
   init->initSubVol();
   init->initMeshGeometryForFaces();
-  remap->FacesOfNode();
+  remap->initDualRemap();
 
   if (options->sansLagrange == 0) {
     init->initPseudo();
@@ -531,6 +599,13 @@ void Vnr::simulate() {
   computeNodeMass();
   computeVariablesGlobalesInit();
   computeVariablesSortiesInit();
+
+  // bilan memoire par module une fois toutes les allocations faites
+  printAllocatedBytes("Vnr", getAllocatedBytes());
+  printAllocatedBytes("Remap", remap->getAllocatedBytes());
+  printAllocatedBytes("VariablesLagRemap", varlp->getAllocatedBytes());
+  printAllocatedBytes("Initialisations", init->getAllocatedBytes());
+
   executeTimeLoopN();
 
   std::cout << __YELLOW__ << "\n\tDone ! Took " << __MAGENTA__ << __BOLD__